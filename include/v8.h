@@ -127,6 +127,7 @@ template<typename T> class PropertyCallbackInfo;
 template<typename T> class ReturnValue;
 
 namespace internal {
+class BackgroundDeserializeTask;
 class BasicTracedReferenceExtractor;
 class ExternalString;
 class FunctionCallbackArguments;
@@ -1837,16 +1838,23 @@ class V8_EXPORT ScriptCompiler {
     CachedData& operator=(const CachedData&) = delete;
   };
 
+  class ConsumeCodeCacheTask;
+
   /**
    * Source code which can be then compiled to a UnboundScript or Script.
    */
   class Source {
    public:
-    // Source takes ownership of CachedData.
+    // Source takes ownership of both CachedData and ConsumeCodeCacheTask.
+    // When a ConsumeCodeCacheTask is given, the code cache it was started with
+    // is consumed with kConsumeCodeCache, and |cached_data| (if any) only
+    // reports whether that cache was rejected.
     V8_INLINE Source(Local<String> source_string, const ScriptOrigin& origin,
-                     CachedData* cached_data = nullptr);
-    V8_INLINE explicit Source(Local<String> source_string,
-                              CachedData* cached_data = nullptr);
+                     CachedData* cached_data = nullptr,
+                     ConsumeCodeCacheTask* consume_cache_task = nullptr);
+    V8_INLINE explicit Source(
+        Local<String> source_string, CachedData* cached_data = nullptr,
+        ConsumeCodeCacheTask* consume_cache_task = nullptr);
     V8_INLINE ~Source();
 
     // Ownership of the CachedData or its buffers is *not* transferred to the
@@ -1856,6 +1864,14 @@ class V8_EXPORT ScriptCompiler {
 
     V8_INLINE const ScriptOriginOptions& GetResourceOptions() const;
 
+    /**
+     * Sets the start positions of functions which are expected to be called
+     * while the script loads, e.g. as returned by
+     * ScriptCompiler::GetCompileHints. These functions are compiled eagerly
+     * together with the top-level code instead of lazily on first call.
+     */
+    V8_INLINE void SetCompileHints(std::vector<int> hints);
+
     // Prevent copying.
     Source(const Source&) = delete;
     Source& operator=(const Source&) = delete;
@@ -1877,6 +1893,12 @@ class V8_EXPORT ScriptCompiler {
     // set), or hold newly generated cache data (kProduce*Cache flags) are
     // set when calling a compile method.
     CachedData* cached_data;
+
+    // Task which has deserialized the code cache off the main thread.
+    ConsumeCodeCacheTask* consume_cache_task;
+
+    // Start positions of functions to compile eagerly.
+    std::vector<int> compile_hints;
   };
 
   /**
@@ -1948,6 +1970,12 @@ class V8_EXPORT ScriptCompiler {
 
     internal::ScriptStreamingData* impl() const { return impl_.get(); }
 
+    /**
+     * Like Source::SetCompileHints. Must be called before the streaming task
+     * is started.
+     */
+    void SetCompileHints(std::vector<int> hints);
+
     // Prevent copying.
     StreamedSource(const StreamedSource&) = delete;
     StreamedSource& operator=(const StreamedSource&) = delete;
@@ -1973,6 +2001,25 @@ class V8_EXPORT ScriptCompiler {
     internal::ScriptStreamingData* data_;
   };
 
+  /**
+   * A task which the embedder must run on a background thread to deserialize
+   * a code cache. Returned by ScriptCompiler::StartConsumingCodeCache.
+   */
+  class V8_EXPORT ConsumeCodeCacheTask final {
+   public:
+    ~ConsumeCodeCacheTask();
+
+    void Run();
+
+   private:
+    friend class ScriptCompiler;
+
+    explicit ConsumeCodeCacheTask(
+        std::unique_ptr<internal::BackgroundDeserializeTask> impl);
+
+    std::unique_ptr<internal::BackgroundDeserializeTask> impl_;
+  };
+
   enum CompileOptions {
     kNoCompileOptions = 0,
     kConsumeCodeCache,
@@ -2053,6 +2100,33 @@ class V8_EXPORT ScriptCompiler {
       Isolate* isolate, StreamedSource* source,
       ScriptType type = ScriptType::kClassic);
 
+  /**
+   * As above, but with |options| set to kEagerCompile all functions of the
+   * script are compiled while streaming instead of lazily on their first call.
+   * This is intended for scripts whose functions mostly run at startup. Only
+   * kNoCompileOptions and kEagerCompile are supported.
+   */
+  static ScriptStreamingTask* StartStreaming(Isolate* isolate,
+                                             StreamedSource* source,
+                                             ScriptType type,
+                                             CompileOptions options);
+
+  /**
+   * Returns a task which deserializes the code cache |source| on a background
+   * thread. The user is responsible for running the task on a background
+   * thread and for passing it, once it has finished, to a Source that is then
+   * compiled with kConsumeCodeCache. Checking the cache against the script
+   * source and registering the script with the isolate happen on the main
+   * thread during that compile; if the cache is rejected at that point, the
+   * script is compiled from source instead.
+   *
+   * Returns nullptr, and deletes |source|, if background deserialization is
+   * disabled with --no-concurrent-cache-deserialization. The embedder then
+   * has to consume the cache on the main thread, or compile from source.
+   */
+  static ConsumeCodeCacheTask* StartConsumingCodeCache(
+      Isolate* isolate, std::unique_ptr<CachedData> source);
+
   /**
    * Compiles a streamed script (bound to current context).
    *
@@ -2148,6 +2222,62 @@ class V8_EXPORT ScriptCompiler {
    */
   static CachedData* CreateCodeCacheForFunction(Local<Function> function);
 
+  /**
+   * Creates and returns a code cache bundle, which holds the code caches of
+   * the specified unbound_scripts in a single buffer keyed by their resource
+   * names. Scripts without a string resource name, with a name that occurred
+   * before, or that cannot be serialized are left out. The bundle can be
+   * stored as one file and memory-mapped when loading. The CachedData
+   * returned by this function should be owned by the caller.
+   */
+  static CachedData* CreateCodeCacheBundle(
+      Isolate* isolate,
+      const std::vector<Local<UnboundScript>>& unbound_scripts);
+
+  /**
+   * Returns the code cache stored in a bundle created by CreateCodeCacheBundle
+   * for the script named resource_name, or nullptr if there is none or the
+   * bundle was produced by a different V8 version or with different flags.
+   * Only the bundle's index is read: the returned CachedData points into the
+   * buffer of the bundle, which must outlive it, and it is only checked
+   * against the source and deserialized when the script is compiled with
+   * kConsumeCodeCache. The CachedData returned by this function should be
+   * owned by the caller.
+   */
+  static CachedData* GetCodeCacheFromBundle(const CachedData* bundle,
+                                            Local<String> resource_name);
+
+  /**
+   * Creates and returns a tiering profile for the specified unbound_script.
+   * The profile records which functions of the script have been called and
+   * which of them have been marked for optimization in this isolate. Calls
+   * are only recorded while --record-called-functions is set. The profile
+   * does not contain code or type feedback and is only valid for the same
+   * source, V8 version and flags. The CachedData returned by this function
+   * should be owned by the caller.
+   */
+  static CachedData* CreateTieringProfile(Local<UnboundScript> unbound_script);
+
+  /**
+   * Applies a tiering profile created by CreateTieringProfile for the same
+   * source to the specified unbound_script. Functions recorded as having run
+   * are compiled eagerly, and functions recorded as optimized are optimized
+   * as soon as they have collected initial feedback. Returns false if the
+   * profile was rejected, e.g. because of a source or version mismatch.
+   */
+  static bool ApplyTieringProfile(Local<UnboundScript> unbound_script,
+                                  const CachedData* profile);
+
+  /**
+   * Returns the start positions of the functions of the specified
+   * unbound_script that have been called in this isolate. Functions that were
+   * only compiled eagerly, e.g. because of earlier hints, are not included.
+   * Calls are only recorded while --record-called-functions is set.
+   * Passing the positions to Source::SetCompileHints in later loads compiles
+   * these functions eagerly.
+   */
+  static std::vector<int> GetCompileHints(Local<UnboundScript> unbound_script);
+
  private:
   static V8_WARN_UNUSED_RESULT MaybeLocal<UnboundScript> CompileUnboundInternal(
       Isolate* isolate, Source* source, CompileOptions options,
@@ -5065,6 +5195,19 @@ class V8_EXPORT CompiledWasmModule {
    */
   MemorySpan<const uint8_t> GetWireBytesRef();
 
+  /**
+   * Returns the size of the machine code of this module, excluding code that
+   * was freed after tier-up. This is included in
+   * HeapCodeStatistics::wasm_code_size() of each isolate using the module.
+   */
+  size_t GetCodeSize() const;
+
+  /**
+   * Returns the size of the committed code space of this module. This is
+   * included in HeapCodeStatistics::wasm_committed_code_size().
+   */
+  size_t GetCommittedCodeSize() const;
+
   const std::string& source_url() const { return source_url_; }
 
  private:
@@ -7759,11 +7902,23 @@ class V8_EXPORT HeapCodeStatistics {
   size_t code_and_metadata_size() { return code_and_metadata_size_; }
   size_t bytecode_and_metadata_size() { return bytecode_and_metadata_size_; }
   size_t external_script_source_size() { return external_script_source_size_; }
+  /**
+   * Returns the size of the WebAssembly machine code of all modules used by
+   * the isolate, excluding code that was freed after tier-up.
+   */
+  size_t wasm_code_size() { return wasm_code_size_; }
+  /**
+   * Returns the size of the committed WebAssembly code space of all modules
+   * used by the isolate.
+   */
+  size_t wasm_committed_code_size() { return wasm_committed_code_size_; }
 
  private:
   size_t code_and_metadata_size_;
   size_t bytecode_and_metadata_size_;
   size_t external_script_source_size_;
+  size_t wasm_code_size_;
+  size_t wasm_committed_code_size_;
 
   friend class Isolate;
 };
@@ -9949,7 +10104,18 @@ class V8_EXPORT V8 {
  */
 class V8_EXPORT SnapshotCreator {
  public:
-  enum class FunctionCodeHandling { kClear, kKeep };
+  /**
+   * kClear drops all compiled code, kKeep includes it in the snapshot.
+   * kClearCold only keeps the code of functions that warmed up while the
+   * snapshot was created, i.e. that ran long enough to allocate feedback, and
+   * clears the code of all other functions like kClear. This is lazy
+   * recompilation, not lazy deserialization: the snapshot does not contain
+   * the bytecode of cold functions at all, and a cold function is compiled
+   * again from its source, which is part of the snapshot, on its first call.
+   * Contexts created from large snapshots are thus smaller and faster to
+   * deserialize, at the cost of compiling the cold functions that do run.
+   */
+  enum class FunctionCodeHandling { kClear, kKeep, kClearCold };
 
   /**
    * Initialize and enter an isolate, and set it up for serialization.
@@ -11467,7 +11633,8 @@ int ScriptOrigin::ScriptId() const { return script_id_; }
 Local<Value> ScriptOrigin::SourceMapUrl() const { return source_map_url_; }
 
 ScriptCompiler::Source::Source(Local<String> string, const ScriptOrigin& origin,
-                               CachedData* data)
+                               CachedData* data,
+                               ConsumeCodeCacheTask* consume_cache_task)
     : source_string(string),
       resource_name(origin.ResourceName()),
       resource_line_offset(origin.LineOffset()),
@@ -11475,15 +11642,18 @@ ScriptCompiler::Source::Source(Local<String> string, const ScriptOrigin& origin,
       resource_options(origin.Options()),
       source_map_url(origin.SourceMapUrl()),
       host_defined_options(origin.HostDefinedOptions()),
-      cached_data(data) {}
-
-ScriptCompiler::Source::Source(Local<String> string,
-                               CachedData* data)
-    : source_string(string), cached_data(data) {}
+      cached_data(data),
+      consume_cache_task(consume_cache_task) {}
 
+ScriptCompiler::Source::Source(Local<String> string, CachedData* data,
+                               ConsumeCodeCacheTask* consume_cache_task)
+    : source_string(string),
+      cached_data(data),
+      consume_cache_task(consume_cache_task) {}
 
 ScriptCompiler::Source::~Source() {
   delete cached_data;
+  delete consume_cache_task;
 }
 
 
@@ -11496,6 +11666,10 @@ const ScriptOriginOptions& ScriptCompiler::Source::GetResourceOptions() const {
   return resource_options;
 }
 
+void ScriptCompiler::Source::SetCompileHints(std::vector<int> hints) {
+  compile_hints = std::move(hints);
+}
+
 Local<Boolean> Boolean::New(Isolate* isolate, bool value) {
   return value ? True(isolate) : False(isolate);
 }
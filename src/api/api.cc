@@ -99,10 +99,12 @@
 #include "src/regexp/regexp-stack.h"
 #include "src/regexp/regexp-utils.h"
 #include "src/runtime/runtime.h"
+#include "src/snapshot/code-cache-bundle.h"
 #include "src/snapshot/code-serializer.h"
 #include "src/snapshot/embedded/embedded-data.h"
 #include "src/snapshot/snapshot.h"
 #include "src/snapshot/startup-serializer.h"  // For SerializedHandleChecker.
+#include "src/snapshot/tiering-profile.h"
 #include "src/strings/char-predicates-inl.h"
 #include "src/strings/string-hasher.h"
 #include "src/strings/unicode-inl.h"
@@ -572,7 +574,7 @@ StartupData SnapshotCreator::CreateBlob(
   }
 
   i::Snapshot::ClearReconstructableDataForSerialization(
-      isolate, function_code_handling == FunctionCodeHandling::kClear);
+      isolate, function_code_handling);
 
   i::DisallowGarbageCollection no_gc_from_here_on;
 
@@ -1839,6 +1841,11 @@ ScriptCompiler::StreamedSource::StreamedSource(
 
 ScriptCompiler::StreamedSource::~StreamedSource() = default;
 
+void ScriptCompiler::StreamedSource::SetCompileHints(std::vector<int> hints) {
+  std::sort(hints.begin(), hints.end());
+  impl_->compile_hints = std::move(hints);
+}
+
 Local<Script> UnboundScript::BindToCurrentContext() {
   auto function_info =
       i::Handle<i::SharedFunctionInfo>::cast(Utils::OpenHandle(this));
@@ -2320,11 +2327,16 @@ MaybeLocal<UnboundScript> ScriptCompiler::CompileUnboundInternal(
                      InternalEscapableScope);
 
   i::ScriptData* script_data = nullptr;
+  i::BackgroundDeserializeTask* deserialize_task = nullptr;
   if (options == kConsumeCodeCache) {
-    DCHECK(source->cached_data);
-    // ScriptData takes care of pointer-aligning the data.
-    script_data = new i::ScriptData(source->cached_data->data,
-                                    source->cached_data->length);
+    if (source->consume_cache_task) {
+      deserialize_task = source->consume_cache_task->impl_.get();
+    } else {
+      DCHECK(source->cached_data);
+      // ScriptData takes care of pointer-aligning the data.
+      script_data = new i::ScriptData(source->cached_data->data,
+                                      source->cached_data->length);
+    }
   }
 
   i::Handle<i::String> str = Utils::OpenHandle(*(source->source_string));
@@ -2334,12 +2346,28 @@ MaybeLocal<UnboundScript> ScriptCompiler::CompileUnboundInternal(
       isolate, source->resource_name, source->resource_line_offset,
       source->resource_column_offset, source->source_map_url,
       source->host_defined_options);
-  i::MaybeHandle<i::SharedFunctionInfo> maybe_function_info =
-      i::Compiler::GetSharedFunctionInfoForScript(
-          isolate, str, script_details, source->resource_options, nullptr,
-          script_data, options, no_cache_reason, i::NOT_NATIVES_CODE);
-  if (options == kConsumeCodeCache) {
-    source->cached_data->rejected = script_data->rejected();
+  // The hints are owned by the embedder; sort a copy.
+  std::vector<int> compile_hints(source->compile_hints);
+  if (!compile_hints.empty()) {
+    std::sort(compile_hints.begin(), compile_hints.end());
+    script_details.compile_hints = &compile_hints;
+  }
+  i::MaybeHandle<i::SharedFunctionInfo> maybe_function_info;
+  if (deserialize_task) {
+    maybe_function_info =
+        i::Compiler::GetSharedFunctionInfoForScriptWithDeserializeTask(
+            isolate, str, script_details, source->resource_options,
+            deserialize_task, options, no_cache_reason, i::NOT_NATIVES_CODE);
+    if (source->cached_data) {
+      source->cached_data->rejected = deserialize_task->rejected();
+    }
+  } else {
+    maybe_function_info = i::Compiler::GetSharedFunctionInfoForScript(
+        isolate, str, script_details, source->resource_options, nullptr,
+        script_data, options, no_cache_reason, i::NOT_NATIVES_CODE);
+    if (options == kConsumeCodeCache) {
+      source->cached_data->rejected = script_data->rejected();
+    }
   }
   delete script_data;
   has_pending_exception = !maybe_function_info.ToHandle(&result);
@@ -2510,16 +2538,43 @@ ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreamingScript(
 
 ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreaming(
     Isolate* v8_isolate, StreamedSource* source, v8::ScriptType type) {
+  return StartStreaming(v8_isolate, source, type, kNoCompileOptions);
+}
+
+ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreaming(
+    Isolate* v8_isolate, StreamedSource* source, v8::ScriptType type,
+    CompileOptions options) {
+  Utils::ApiCheck(
+      options == kNoCompileOptions || options == kEagerCompile,
+      "v8::ScriptCompiler::StartStreaming", "Invalid CompileOptions");
   if (!i::FLAG_script_streaming) return nullptr;
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
   ASSERT_NO_SCRIPT_NO_EXCEPTION(isolate);
   i::ScriptStreamingData* data = source->impl();
   std::unique_ptr<i::BackgroundCompileTask> task =
-      std::make_unique<i::BackgroundCompileTask>(data, isolate, type);
+      std::make_unique<i::BackgroundCompileTask>(data, isolate, type, options);
   data->task = std::move(task);
   return new ScriptCompiler::ScriptStreamingTask(data);
 }
 
+ScriptCompiler::ConsumeCodeCacheTask::ConsumeCodeCacheTask(
+    std::unique_ptr<i::BackgroundDeserializeTask> impl)
+    : impl_(std::move(impl)) {}
+
+ScriptCompiler::ConsumeCodeCacheTask::~ConsumeCodeCacheTask() = default;
+
+void ScriptCompiler::ConsumeCodeCacheTask::Run() { impl_->Run(); }
+
+ScriptCompiler::ConsumeCodeCacheTask* ScriptCompiler::StartConsumingCodeCache(
+    Isolate* v8_isolate, std::unique_ptr<CachedData> cached_data) {
+  if (!i::FLAG_concurrent_cache_deserialization) return nullptr;
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  ASSERT_NO_SCRIPT_NO_EXCEPTION(isolate);
+  return new ScriptCompiler::ConsumeCodeCacheTask(
+      std::make_unique<i::BackgroundDeserializeTask>(isolate,
+                                                     std::move(cached_data)));
+}
+
 namespace {
 i::MaybeHandle<i::SharedFunctionInfo> CompileStreamedSource(
     i::Isolate* isolate, ScriptCompiler::StreamedSource* v8_source,
@@ -2615,6 +2670,79 @@ ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCacheForFunction(
   return i::CodeSerializer::Serialize(shared);
 }
 
+// static
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCacheBundle(
+    Isolate* v8_isolate,
+    const std::vector<Local<UnboundScript>>& unbound_scripts) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  ASSERT_NO_SCRIPT_NO_EXCEPTION(isolate);
+  i::HandleScope scope(isolate);
+  std::vector<i::Handle<i::SharedFunctionInfo>> scripts;
+  scripts.reserve(unbound_scripts.size());
+  for (Local<UnboundScript> unbound_script : unbound_scripts) {
+    scripts.push_back(i::Handle<i::SharedFunctionInfo>::cast(
+        Utils::OpenHandle(*unbound_script)));
+  }
+  return i::CodeCacheBundle::Create(isolate, scripts);
+}
+
+// static
+ScriptCompiler::CachedData* ScriptCompiler::GetCodeCacheFromBundle(
+    const CachedData* bundle, Local<String> resource_name) {
+  i::Handle<i::String> name = Utils::OpenHandle(*resource_name);
+  i::Vector<const uint8_t> cache =
+      i::CodeCacheBundle::Lookup(bundle->data, bundle->length, *name);
+  if (cache.empty()) return nullptr;
+  return new CachedData(cache.begin(), cache.length(),
+                        CachedData::BufferNotOwned);
+}
+
+// static
+ScriptCompiler::CachedData* ScriptCompiler::CreateTieringProfile(
+    Local<UnboundScript> unbound_script) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  ASSERT_NO_SCRIPT_NO_EXCEPTION(isolate);
+  DCHECK(shared->is_toplevel());
+  return i::TieringProfile::Create(isolate, shared);
+}
+
+// static
+bool ScriptCompiler::ApplyTieringProfile(Local<UnboundScript> unbound_script,
+                                         const CachedData* profile) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  ASSERT_NO_SCRIPT_NO_EXCEPTION(isolate);
+  DCHECK(shared->is_toplevel());
+  return i::TieringProfile::Apply(isolate, shared, profile->data,
+                                  profile->length);
+}
+
+// static
+std::vector<int> ScriptCompiler::GetCompileHints(
+    Local<UnboundScript> unbound_script) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  ASSERT_NO_SCRIPT_NO_EXCEPTION(isolate);
+  DCHECK(shared->is_toplevel());
+  std::vector<int> hints;
+  i::SharedFunctionInfo::ScriptIterator iterator(
+      isolate, i::Script::cast(shared->script()));
+  for (i::SharedFunctionInfo info = iterator.Next(); !info.is_null();
+       info = iterator.Next()) {
+    if (info.is_toplevel() || !info.has_been_called()) continue;
+    hints.push_back(info.StartPosition());
+  }
+  std::sort(hints.begin(), hints.end());
+  return hints;
+}
+
 MaybeLocal<Script> Script::Compile(Local<Context> context, Local<String> source,
                                    ScriptOrigin* origin) {
   if (origin) {
@@ -5849,7 +5977,9 @@ HeapObjectStatistics::HeapObjectStatistics()
 HeapCodeStatistics::HeapCodeStatistics()
     : code_and_metadata_size_(0),
       bytecode_and_metadata_size_(0),
-      external_script_source_size_(0) {}
+      external_script_source_size_(0),
+      wasm_code_size_(0),
+      wasm_committed_code_size_(0) {}
 
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
@@ -7389,6 +7519,22 @@ MemorySpan<const uint8_t> CompiledWasmModule::GetWireBytesRef() {
 #endif  // V8_ENABLE_WEBASSEMBLY
 }
 
+size_t CompiledWasmModule::GetCodeSize() const {
+#if V8_ENABLE_WEBASSEMBLY
+  return native_module_->live_code_size();
+#else
+  UNREACHABLE();
+#endif  // V8_ENABLE_WEBASSEMBLY
+}
+
+size_t CompiledWasmModule::GetCommittedCodeSize() const {
+#if V8_ENABLE_WEBASSEMBLY
+  return native_module_->committed_code_space();
+#else
+  UNREACHABLE();
+#endif  // V8_ENABLE_WEBASSEMBLY
+}
+
 Local<ArrayBuffer> v8::WasmMemoryObject::Buffer() {
 #if V8_ENABLE_WEBASSEMBLY
   i::Handle<i::WasmMemoryObject> obj = Utils::OpenHandle(this);
@@ -8497,6 +8643,11 @@ bool Isolate::GetHeapCodeAndMetadataStatistics(
       isolate->bytecode_and_metadata_size();
   code_statistics->external_script_source_size_ =
       isolate->external_script_source_size();
+#if V8_ENABLE_WEBASSEMBLY
+  isolate->wasm_engine()->GetCodeStatistics(
+      isolate, &code_statistics->wasm_code_size_,
+      &code_statistics->wasm_committed_code_size_);
+#endif  // V8_ENABLE_WEBASSEMBLY
   return true;
 }
 
@@ -122,6 +122,17 @@ PageAllocator::AllocateSharedPages(size_t size, const void* original_address) {
 #endif
 }
 
+std::unique_ptr<v8::PageAllocator::SharedMemory> PageAllocator::MapSharedFile(
+    FILE* file, size_t offset, size_t size) {
+#ifdef V8_OS_LINUX
+  void* ptr = base::OS::MapSharedFile(file, offset, size);
+  if (ptr == nullptr) return {};
+  return std::make_unique<v8::base::SharedMemory>(this, ptr, size);
+#else
+  return {};
+#endif
+}
+
 void* PageAllocator::RemapShared(void* old_address, void* new_address,
                                  size_t size) {
 #ifdef V8_OS_LINUX
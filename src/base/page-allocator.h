@@ -5,6 +5,7 @@
 #ifndef V8_BASE_PAGE_ALLOCATOR_H_
 #define V8_BASE_PAGE_ALLOCATOR_H_
 
+#include <cstdio>
 #include <memory>
 
 #include "include/v8-platform.h"
@@ -38,6 +39,12 @@ class V8_BASE_EXPORT PageAllocator
   std::unique_ptr<v8::PageAllocator::SharedMemory> AllocateSharedPages(
       size_t size, const void* original_address) override;
 
+  // Maps {size} bytes of {file} at {offset} as read-only shared memory, which
+  // shares physical pages with every other process that maps the same file.
+  // Only supported where CanAllocateSharedPages() is true.
+  std::unique_ptr<v8::PageAllocator::SharedMemory> MapSharedFile(
+      FILE* file, size_t offset, size_t size);
+
   bool FreePages(void* address, size_t size) override;
 
   bool ReleasePages(void* address, size_t size, size_t new_size) override;
@@ -155,5 +155,14 @@ void* OS::RemapShared(void* old_address, void* new_address, size_t size) {
   return result;
 }
 
+void* OS::MapSharedFile(FILE* file, size_t offset, size_t size) {
+  DCHECK_EQ(0, offset % AllocatePageSize());
+  DCHECK_EQ(0, size % AllocatePageSize());
+  void* result = mmap(GetRandomMmapAddr(), size, PROT_READ, MAP_SHARED,
+                      fileno(file), static_cast<off_t>(offset));
+  if (result == MAP_FAILED) return nullptr;
+  return result;
+}
+
 }  // namespace base
 }  // namespace v8
@@ -290,6 +290,11 @@ class V8_BASE_EXPORT OS {
                                                  void* new_address,
                                                  size_t size);
 
+  // Maps {size} bytes of {file} at {offset} read-only and shared, so that the
+  // mapping can be remapped with RemapShared.
+  V8_WARN_UNUSED_RESULT static void* MapSharedFile(FILE* file, size_t offset,
+                                                   size_t size);
+
   V8_WARN_UNUSED_RESULT static bool Free(void* address, const size_t size);
 
   V8_WARN_UNUSED_RESULT static bool Release(void* address, size_t size);
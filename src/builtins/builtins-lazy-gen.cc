@@ -116,6 +116,7 @@ void LazyBuiltinsAssembler::CompileLazy(TNode<JSFunction> function) {
   // feedback vector marker.
   TNode<SharedFunctionInfo> shared =
       CAST(LoadObjectField(function, JSFunction::kSharedFunctionInfoOffset));
+
   TVARIABLE(Uint16T, sfi_data_type);
   TNode<Code> sfi_code =
       GetSharedFunctionInfoCode(shared, &sfi_data_type, &compile_function);
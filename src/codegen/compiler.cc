@@ -5,6 +5,7 @@
 #include "src/codegen/compiler.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 
 #include "src/api/api-inl.h"
@@ -13,6 +14,7 @@
 #include "src/ast/scopes.h"
 #include "src/base/logging.h"
 #include "src/base/optional.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/time.h"
 #include "src/baseline/baseline.h"
 #include "src/codegen/assembler-inl.h"
@@ -42,6 +44,7 @@
 #include "src/heap/local-heap.h"
 #include "src/heap/parked-scope.h"
 #include "src/init/bootstrapper.h"
+#include "src/init/v8.h"
 #include "src/interpreter/interpreter.h"
 #include "src/logging/log-inl.h"
 #include "src/objects/feedback-cell-inl.h"
@@ -744,11 +747,12 @@ ExecuteSingleUnoptimizedCompilationJob(
     ParseInfo* parse_info, FunctionLiteral* literal,
     AccountingAllocator* allocator,
     std::vector<FunctionLiteral*>* eager_inner_literals,
-    LocalIsolate* local_isolate) {
+    LocalIsolate* local_isolate, uintptr_t stack_limit) {
 #if V8_ENABLE_WEBASSEMBLY
   if (UseAsmWasm(literal, parse_info->flags().is_asm_wasm_broken())) {
     std::unique_ptr<UnoptimizedCompilationJob> asm_job(
         AsmJs::NewCompilationJob(parse_info, literal, allocator));
+    asm_job->set_stack_limit(stack_limit);
     if (asm_job->ExecuteJob() == CompilationJob::SUCCEEDED) {
       return asm_job;
     }
@@ -762,6 +766,7 @@ ExecuteSingleUnoptimizedCompilationJob(
   std::unique_ptr<UnoptimizedCompilationJob> job(
       interpreter::Interpreter::NewCompilationJob(
           parse_info, literal, allocator, eager_inner_literals, local_isolate));
+  job->set_stack_limit(stack_limit);
 
   if (job->ExecuteJob() != CompilationJob::SUCCEEDED) {
     // Compilation failed, return null.
@@ -782,7 +787,8 @@ bool RecursivelyExecuteUnoptimizedCompilationJobs(
   DCHECK_NULL(LocalHeap::Current());
   std::unique_ptr<UnoptimizedCompilationJob> job =
       ExecuteSingleUnoptimizedCompilationJob(parse_info, literal, allocator,
-                                             &eager_inner_literals, nullptr);
+                                             &eager_inner_literals, nullptr,
+                                             parse_info->stack_limit());
 
   if (!job) return false;
 
@@ -820,9 +826,9 @@ bool IterativelyExecuteAndFinalizeUnoptimizedCompilationJobs(
     if (shared_info->is_compiled()) continue;
 
     std::unique_ptr<UnoptimizedCompilationJob> job =
-        ExecuteSingleUnoptimizedCompilationJob(parse_info, literal, allocator,
-                                               &functions_to_compile,
-                                               isolate->AsLocalIsolate());
+        ExecuteSingleUnoptimizedCompilationJob(
+            parse_info, literal, allocator, &functions_to_compile,
+            isolate->AsLocalIsolate(), parse_info->stack_limit());
 
     if (!job) return false;
 
@@ -1540,6 +1546,128 @@ MaybeHandle<SharedFunctionInfo> CompileAndFinalizeOnBackgroundThread(
   return shared_info;
 }
 
+// Executes the compilation job of a top-level literal and of all eager inner
+// literals reachable from it on worker threads. The resulting jobs are
+// finalized together afterwards.
+//
+// Jobs of sibling literals run concurrently against the same ParseInfo and
+// AST. That is safe because executing an interpreter job only reads the shared
+// state: scope and variable allocation is complete once parsing finishes, AST
+// strings are only internalized during finalization, and the source range map
+// is only looked up. The mutable parts of the AST a job touches (literal depth
+// and flags) belong to its own function, and an inner literal is only queued
+// once its parent's job has finished. The runtime call stats are thread
+// specific, so this is only used while they are disabled. Asm.js jobs, in
+// contrast, reread the source through the shared character stream and report
+// warnings to the shared PendingCompilationErrorHandler, so they are executed
+// one at a time under |asm_js_mutex_|.
+class ParallelUnoptimizedCompilationJobs final : public v8::JobTask {
+ public:
+  ParallelUnoptimizedCompilationJobs(ParseInfo* parse_info,
+                                     AccountingAllocator* allocator,
+                                     size_t max_stack_size)
+      : parse_info_(parse_info),
+        allocator_(allocator),
+        max_stack_size_(max_stack_size),
+        pending_literals_({parse_info->literal()}),
+        num_pending_literals_(1) {}
+
+  ParallelUnoptimizedCompilationJobs(
+      const ParallelUnoptimizedCompilationJobs&) = delete;
+  ParallelUnoptimizedCompilationJobs& operator=(
+      const ParallelUnoptimizedCompilationJobs&) = delete;
+
+  void Run(JobDelegate* delegate) override {
+    TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                 "V8.CompileCodeBackgroundParallel");
+    uintptr_t stack_limit = GetCurrentStackPosition() - max_stack_size_ * KB;
+    while (!delegate->ShouldYield()) {
+      FunctionLiteral* literal;
+      {
+        base::MutexGuard guard(&mutex_);
+        if (pending_literals_.empty()) return;
+        literal = pending_literals_.back();
+        pending_literals_.pop_back();
+        num_pending_literals_.store(pending_literals_.size(),
+                                    std::memory_order_relaxed);
+      }
+
+      std::vector<FunctionLiteral*> eager_inner_literals;
+      std::unique_ptr<UnoptimizedCompilationJob> job;
+      {
+        base::Optional<base::MutexGuard> asm_js_guard;
+#if V8_ENABLE_WEBASSEMBLY
+        if (UseAsmWasm(literal, parse_info_->flags().is_asm_wasm_broken())) {
+          asm_js_guard.emplace(&asm_js_mutex_);
+        }
+#endif  // V8_ENABLE_WEBASSEMBLY
+        job = ExecuteSingleUnoptimizedCompilationJob(
+            parse_info_, literal, allocator_, &eager_inner_literals, nullptr,
+            stack_limit);
+      }
+
+      base::MutexGuard guard(&mutex_);
+      if (!job) {
+        failed_ = true;
+        pending_literals_.clear();
+      } else if (!failed_) {
+        finished_jobs_.push_back(std::move(job));
+        pending_literals_.insert(pending_literals_.end(),
+                                 eager_inner_literals.begin(),
+                                 eager_inner_literals.end());
+      }
+      num_pending_literals_.store(pending_literals_.size(),
+                                  std::memory_order_relaxed);
+      if (!pending_literals_.empty()) delegate->NotifyConcurrencyIncrease();
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    return num_pending_literals_.load(std::memory_order_relaxed) +
+           worker_count;
+  }
+
+  // Moves the executed jobs to |jobs|, with every function's job ahead of the
+  // jobs of its inner functions. Returns false if any job failed.
+  bool TakeJobs(UnoptimizedCompilationJobList* jobs) {
+    DCHECK(jobs->empty());
+    if (failed_) return false;
+    // A parent is always executed before its inner literals are enqueued, so
+    // the execution order already puts parents first.
+    for (auto it = finished_jobs_.rbegin(); it != finished_jobs_.rend();
+         ++it) {
+      jobs->emplace_front(std::move(*it));
+    }
+    finished_jobs_.clear();
+    return true;
+  }
+
+ private:
+  ParseInfo* const parse_info_;
+  AccountingAllocator* const allocator_;
+  const size_t max_stack_size_;
+
+  base::Mutex asm_js_mutex_;
+  base::Mutex mutex_;
+  std::vector<FunctionLiteral*> pending_literals_;
+  std::atomic<size_t> num_pending_literals_;
+  std::vector<std::unique_ptr<UnoptimizedCompilationJob>> finished_jobs_;
+  bool failed_ = false;
+};
+
+bool ExecuteUnoptimizedCompilationJobsInParallel(
+    ParseInfo* parse_info, AccountingAllocator* allocator,
+    UnoptimizedCompilationJobList* jobs) {
+  auto parallel_jobs = std::make_unique<ParallelUnoptimizedCompilationJobs>(
+      parse_info, allocator, FLAG_stack_size);
+  ParallelUnoptimizedCompilationJobs* parallel_jobs_ptr = parallel_jobs.get();
+  std::unique_ptr<JobHandle> handle = V8::GetCurrentPlatform()->PostJob(
+      TaskPriority::kUserBlocking, std::move(parallel_jobs));
+  // The calling thread contributes to the job until all literals are done.
+  handle->Join();
+  return parallel_jobs_ptr->TakeJobs(jobs);
+}
+
 // TODO(leszeks): Remove this once off-thread finalization is always on.
 void CompileOnBackgroundThread(ParseInfo* parse_info,
                                AccountingAllocator* allocator,
@@ -1554,8 +1682,15 @@ void CompileOnBackgroundThread(ParseInfo* parse_info,
   // Generate the unoptimized bytecode or asm-js data.
   DCHECK(jobs->empty());
 
-  bool success = RecursivelyExecuteUnoptimizedCompilationJobs(
-      parse_info, parse_info->literal(), allocator, jobs);
+  // Worker threads can't share the parse info's runtime call stats, so only
+  // compile in parallel when those aren't being collected.
+  bool success =
+      FLAG_parallel_streaming_compile &&
+              !TracingFlags::is_runtime_stats_enabled()
+          ? ExecuteUnoptimizedCompilationJobsInParallel(parse_info, allocator,
+                                                        jobs)
+          : RecursivelyExecuteUnoptimizedCompilationJobs(
+                parse_info, parse_info->literal(), allocator, jobs);
 
   USE(success);
   DCHECK_EQ(success, !jobs->empty());
@@ -1586,11 +1721,13 @@ DeferredFinalizationJobData::DeferredFinalizationJobData(
     : function_handle_(isolate->heap()->NewPersistentHandle(function_handle)),
       job_(std::move(job)) {}
 
-BackgroundCompileTask::BackgroundCompileTask(ScriptStreamingData* streamed_data,
-                                             Isolate* isolate, ScriptType type)
+BackgroundCompileTask::BackgroundCompileTask(
+    ScriptStreamingData* streamed_data, Isolate* isolate, ScriptType type,
+    ScriptCompiler::CompileOptions options)
     : flags_(UnoptimizedCompileFlags::ForToplevelCompile(
-          isolate, true, construct_language_mode(FLAG_use_strict),
-          REPLMode::kNo, type)),
+                 isolate, true, construct_language_mode(FLAG_use_strict),
+                 REPLMode::kNo, type)
+                 .set_is_eager(options == ScriptCompiler::kEagerCompile)),
       compile_state_(isolate),
       info_(std::make_unique<ParseInfo>(isolate, flags_, &compile_state_)),
       isolate_for_local_isolate_(isolate),
@@ -1613,6 +1750,9 @@ BackgroundCompileTask::BackgroundCompileTask(ScriptStreamingData* streamed_data,
   std::unique_ptr<Utf16CharacterStream> stream(ScannerStream::For(
       streamed_data->source_stream.get(), streamed_data->encoding));
   info_->set_character_stream(std::move(stream));
+  if (!streamed_data->compile_hints.empty()) {
+    info_->set_compile_hints(&streamed_data->compile_hints);
+  }
 }
 
 BackgroundCompileTask::BackgroundCompileTask(
@@ -2692,6 +2832,7 @@ MaybeHandle<SharedFunctionInfo> CompileScriptOnMainThread(
   UnoptimizedCompileState compile_state(isolate);
   ParseInfo parse_info(isolate, flags, &compile_state);
   parse_info.set_extension(extension);
+  parse_info.set_compile_hints(script_details.compile_hints);
 
   Handle<Script> script = NewScript(isolate, &parse_info, source,
                                     script_details, origin_options, natives);
@@ -2836,23 +2977,24 @@ MaybeHandle<SharedFunctionInfo> CompileScriptOnBothBackgroundAndMainThread(
   return maybe_result;
 }
 
-}  // namespace
-
-// static
-MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
+MaybeHandle<SharedFunctionInfo> GetSharedFunctionInfoForScriptImpl(
     Isolate* isolate, Handle<String> source,
     const Compiler::ScriptDetails& script_details,
     ScriptOriginOptions origin_options, v8::Extension* extension,
-    ScriptData* cached_data, ScriptCompiler::CompileOptions compile_options,
+    ScriptData* cached_data, BackgroundDeserializeTask* deserialize_task,
+    ScriptCompiler::CompileOptions compile_options,
     ScriptCompiler::NoCacheReason no_cache_reason, NativesFlag natives) {
   ScriptCompileTimerScope compile_timer(isolate, no_cache_reason);
 
   if (compile_options == ScriptCompiler::kNoCompileOptions ||
       compile_options == ScriptCompiler::kEagerCompile) {
     DCHECK_NULL(cached_data);
+    DCHECK_NULL(deserialize_task);
   } else {
     DCHECK(compile_options == ScriptCompiler::kConsumeCodeCache);
-    DCHECK(cached_data);
+    // Have to have exactly one of cached_data or deserialize_task.
+    DCHECK(cached_data || deserialize_task);
+    DCHECK(!(cached_data && deserialize_task));
     DCHECK_NULL(extension);
   }
   int source_length = source->length();
@@ -2890,10 +3032,13 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
           isolate, RuntimeCallCounterId::kCompileDeserialize);
       TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
                    "V8.CompileDeserialize");
+      MaybeHandle<SharedFunctionInfo> maybe_inner_result =
+          deserialize_task
+              ? deserialize_task->Finish(isolate, source, origin_options)
+              : CodeSerializer::Deserialize(isolate, cached_data, source,
+                                            origin_options);
       Handle<SharedFunctionInfo> inner_result;
-      if (CodeSerializer::Deserialize(isolate, cached_data, source,
-                                      origin_options)
-              .ToHandle(&inner_result) &&
+      if (maybe_inner_result.ToHandle(&inner_result) &&
           inner_result->is_compiled()) {
         // Promote to per-isolate compilation cache.
         is_compiled_scope = inner_result->is_compiled_scope(isolate);
@@ -2947,6 +3092,34 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
   return maybe_result;
 }
 
+}  // namespace
+
+// static
+MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
+    Isolate* isolate, Handle<String> source,
+    const Compiler::ScriptDetails& script_details,
+    ScriptOriginOptions origin_options, v8::Extension* extension,
+    ScriptData* cached_data, ScriptCompiler::CompileOptions compile_options,
+    ScriptCompiler::NoCacheReason no_cache_reason, NativesFlag natives) {
+  return GetSharedFunctionInfoForScriptImpl(
+      isolate, source, script_details, origin_options, extension, cached_data,
+      nullptr, compile_options, no_cache_reason, natives);
+}
+
+// static
+MaybeHandle<SharedFunctionInfo>
+Compiler::GetSharedFunctionInfoForScriptWithDeserializeTask(
+    Isolate* isolate, Handle<String> source,
+    const Compiler::ScriptDetails& script_details,
+    ScriptOriginOptions origin_options,
+    BackgroundDeserializeTask* deserialize_task,
+    ScriptCompiler::CompileOptions compile_options,
+    ScriptCompiler::NoCacheReason no_cache_reason, NativesFlag natives) {
+  return GetSharedFunctionInfoForScriptImpl(
+      isolate, source, script_details, origin_options, nullptr, nullptr,
+      deserialize_task, compile_options, no_cache_reason, natives);
+}
+
 // static
 MaybeHandle<JSFunction> Compiler::GetWrappedFunction(
     Handle<String> source, Handle<FixedArray> arguments,
@@ -3356,5 +3529,39 @@ ScriptStreamingData::~ScriptStreamingData() = default;
 
 void ScriptStreamingData::Release() { task.reset(); }
 
+// ----------------------------------------------------------------------------
+// Implementation of BackgroundDeserializeTask
+
+BackgroundDeserializeTask::BackgroundDeserializeTask(
+    Isolate* isolate, std::unique_ptr<ScriptCompiler::CachedData> cached_data)
+    : isolate_for_local_isolate_(isolate),
+      cached_data_(std::move(cached_data)),
+      script_data_(cached_data_->data, cached_data_->length) {}
+
+void BackgroundDeserializeTask::Run() {
+  // Code objects can only be allocated on the main thread, so a cache that may
+  // hold native context independent code is deserialized in Finish instead.
+  if (FLAG_turbo_nci_code_cache) return;
+
+  LocalIsolate isolate(isolate_for_local_isolate_, ThreadKind::kBackground);
+  UnparkedScope unparked_scope(&isolate);
+  LocalHandleScope handle_scope(&isolate);
+
+  off_thread_data_ =
+      CodeSerializer::StartDeserializeOffThread(&isolate, &script_data_);
+}
+
+MaybeHandle<SharedFunctionInfo> BackgroundDeserializeTask::Finish(
+    Isolate* isolate, Handle<String> source,
+    ScriptOriginOptions origin_options) {
+  if (FLAG_turbo_nci_code_cache) {
+    return CodeSerializer::Deserialize(isolate, &script_data_, source,
+                                      origin_options);
+  }
+  return CodeSerializer::FinishOffThreadDeserialize(
+      isolate, std::move(off_thread_data_), &script_data_, source,
+      origin_options);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -7,6 +7,7 @@
 
 #include <forward_list>
 #include <memory>
+#include <vector>
 
 #include "src/base/platform/elapsed-timer.h"
 #include "src/codegen/bailout-reason.h"
@@ -19,6 +20,7 @@
 #include "src/objects/debug-objects.h"
 #include "src/parsing/parse-info.h"
 #include "src/parsing/pending-compilation-error-handler.h"
+#include "src/snapshot/code-serializer.h"
 #include "src/utils/allocation.h"
 #include "src/zone/zone.h"
 
@@ -28,6 +30,7 @@ namespace internal {
 // Forward declarations.
 class AstRawString;
 class BackgroundCompileTask;
+class BackgroundDeserializeTask;
 class IsCompiledScope;
 class JavaScriptFrame;
 class OptimizedCompilationInfo;
@@ -141,6 +144,8 @@ class V8_EXPORT_PRIVATE Compiler : public AllStatic {
     i::MaybeHandle<i::Object> source_map_url;
     i::MaybeHandle<i::FixedArray> host_defined_options;
     REPLMode repl_mode;
+    // Sorted start positions of functions to compile eagerly. Not owned.
+    const std::vector<int>* compile_hints = nullptr;
   };
 
   // Create a function that results from wrapping |source| in a function,
@@ -178,6 +183,18 @@ class V8_EXPORT_PRIVATE Compiler : public AllStatic {
       ScriptCompiler::NoCacheReason no_cache_reason,
       NativesFlag is_natives_code);
 
+  // Create a shared function info object for a String source, consuming the
+  // code cache that |deserialize_task| has deserialized on a background
+  // thread. Falls back to compiling if the cache is rejected.
+  static MaybeHandle<SharedFunctionInfo>
+  GetSharedFunctionInfoForScriptWithDeserializeTask(
+      Isolate* isolate, Handle<String> source,
+      const ScriptDetails& script_details, ScriptOriginOptions origin_options,
+      BackgroundDeserializeTask* deserialize_task,
+      ScriptCompiler::CompileOptions compile_options,
+      ScriptCompiler::NoCacheReason no_cache_reason,
+      NativesFlag is_natives_code);
+
   // Create a shared function info object for a Script source that has already
   // been parsed and possibly compiled on a background thread while being loaded
   // from a streamed source. On return, the data held by |streaming_data| will
@@ -298,6 +315,7 @@ class UnoptimizedCompilationJob : public CompilationJob {
   }
 
   uintptr_t stack_limit() const { return stack_limit_; }
+  void set_stack_limit(uintptr_t stack_limit) { stack_limit_ = stack_limit; }
 
   base::TimeDelta time_taken_to_execute() const {
     return time_taken_to_execute_;
@@ -471,9 +489,13 @@ class V8_EXPORT_PRIVATE BackgroundCompileTask {
   // Creates a new task that when run will parse and compile the streamed
   // script associated with |data| and can be finalized with
   // Compiler::GetSharedFunctionInfoForStreamedScript.
+  // With |options| set to kEagerCompile, all functions of the script are
+  // compiled eagerly.
   // Note: does not take ownership of |data|.
   BackgroundCompileTask(ScriptStreamingData* data, Isolate* isolate,
-                        v8::ScriptType type);
+                        v8::ScriptType type,
+                        ScriptCompiler::CompileOptions options =
+                            ScriptCompiler::kNoCompileOptions);
   BackgroundCompileTask(const BackgroundCompileTask&) = delete;
   BackgroundCompileTask& operator=(const BackgroundCompileTask&) = delete;
   ~BackgroundCompileTask();
@@ -567,10 +589,41 @@ struct ScriptStreamingData {
   std::unique_ptr<ScriptCompiler::ExternalSourceStream> source_stream;
   ScriptCompiler::StreamedSource::Encoding encoding;
 
+  // Sorted start positions of functions to compile eagerly.
+  std::vector<int> compile_hints;
+
   // Task that performs background parsing and compilation.
   std::unique_ptr<BackgroundCompileTask> task;
 };
 
+class V8_EXPORT_PRIVATE BackgroundDeserializeTask {
+ public:
+  // Creates a new task that when run will deserialize the code cache |data|
+  // and can be finalized with Finish, or by passing it to
+  // Compiler::GetSharedFunctionInfoForScriptWithDeserializeTask.
+  BackgroundDeserializeTask(Isolate* isolate,
+                            std::unique_ptr<ScriptCompiler::CachedData> data);
+  BackgroundDeserializeTask(const BackgroundDeserializeTask&) = delete;
+  BackgroundDeserializeTask& operator=(const BackgroundDeserializeTask&) =
+      delete;
+
+  void Run();
+
+  // Checks the deserialized code against |source| and merges it into the
+  // isolate. Returns an empty handle if the cache was rejected.
+  MaybeHandle<SharedFunctionInfo> Finish(Isolate* isolate,
+                                         Handle<String> source,
+                                         ScriptOriginOptions origin_options);
+
+  bool rejected() const { return script_data_.rejected(); }
+
+ private:
+  Isolate* isolate_for_local_isolate_;
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data_;
+  ScriptData script_data_;
+  CodeSerializer::OffThreadDeserializeData off_thread_data_;
+};
+
 }  // namespace internal
 }  // namespace v8
 
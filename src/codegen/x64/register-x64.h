@@ -182,6 +182,7 @@ class XMMRegister : public RegisterBase<XMMRegister, kDoubleAfterLast> {
 
  private:
   friend class RegisterBase<XMMRegister, kDoubleAfterLast>;
+  friend class YMMRegister;
   explicit constexpr XMMRegister(int code) : RegisterBase(code) {}
 };
 
@@ -195,6 +196,20 @@ using DoubleRegister = XMMRegister;
 
 using Simd128Register = XMMRegister;
 
+// The 256-bit AVX registers; the lower halves alias the XMM registers with the
+// same code.
+class YMMRegister : public XMMRegister {
+ public:
+  static constexpr YMMRegister from_xmm(XMMRegister reg) {
+    return YMMRegister(reg.code());
+  }
+
+ private:
+  explicit constexpr YMMRegister(int code) : XMMRegister(code) {}
+};
+
+ASSERT_TRIVIALLY_COPYABLE(YMMRegister);
+
 #define DECLARE_REGISTER(R) \
   constexpr DoubleRegister R = DoubleRegister::from_code(kDoubleCode_##R);
 DOUBLE_REGISTERS(DECLARE_REGISTER)
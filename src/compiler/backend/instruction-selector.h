@@ -659,6 +659,13 @@ class V8_EXPORT_PRIVATE InstructionSelector final {
   // Swaps the two first input operands of the node, to help match shuffles
   // to specific architectural instructions.
   void SwapShuffleInputs(Node* node);
+
+#if V8_TARGET_ARCH_X64
+  // Tries to emit the Simd128 store {node}, the adjacent store before it and
+  // the binary operations computing both stored values as one 256-bit
+  // operation.
+  bool TryVisitPairedSimd128Stores(Node* node);
+#endif  // V8_TARGET_ARCH_X64
 #endif  // V8_ENABLE_WEBASSEMBLY
 
   // ===========================================================================
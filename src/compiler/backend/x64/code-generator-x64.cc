@@ -393,6 +393,21 @@ void EmitOOLTrapIfNeeded(Zone* zone, CodeGenerator* codegen,
   }
 }
 
+// Emits {dst} = {src1} {binop} {src2} on 128-bit or 256-bit registers.
+template <typename RegisterT, typename OperandT>
+void EmitSimd256PairedBinop(TurboAssembler* tasm, Simd256PairedBinop binop,
+                            RegisterT dst, RegisterT src1, OperandT src2) {
+  switch (binop) {
+#define CASE(Name, opcode, pp, m)                                  \
+  case Simd256PairedBinop::k##Name:                                \
+    tasm->vinstr(0x##opcode, dst, src1, src2, Assembler::k##pp,    \
+                 Assembler::k##m, Assembler::kW0);                 \
+    break;
+    SIMD256_PAIRED_BINOP_LIST(CASE)
+#undef CASE
+  }
+}
+
 #else
 
 void EmitOOLTrapIfNeeded(Zone* zone, CodeGenerator* codegen,
@@ -2187,6 +2202,122 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       }
       break;
     }
+    case kX64S256PairedBinop: {
+#if V8_ENABLE_WEBASSEMBLY
+      // Computes two Simd128 operations on adjacent memory and stores both
+      // results with one 256-bit load, operation and store. If one of them
+      // faults, or the first store of the original sequence writes memory
+      // that the second operation reads afterwards, the two 128-bit
+      // operations are executed in their original order instead; that way an
+      // out-of-bounds access traps after the same stores as before.
+      CpuFeatureScope avx_scope(tasm(), AVX);
+      CpuFeatureScope avx2_scope(tasm(), AVX2);
+      Simd256PairedBinop binop = Simd256PairedBinopField::decode(opcode);
+      bool lhs_in_register = Simd256LhsInRegisterField::decode(opcode);
+      bool rhs_in_register = Simd256RhsInRegisterField::decode(opcode);
+      bool loads_first = Simd256LoadsFirstField::decode(opcode);
+      size_t lhs_input = 0;
+      size_t rhs_input = lhs_input + (lhs_in_register ? 1 : 3);
+      size_t dst_input = rhs_input + (rhs_in_register ? 1 : 3);
+      auto memory_operand = [&](size_t input, int32_t offset) {
+        return Operand(i.InputRegister(input), i.InputRegister(input + 1),
+                       times_1, i.InputInt32(input + 2) + offset);
+      };
+      Label slow_path, done;
+
+      // If the original sequence loads the second half after the first
+      // store, that store would overwrite the second half of a memory operand
+      // if 0 < dst - src < 32. Otherwise all loads happen before any store,
+      // like in the 256-bit operation.
+      Register tmp = i.TempRegister(0);
+      auto check_overlap = [&](size_t input) {
+        __ leaq(kScratchRegister, memory_operand(dst_input, 0));
+        __ leaq(tmp, memory_operand(input, 0));
+        __ subq(kScratchRegister, tmp);
+        __ subq(kScratchRegister, Immediate(1));
+        __ cmpq(kScratchRegister, Immediate(2 * kSimd128Size - 1));
+        __ j(below, &slow_path);
+      };
+      if (!loads_first && !lhs_in_register) check_overlap(lhs_input);
+      if (!loads_first && !rhs_in_register) check_overlap(rhs_input);
+
+      YMMRegister scratch = YMMRegister::from_xmm(kScratchDoubleReg);
+      XMMRegister second_half = i.TempSimd128Register(1);
+      YMMRegister src1 = scratch;
+      YMMRegister src2 = scratch;
+      if (lhs_in_register || rhs_in_register) {
+        // Broadcast the shared operand to both halves.
+        XMMRegister value = i.InputSimd128Register(
+            lhs_in_register ? lhs_input : rhs_input);
+        YMMRegister shared = YMMRegister::from_xmm(second_half);
+        __ vinserti128(shared, YMMRegister::from_xmm(value), value, 1);
+        if (lhs_in_register) {
+          src1 = shared;
+        } else {
+          src2 = shared;
+        }
+      }
+      int fault_pcs[3];
+      int num_fault_pcs = 0;
+      if (!lhs_in_register) {
+        fault_pcs[num_fault_pcs++] = __ pc_offset();
+        __ vmovdqu(scratch, memory_operand(lhs_input, 0));
+      }
+      if (rhs_in_register) {
+        EmitSimd256PairedBinop(tasm(), binop, scratch, src1, src2);
+      } else {
+        fault_pcs[num_fault_pcs++] = __ pc_offset();
+        EmitSimd256PairedBinop(tasm(), binop, scratch, src1,
+                               memory_operand(rhs_input, 0));
+      }
+      fault_pcs[num_fault_pcs++] = __ pc_offset();
+      __ vmovdqu(memory_operand(dst_input, 0), scratch);
+      __ jmp(&done);
+
+      // A faulting 256-bit access does not write any memory and resumes here.
+      __ bind(&slow_path);
+      for (int k = 0; k < num_fault_pcs; ++k) {
+        AddProtectedInstructionLanding(fault_pcs[k], __ pc_offset());
+      }
+      auto compute_half = [&](XMMRegister result, int32_t offset) {
+        XMMRegister src =
+            lhs_in_register ? i.InputSimd128Register(lhs_input) : result;
+        if (!lhs_in_register) {
+          EmitOOLTrapIfNeeded(zone(), this, opcode, instr, __ pc_offset());
+          __ vmovdqu(result, memory_operand(lhs_input, offset));
+        }
+        if (rhs_in_register) {
+          EmitSimd256PairedBinop(tasm(), binop, result, src,
+                                 i.InputSimd128Register(rhs_input));
+        } else {
+          EmitOOLTrapIfNeeded(zone(), this, opcode, instr, __ pc_offset());
+          EmitSimd256PairedBinop(tasm(), binop, result, src,
+                                 memory_operand(rhs_input, offset));
+        }
+      };
+      auto store_half = [&](XMMRegister result, int32_t offset) {
+        EmitOOLTrapIfNeeded(zone(), this, opcode, instr, __ pc_offset());
+        __ vmovdqu(memory_operand(dst_input, offset), result);
+      };
+      if (loads_first) {
+        compute_half(kScratchDoubleReg, 0);
+        compute_half(second_half, kSimd128Size);
+        store_half(kScratchDoubleReg, 0);
+        store_half(second_half, kSimd128Size);
+      } else {
+        for (int32_t offset : {0, kSimd128Size}) {
+          compute_half(kScratchDoubleReg, offset);
+          store_half(kScratchDoubleReg, offset);
+        }
+      }
+      __ bind(&done);
+      // Avoid AVX-SSE transition penalties in the following code.
+      __ vzeroupper();
+#else
+      UNREACHABLE();
+#endif  // V8_ENABLE_WEBASSEMBLY
+      break;
+    }
     case kX64BitcastFI:
       if (instr->InputAt(0)->IsFPStackSlot()) {
         __ movl(i.OutputRegister(), i.InputOperand(0));
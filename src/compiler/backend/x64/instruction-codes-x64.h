@@ -5,6 +5,10 @@
 #ifndef V8_COMPILER_BACKEND_X64_INSTRUCTION_CODES_X64_H_
 #define V8_COMPILER_BACKEND_X64_INSTRUCTION_CODES_X64_H_
 
+#include <cstdint>
+
+#include "src/base/bit-field.h"
+
 namespace v8 {
 namespace internal {
 namespace compiler {
@@ -143,6 +147,7 @@ namespace compiler {
   V(X64Movsd)                             \
   V(X64Movss)                             \
   V(X64Movdqu)                            \
+  V(X64S256PairedBinop)                   \
   V(X64BitcastFI)                         \
   V(X64BitcastDL)                         \
   V(X64BitcastIF)                         \
@@ -452,6 +457,47 @@ namespace compiler {
   V(M8I)  /* [      %r2*8 + K] */      \
   V(Root) /* [%root       + K] */
 
+// The binary operations that kX64S256PairedBinop can compute on two adjacent
+// Simd128 values at once, with their VEX encoding (opcode byte, SIMD prefix,
+// leading opcode bytes).
+#define SIMD256_PAIRED_BINOP_LIST(V) \
+  V(I8x16Add, FC, 66, 0F)            \
+  V(I8x16Sub, F8, 66, 0F)            \
+  V(I16x8Add, FD, 66, 0F)            \
+  V(I16x8Sub, F9, 66, 0F)            \
+  V(I16x8Mul, D5, 66, 0F)            \
+  V(I32x4Add, FE, 66, 0F)            \
+  V(I32x4Sub, FA, 66, 0F)            \
+  V(I32x4Mul, 40, 66, 0F38)          \
+  V(I64x2Add, D4, 66, 0F)            \
+  V(I64x2Sub, FB, 66, 0F)            \
+  V(F32x4Add, 58, None, 0F)          \
+  V(F32x4Sub, 5C, None, 0F)          \
+  V(F32x4Mul, 59, None, 0F)          \
+  V(F32x4Div, 5E, None, 0F)          \
+  V(F64x2Add, 58, 66, 0F)            \
+  V(F64x2Sub, 5C, 66, 0F)            \
+  V(F64x2Mul, 59, 66, 0F)            \
+  V(F64x2Div, 5E, 66, 0F)            \
+  V(S128And, DB, 66, 0F)             \
+  V(S128Or, EB, 66, 0F)              \
+  V(S128Xor, EF, 66, 0F)
+
+enum class Simd256PairedBinop : uint8_t {
+#define DECLARE_BINOP(Name, ...) k##Name,
+  SIMD256_PAIRED_BINOP_LIST(DECLARE_BINOP)
+#undef DECLARE_BINOP
+};
+
+// kX64S256PairedBinop encodes its operation, whether each operand is a
+// register (shared by both halves) or a pair of adjacent memory locations, and
+// whether the original sequence loads both halves before the first store, in
+// the bits of the MiscField that are not used by the AccessModeField.
+using Simd256PairedBinopField = base::BitField<Simd256PairedBinop, 22, 5>;
+using Simd256LhsInRegisterField = Simd256PairedBinopField::Next<bool, 1>;
+using Simd256RhsInRegisterField = Simd256LhsInRegisterField::Next<bool, 1>;
+using Simd256LoadsFirstField = Simd256RhsInRegisterField::Next<bool, 1>;
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
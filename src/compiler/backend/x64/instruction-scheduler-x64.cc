@@ -415,6 +415,7 @@ int InstructionScheduler::GetTargetInstructionFlags(
 
     case kX64Push:
     case kX64Poke:
+    case kX64S256PairedBinop:
       return kHasSideEffect;
 
     case kX64MFence:
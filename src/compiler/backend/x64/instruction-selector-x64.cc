@@ -6,6 +6,7 @@
 
 #include "src/base/iterator.h"
 #include "src/base/logging.h"
+#include "src/base/optional.h"
 #include "src/base/overflowing-math.h"
 #include "src/base/platform/wrappers.h"
 #include "src/codegen/cpu-features.h"
@@ -521,7 +522,216 @@ void InstructionSelector::VisitStore(Node* node) {
   }
 }
 
+#if V8_ENABLE_WEBASSEMBLY
+namespace {
+
+// A Simd128 memory access at {base} + {index} + {displacement}.
+struct Simd128MemoryAccess {
+  Node* base;
+  Node* index;
+  int64_t displacement;
+};
+
+Node* StripConstantDisplacement(Node* node, int64_t* displacement) {
+  if (node->opcode() != IrOpcode::kInt64Add) return node;
+  Int64BinopMatcher m(node);
+  if (!m.right().HasResolvedValue()) return node;
+  *displacement =
+      base::AddWithWraparound(*displacement, m.right().ResolvedValue());
+  return m.left().node();
+}
+
+bool MatchSimd128MemoryAccess(Node* node, Simd128MemoryAccess* access) {
+  MachineRepresentation rep;
+  if (node->opcode() == IrOpcode::kProtectedLoad) {
+    rep = LoadRepresentationOf(node->op()).representation();
+  } else if (node->opcode() == IrOpcode::kProtectedStore) {
+    rep = StoreRepresentationOf(node->op()).representation();
+  } else {
+    return false;
+  }
+  if (rep != MachineRepresentation::kSimd128) return false;
+  access->displacement = 0;
+  access->base =
+      StripConstantDisplacement(node->InputAt(0), &access->displacement);
+  access->index =
+      StripConstantDisplacement(node->InputAt(1), &access->displacement);
+  // The second half of a pair is accessed at {displacement} + 16.
+  return is_int32(access->displacement) &&
+         is_int32(access->displacement + kSimd128Size);
+}
+
+bool AreAdjacent(const Simd128MemoryAccess& first,
+                 const Simd128MemoryAccess& second) {
+  return first.base == second.base && first.index == second.index &&
+         first.displacement + kSimd128Size == second.displacement;
+}
+
+base::Optional<Simd256PairedBinop> TryGetSimd256PairedBinop(Node* node) {
+  switch (node->opcode()) {
+#define CASE(Name, ...)     \
+  case IrOpcode::k##Name: \
+    return Simd256PairedBinop::k##Name;
+    SIMD256_PAIRED_BINOP_LIST(CASE)
+#undef CASE
+    default:
+      return base::nullopt;
+  }
+}
+
+// Returns true if {value} is the only node with a value edge to {load}.
+bool IsOnlyValueUse(Node* value, Node* load) {
+  for (Edge const edge : load->use_edges()) {
+    if (edge.from() != value && NodeProperties::IsValueEdge(edge)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HasSingleEffectUse(Node* node) {
+  int effect_uses = 0;
+  for (Edge const edge : node->use_edges()) {
+    if (NodeProperties::IsEffectEdge(edge)) ++effect_uses;
+  }
+  return effect_uses == 1;
+}
+
+}  // namespace
+
+// Matches
+//
+//   ProtectedStore[simd128](d, binop(x0, y0))
+//   ProtectedStore[simd128](d + 16, binop(x1, y1))
+//
+// where each pair of operands is either the same node or two loads of
+// adjacent memory, and emits both stores as one kX64S256PairedBinop. All loads
+// and the first store have to be on a contiguous part of the effect chain that
+// ends in {node}, so that no other memory access is reordered with them.
+bool InstructionSelector::TryVisitPairedSimd128Stores(Node* node) {
+  if (!FLAG_wasm_simd_revectorize || !IsSupported(AVX2)) return false;
+  Simd128MemoryAccess second_store;
+  if (!MatchSimd128MemoryAccess(node, &second_store)) return false;
+
+  // Skip the loads between the two stores on the effect chain.
+  constexpr int kMaxLoads = 4;
+  Node* loads[kMaxLoads];
+  int num_loads = 0;
+  Node* first = NodeProperties::GetEffectInput(node);
+  while (first->opcode() == IrOpcode::kProtectedLoad) {
+    if (num_loads == kMaxLoads) return false;
+    loads[num_loads++] = first;
+    first = NodeProperties::GetEffectInput(first);
+  }
+  Simd128MemoryAccess first_store;
+  if (first->opcode() != IrOpcode::kProtectedStore ||
+      !MatchSimd128MemoryAccess(first, &first_store) ||
+      !AreAdjacent(first_store, second_store) ||
+      schedule()->block(first) != current_block_ ||
+      !HasSingleEffectUse(first)) {
+    return false;
+  }
+
+  Node* first_value = first->InputAt(2);
+  Node* second_value = node->InputAt(2);
+  base::Optional<Simd256PairedBinop> binop =
+      TryGetSimd256PairedBinop(first_value);
+  if (!binop.has_value() || first_value->op() != second_value->op() ||
+      !CanCover(first, first_value) || !CanCover(node, second_value)) {
+    return false;
+  }
+
+  // Match the operands; shared operands go to a register, pairs of loads are
+  // folded into memory operands.
+  Node* paired_loads[kMaxLoads];
+  int num_paired_loads = 0;
+  Simd128MemoryAccess operands[2];
+  bool in_register[2];
+  for (int i = 0; i < 2; ++i) {
+    Node* first_input = first_value->InputAt(i);
+    Node* second_input = second_value->InputAt(i);
+    in_register[i] = first_input == second_input;
+    if (in_register[i]) continue;
+    Simd128MemoryAccess second_access;
+    if (!MatchSimd128MemoryAccess(first_input, &operands[i]) ||
+        !MatchSimd128MemoryAccess(second_input, &second_access) ||
+        !AreAdjacent(operands[i], second_access) ||
+        !IsOnlyValueUse(first_value, first_input) ||
+        !IsOnlyValueUse(second_value, second_input)) {
+      return false;
+    }
+    paired_loads[num_paired_loads++] = first_input;
+    paired_loads[num_paired_loads++] = second_input;
+  }
+  if (in_register[0] && in_register[1]) return false;
+
+  // The loads between the stores have to be either none of the paired loads
+  // or exactly those of the second half; the code generator executes the
+  // halves in the same order when it cannot use the 256-bit operation. The
+  // remaining paired loads have to directly precede the first store.
+  auto is_paired_load = [&](Node* load) {
+    return std::find(paired_loads, paired_loads + num_paired_loads, load) !=
+           paired_loads + num_paired_loads;
+  };
+  bool loads_first = num_loads == 0;
+  if (!loads_first && 2 * num_loads != num_paired_loads) return false;
+  for (int i = 0; i < num_loads; ++i) {
+    if (loads[i] != second_value->InputAt(0) &&
+        loads[i] != second_value->InputAt(1)) {
+      return false;
+    }
+  }
+  Node* effect = NodeProperties::GetEffectInput(first);
+  for (int i = num_loads; i < num_paired_loads; ++i) {
+    if (!is_paired_load(effect)) return false;
+    effect = NodeProperties::GetEffectInput(effect);
+  }
+  for (int i = 0; i < num_paired_loads; ++i) {
+    if (schedule()->block(paired_loads[i]) != current_block_ ||
+        !HasSingleEffectUse(paired_loads[i])) {
+      return false;
+    }
+  }
+
+  X64OperandGenerator g(this);
+  InstructionOperand inputs[9];
+  size_t input_count = 0;
+  auto add_memory_operand = [&](const Simd128MemoryAccess& access) {
+    inputs[input_count++] = g.UseRegister(access.base);
+    inputs[input_count++] = g.UseRegister(access.index);
+    inputs[input_count++] =
+        g.TempImmediate(static_cast<int32_t>(access.displacement));
+  };
+  for (int i = 0; i < 2; ++i) {
+    if (in_register[i]) {
+      inputs[input_count++] = g.UseRegister(first_value->InputAt(i));
+    } else {
+      add_memory_operand(operands[i]);
+    }
+  }
+  add_memory_operand(first_store);
+  InstructionOperand temps[] = {g.TempRegister(), g.TempSimd128Register()};
+  InstructionCode code = kX64S256PairedBinop |
+                         Simd256PairedBinopField::encode(*binop) |
+                         Simd256LhsInRegisterField::encode(in_register[0]) |
+                         Simd256RhsInRegisterField::encode(in_register[1]) |
+                         Simd256LoadsFirstField::encode(loads_first) |
+                         AccessModeField::encode(kMemoryAccessProtected);
+  Emit(code, 0, nullptr, input_count, inputs, arraysize(temps), temps);
+
+  // The instruction covers the first store, both operations and all loads.
+  MarkAsDefined(first);
+  MarkAsDefined(first_value);
+  MarkAsDefined(second_value);
+  for (int i = 0; i < num_paired_loads; ++i) MarkAsDefined(paired_loads[i]);
+  return true;
+}
+#endif  // V8_ENABLE_WEBASSEMBLY
+
 void InstructionSelector::VisitProtectedStore(Node* node) {
+#if V8_ENABLE_WEBASSEMBLY
+  if (TryVisitPairedSimd128Stores(node)) return;
+#endif  // V8_ENABLE_WEBASSEMBLY
   X64OperandGenerator g(this);
   Node* value = node->InputAt(2);
 
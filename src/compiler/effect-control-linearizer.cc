@@ -244,6 +244,7 @@ class EffectControlLinearizer {
   Node* IsElementsKindGreaterThan(Node* kind, ElementsKind reference_kind);
 
   Node* BuildTypedArrayDataPointer(Node* base, Node* external);
+  Node* BuildNewConsString(Node* length, Node* first, Node* second);
 
   template <typename... Args>
   Node* CallBuiltin(Builtins::Name builtin, Operator::Properties properties,
@@ -2107,20 +2108,47 @@ void EffectControlLinearizer::LowerCheckIf(Node* node, Node* frame_state) {
 }
 
 Node* EffectControlLinearizer::LowerStringConcat(Node* node) {
+  Node* length = ChangeSmiToInt32(node->InputAt(0));
   Node* lhs = node->InputAt(1);
   Node* rhs = node->InputAt(2);
 
-  Callable const callable =
-      CodeFactory::StringAdd(isolate(), STRING_ADD_CHECK_NONE);
-  auto call_descriptor = Linkage::GetStubCallDescriptor(
-      graph()->zone(), callable.descriptor(),
-      callable.descriptor().GetStackParameterCount(), CallDescriptor::kNoFlags,
-      Operator::kNoDeopt | Operator::kNoWrite | Operator::kNoThrow);
+  auto if_cons = __ MakeLabel();
+  auto if_call = __ MakeLabel();
+  auto done = __ MakeLabel(MachineRepresentation::kTaggedPointer);
 
-  Node* value = __ Call(call_descriptor, __ HeapConstant(callable.code()), lhs,
-                        rhs, __ NoContextConstant());
+  // Repeated concatenation (i.e. s += piece in a loop, or a template literal
+  // with several substitutions) quickly produces results of at least
+  // ConsString::kMinLength characters, for which the StringAdd builtin would
+  // just allocate a ConsString. Do that inline, and only call the builtin if
+  // one of the inputs is empty or the result should be a flat string. The
+  // length was already checked against String::kMaxLength.
+  __ GotoIf(
+      __ Uint32LessThan(length, __ Uint32Constant(ConsString::kMinLength)),
+      &if_call);
+  Node* lhs_length = __ LoadField(AccessBuilder::ForStringLength(), lhs);
+  __ GotoIf(__ Word32Equal(lhs_length, __ Int32Constant(0)), &if_call);
+  __ GotoIf(__ Word32Equal(lhs_length, length), &if_call);
+  __ Goto(&if_cons);
+
+  __ Bind(&if_cons);
+  __ Goto(&done, BuildNewConsString(length, lhs, rhs));
+
+  __ Bind(&if_call);
+  {
+    Callable const callable =
+        CodeFactory::StringAdd(isolate(), STRING_ADD_CHECK_NONE);
+    auto call_descriptor = Linkage::GetStubCallDescriptor(
+        graph()->zone(), callable.descriptor(),
+        callable.descriptor().GetStackParameterCount(),
+        CallDescriptor::kNoFlags,
+        Operator::kNoDeopt | Operator::kNoWrite | Operator::kNoThrow);
+    Node* value = __ Call(call_descriptor, __ HeapConstant(callable.code()),
+                          lhs, rhs, __ NoContextConstant());
+    __ Goto(&done, value);
+  }
 
-  return value;
+  __ Bind(&done);
+  return done.PhiAt(0);
 }
 
 Node* EffectControlLinearizer::LowerCheckedInt32Add(Node* node,
@@ -3839,7 +3867,11 @@ Node* EffectControlLinearizer::LowerNewConsString(Node* node) {
   Node* length = node->InputAt(0);
   Node* first = node->InputAt(1);
   Node* second = node->InputAt(2);
+  return BuildNewConsString(length, first, second);
+}
 
+Node* EffectControlLinearizer::BuildNewConsString(Node* length, Node* first,
+                                                  Node* second) {
   // Determine the instance types of {first} and {second}.
   Node* first_map = __ LoadField(AccessBuilder::ForMap(), first);
   Node* first_instance_type =
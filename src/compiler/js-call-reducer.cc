@@ -3442,8 +3442,11 @@ bool CanInlineJSToWasmCall(const wasm::FunctionSig* wasm_signature) {
 #if defined(V8_TARGET_ARCH_32_BIT)
     if (type == wasm::kWasmI64) return false;
 #endif
+    // Externref values are passed and returned as they are, without
+    // conversion.
     if (type != wasm::kWasmI32 && type != wasm::kWasmI64 &&
-        type != wasm::kWasmF32 && type != wasm::kWasmF64) {
+        type != wasm::kWasmF32 && type != wasm::kWasmF64 &&
+        type != wasm::kWasmExternRef) {
       return false;
     }
   }
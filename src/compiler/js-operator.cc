@@ -716,6 +716,9 @@ Type JSWasmCallNode::TypeForWasmReturnType(const wasm::ValueType& type) {
     case wasm::kF32:
     case wasm::kF64:
       return Type::Number();
+    case wasm::kOptRef:
+      DCHECK(type == wasm::kWasmExternRef);
+      return Type::NonInternal();
     default:
       UNREACHABLE();
   }
@@ -4,11 +4,13 @@
 
 #include "src/compiler/loop-variable-optimizer.h"
 
+#include "src/compiler/all-nodes.h"
 #include "src/compiler/common-operator.h"
 #include "src/compiler/graph.h"
 #include "src/compiler/node-marker.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/node.h"
+#include "src/compiler/type-cache.h"
 #include "src/zone/zone-containers.h"
 #include "src/zone/zone.h"
 
@@ -226,6 +228,11 @@ InductionVariable* LoopVariableOptimizer::TryGetInductionVariable(Node* phi) {
   DCHECK_EQ(IrOpcode::kLoop, loop->opcode());
   Node* initial = phi->InputAt(0);
   Node* arith = phi->InputAt(1);
+  // Look through the guard inserted by ChangeToPhisAndInsertGuards, so that
+  // induction variables are still recognized on a graph that has been typed.
+  if (arith->opcode() == IrOpcode::kTypeGuard) {
+    arith = arith->InputAt(0);
+  }
   InductionVariable::ArithmeticType arithmeticType;
   if (arith->opcode() == IrOpcode::kJSAdd ||
       arith->opcode() == IrOpcode::kNumberAdd ||
@@ -345,6 +352,109 @@ void LoopVariableOptimizer::ChangeToPhisAndInsertGuards() {
   }
 }
 
+namespace {
+
+bool IsSubtraction(Node* node) {
+  return node->opcode() == IrOpcode::kNumberSubtract ||
+         node->opcode() == IrOpcode::kSpeculativeNumberSubtract ||
+         node->opcode() == IrOpcode::kSpeculativeSafeIntegerSubtract;
+}
+
+// Returns the type of {node} if it has been computed, and None otherwise.
+Type TypeOrNone(Node* node) {
+  return NodeProperties::IsTyped(node) ? NodeProperties::GetType(node)
+                                       : Type::None();
+}
+
+// Returns true if {node} computes {length} - c for some c >= 1.
+bool IsLengthMinusPositive(Node* node, Node* length) {
+  if (!IsSubtraction(node) || node->InputAt(0) != length) return false;
+  Type subtrahend = TypeOrNone(node->InputAt(1));
+  return !subtrahend.IsNone() && subtrahend.Is(Type::Number()) &&
+         subtrahend.Min() >= 1;
+}
+
+}  // namespace
+
+bool LoopVariableOptimizer::IsProvenNonNegative(Node* index,
+                                                VariableLimits const& limits) {
+  Type index_type = TypeOrNone(index);
+  if (!index_type.IsNone() && index_type.Is(Type::Number()) &&
+      index_type.Min() >= 0) {
+    return true;
+  }
+  // Look for a dominating {bound} <= {index} or {bound} < {index}, e.g. the
+  // condition of a decrementing loop.
+  for (Constraint constraint : limits) {
+    if (constraint.right != index) continue;
+    Type bound_type = TypeOrNone(constraint.left);
+    if (bound_type.IsNone() || !bound_type.Is(Type::Number())) continue;
+    double min = bound_type.Min();
+    if (constraint.kind == InductionVariable::kStrict) min += 1;
+    if (min >= 0) return true;
+  }
+  return false;
+}
+
+bool LoopVariableOptimizer::IsProvenLessThan(Node* index, Node* length,
+                                             VariableLimits const& limits) {
+  // Look for a dominating {index} < {length} or {index} <= {length} - c.
+  for (Constraint constraint : limits) {
+    if (constraint.left != index) continue;
+    if (constraint.kind == InductionVariable::kStrict &&
+        constraint.right == length) {
+      return true;
+    }
+    if (IsLengthMinusPositive(constraint.right, length)) return true;
+  }
+  // A non-increasing induction variable never exceeds its initial value, so
+  // starting at {length} - c is sufficient.
+  const InductionVariable* induction_var = FindInductionVariable(index);
+  if (induction_var == nullptr) return false;
+  Type increment_type = TypeOrNone(induction_var->increment());
+  if (increment_type.IsNone() || !increment_type.Is(Type::Number())) {
+    return false;
+  }
+  bool non_increasing =
+      induction_var->Type() == InductionVariable::kSubtraction
+          ? increment_type.Min() >= 0
+          : increment_type.Max() <= 0;
+  return non_increasing &&
+         IsLengthMinusPositive(induction_var->init_value(), length);
+}
+
+void LoopVariableOptimizer::EliminateRedundantBoundsChecks() {
+  AllNodes all(zone(), graph());
+  for (Node* node : all.reachable) {
+    if (node->opcode() != IrOpcode::kCheckBounds) continue;
+
+    Node* index = NodeProperties::GetValueInput(node, 0);
+    Node* length = NodeProperties::GetValueInput(node, 1);
+    Node* control = NodeProperties::GetControlInput(node);
+    if (!reduced_.Get(control)) continue;
+    // The guard neither converts strings nor deopts on fractional indices,
+    // and its uses truncate the index, so only integral indices qualify.
+    Type index_type = TypeOrNone(index);
+    if (index_type.IsNone() ||
+        !index_type.Is(TypeCache::Get()->kSafeIntegerOrMinusZero)) {
+      continue;
+    }
+    VariableLimits limits = limits_.Get(control);
+    if (!IsProvenNonNegative(index, limits) ||
+        !IsProvenLessThan(index, length, limits)) {
+      continue;
+    }
+
+    TRACE("Bounds check %i on index %i is redundant\n", node->id(),
+          index->id());
+    // The guard keeps the check's narrowed type for the uses of the index and
+    // stays below the dominating loop conditions via its control input.
+    Type type = NodeProperties::GetType(node);
+    node->RemoveInput(1);
+    NodeProperties::ChangeOp(node, common()->TypeGuard(type));
+  }
+}
+
 #undef TRACE
 
 }  // namespace compiler
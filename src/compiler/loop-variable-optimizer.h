@@ -37,7 +37,7 @@ class InductionVariable : public ZoneObject {
   const ZoneVector<Bound>& lower_bounds() { return lower_bounds_; }
   const ZoneVector<Bound>& upper_bounds() { return upper_bounds_; }
 
-  ArithmeticType Type() { return arithmeticType_; }
+  ArithmeticType Type() const { return arithmeticType_; }
 
  private:
   friend class LoopVariableOptimizer;
@@ -81,6 +81,12 @@ class LoopVariableOptimizer {
   void ChangeToInductionVariablePhis();
   void ChangeToPhisAndInsertGuards();
 
+  // Uses the loop conditions dominating each CheckBounds node to prove that
+  // its index lies in [0, length[, in which case the check is replaced by a
+  // TypeGuard carrying the check's type, so that no comparison is emitted for
+  // it. Requires a typed graph and a preceding call to Run.
+  void EliminateRedundantBoundsChecks();
+
  private:
   const int kAssumedLoopEntryIndex = 0;
   const int kFirstBackedge = 1;
@@ -110,6 +116,9 @@ class LoopVariableOptimizer {
                       InductionVariable::ConstraintKind kind, bool polarity);
 
   void TakeConditionsFromFirstControl(Node* node);
+  bool IsProvenNonNegative(Node* index, VariableLimits const& limits);
+  bool IsProvenLessThan(Node* index, Node* length,
+                        VariableLimits const& limits);
   const InductionVariable* FindInductionVariable(Node* node);
   InductionVariable* TryGetInductionVariable(Node* phi);
   void DetectInductionVariables(Node* loop);
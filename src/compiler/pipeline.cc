@@ -1903,6 +1903,19 @@ struct LoadEliminationPhase {
   }
 };
 
+struct BoundsCheckEliminationPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(BoundsCheckElimination)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    // Recompute the loop conditions on the optimized graph, where load
+    // elimination has already unified reloads of the same length field.
+    LoopVariableOptimizer induction_vars(data->jsgraph()->graph(),
+                                         data->common(), temp_zone);
+    induction_vars.Run();
+    induction_vars.EliminateRedundantBoundsChecks();
+  }
+};
+
 struct MemoryOptimizationPhase {
   DECL_PIPELINE_PHASE_CONSTANTS(MemoryOptimization)
 
@@ -2709,6 +2722,13 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
     Run<LoadEliminationPhase>();
     RunPrintAndVerify(LoadEliminationPhase::phase_name());
   }
+
+  if (FLAG_turbo_loop_variable && FLAG_turbo_bounds_check_elimination &&
+      data->info()->GetPoisoningMitigationLevel() ==
+          PoisoningMitigationLevel::kDontPoison) {
+    Run<BoundsCheckEliminationPhase>();
+    RunPrintAndVerify(BoundsCheckEliminationPhase::phase_name());
+  }
   data->DeleteTyper();
 
   if (FLAG_turbo_escape) {
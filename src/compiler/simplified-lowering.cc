@@ -1816,6 +1816,9 @@ class RepresentationSelector {
         return MachineType::Float32();
       case wasm::kF64:
         return MachineType::Float64();
+      case wasm::kOptRef:
+        // Only externref, which is returned to JavaScript unchanged.
+        return MachineType::AnyTagged();
       case wasm::kI64:
         // Not used for i64, see VisitJSWasmCall().
       default:
@@ -1840,6 +1843,9 @@ class RepresentationSelector {
         // WasmWrapperGraphBuilder::BuildJSToWasmWrapper.
         return UseInfo::CheckedNumberOrOddballAsFloat64(kDistinguishZeros,
                                                         feedback);
+      case wasm::kOptRef:
+        // Only externref, which accepts any JavaScript value.
+        return UseInfo::AnyTagged();
       default:
         UNREACHABLE();
     }
@@ -3007,11 +3013,10 @@ class RepresentationSelector {
         return;
       }
       case IrOpcode::kStringConcat: {
-        // TODO(turbofan): We currently depend on having this first length input
-        // to make sure that the overflow check is properly scheduled before the
-        // actual string concatenation. We should also use the length to pass it
-        // to the builtin or decide in optimized code how to construct the
-        // resulting string (i.e. cons string or sequential string).
+        // The length input makes sure that the overflow check is properly
+        // scheduled before the actual string concatenation, and lets the
+        // EffectControlLinearizer decide whether to allocate a ConsString
+        // inline or to call the StringAdd builtin.
         ProcessInput<T>(node, 0, UseInfo::TaggedSigned());  // length
         ProcessInput<T>(node, 1, UseInfo::AnyTagged());     // first
         ProcessInput<T>(node, 2, UseInfo::AnyTagged());     // second
@@ -19,6 +19,7 @@
 #include "src/codegen/interface-descriptors.h"
 #include "src/codegen/machine-type.h"
 #include "src/codegen/optimized-compilation-info.h"
+#include "src/codegen/tick-counter.h"
 #include "src/compiler/backend/code-generator.h"
 #include "src/compiler/backend/instruction-selector.h"
 #include "src/compiler/common-operator.h"
@@ -35,6 +36,7 @@
 #include "src/compiler/node-properties.h"
 #include "src/compiler/pipeline.h"
 #include "src/compiler/simd-scalar-lowering.h"
+#include "src/compiler/wasm-inlining.h"
 #include "src/compiler/zone-stats.h"
 #include "src/execution/isolate-inl.h"
 #include "src/heap/factory.h"
@@ -5459,8 +5461,110 @@ Node* WasmGraphBuilder::StoreArgsInStackSlot(
   return stack_slot;
 }
 
+bool WasmGraphBuilder::GetInlineBulkMemoryChunks(
+    Node* size, base::SmallVector<MachineRepresentation, 8>* chunks) {
+  if (env_->module->is_memory64) return false;
+  Uint32Matcher match(size);
+  if (!match.HasResolvedValue()) return false;
+  uint32_t size_val = match.ResolvedValue();
+  uint32_t max_size = std::min(FLAG_wasm_inline_bulk_memory_max_size,
+                               uint32_t{kMaxUInt8});
+  if (size_val == 0 || size_val > max_size) return false;
+
+  MachineOperatorBuilder* machine = mcgraph()->machine();
+  for (MachineRepresentation rep :
+       {MachineRepresentation::kSimd128, MachineRepresentation::kWord64,
+        MachineRepresentation::kWord32, MachineRepresentation::kWord16,
+        MachineRepresentation::kWord8}) {
+    if (rep == MachineRepresentation::kSimd128 &&
+        (!CpuFeatures::SupportsWasmSimd128() || env_->lower_simd)) {
+      continue;
+    }
+    if (rep == MachineRepresentation::kWord64 && !machine->Is64()) continue;
+    if (rep != MachineRepresentation::kWord8 &&
+        (!machine->UnalignedLoadSupported(rep) ||
+         !machine->UnalignedStoreSupported(rep))) {
+      continue;
+    }
+    uint32_t rep_size = ElementSizeInBytes(rep);
+    for (; size_val >= rep_size; size_val -= rep_size) chunks->push_back(rep);
+  }
+  DCHECK_EQ(0u, size_val);
+  return true;
+}
+
+bool WasmGraphBuilder::TryInlineMemoryCopy(Node* dst, Node* src, Node* size,
+                                           wasm::WasmCodePosition position) {
+  base::SmallVector<MachineRepresentation, 8> chunks;
+  if (!GetInlineBulkMemoryChunks(size, &chunks)) return false;
+  uint8_t size_val = static_cast<uint8_t>(Uint32Matcher(size).ResolvedValue());
+
+  // Both ranges are checked before anything is written, and all chunks are
+  // loaded before the first one is stored, so that overlapping ranges are
+  // copied like with {memmove}.
+  src = BoundsCheckMem(size_val, src, 0, position, kNeedsBoundsCheck);
+  dst = BoundsCheckMem(size_val, dst, 0, position, kNeedsBoundsCheck);
+  base::SmallVector<Node*, 8> values;
+  uintptr_t offset = 0;
+  for (MachineRepresentation rep : chunks) {
+    if (rep == MachineRepresentation::kSimd128) has_simd_ = true;
+    values.push_back(
+        gasm_->Load(MachineType::TypeForRepresentation(rep), MemBuffer(offset),
+                    src));
+    offset += ElementSizeInBytes(rep);
+  }
+  offset = 0;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    gasm_->Store(StoreRepresentation(chunks[i], kNoWriteBarrier),
+                 MemBuffer(offset), dst, values[i]);
+    offset += ElementSizeInBytes(chunks[i]);
+  }
+  return true;
+}
+
+bool WasmGraphBuilder::TryInlineMemoryFill(Node* dst, Node* value, Node* size,
+                                           wasm::WasmCodePosition position) {
+  base::SmallVector<MachineRepresentation, 8> chunks;
+  if (!GetInlineBulkMemoryChunks(size, &chunks)) return false;
+  uint8_t size_val = static_cast<uint8_t>(Uint32Matcher(size).ResolvedValue());
+
+  dst = BoundsCheckMem(size_val, dst, 0, position, kNeedsBoundsCheck);
+  // Replicate the low byte of {value} into every byte of the stored values.
+  // Narrow stores only use the low bytes of {pattern32}.
+  Node* pattern32 =
+      gasm_->Int32Mul(gasm_->Word32And(value, Int32Constant(0xFF)),
+                      Int32Constant(0x01010101));
+  Node* pattern64 = nullptr;
+  Node* pattern128 = nullptr;
+  uintptr_t offset = 0;
+  for (MachineRepresentation rep : chunks) {
+    Node* chunk_value = pattern32;
+    if (rep == MachineRepresentation::kWord64) {
+      if (pattern64 == nullptr) {
+        Node* low = gasm_->ChangeUint32ToUint64(pattern32);
+        pattern64 = gasm_->Word64Or(
+            gasm_->Word64Shl(low, Int64Constant(32)), low);
+      }
+      chunk_value = pattern64;
+    } else if (rep == MachineRepresentation::kSimd128) {
+      has_simd_ = true;
+      if (pattern128 == nullptr) {
+        pattern128 =
+            graph()->NewNode(mcgraph()->machine()->I8x16Splat(), value);
+      }
+      chunk_value = pattern128;
+    }
+    gasm_->Store(StoreRepresentation(rep, kNoWriteBarrier), MemBuffer(offset),
+                 dst, chunk_value);
+    offset += ElementSizeInBytes(rep);
+  }
+  return true;
+}
+
 void WasmGraphBuilder::MemoryCopy(Node* dst, Node* src, Node* size,
                                   wasm::WasmCodePosition position) {
+  if (TryInlineMemoryCopy(dst, src, size, position)) return;
+
   Node* function =
       gasm_->ExternalConstant(ExternalReference::wasm_memory_copy());
 
@@ -5478,6 +5582,8 @@ void WasmGraphBuilder::MemoryCopy(Node* dst, Node* src, Node* size,
 
 void WasmGraphBuilder::MemoryFill(Node* dst, Node* value, Node* size,
                                   wasm::WasmCodePosition position) {
+  if (TryInlineMemoryFill(dst, value, size, position)) return;
+
   Node* function =
       gasm_->ExternalConstant(ExternalReference::wasm_memory_fill());
 
@@ -7758,6 +7864,7 @@ namespace {
 
 bool BuildGraphForWasmFunction(AccountingAllocator* allocator,
                                wasm::CompilationEnv* env,
+                               const wasm::WireBytesStorage* wire_bytes,
                                const wasm::FunctionBody& func_body,
                                int func_index, wasm::WasmFeatures* detected,
                                MachineGraph* mcgraph,
@@ -7779,6 +7886,17 @@ bool BuildGraphForWasmFunction(AccountingAllocator* allocator,
     return false;
   }
 
+  if (FLAG_wasm_inlining && wire_bytes != nullptr) {
+    TickCounter tick_counter;
+    GraphReducer graph_reducer(mcgraph->zone(), mcgraph->graph(),
+                               &tick_counter, nullptr, mcgraph->Dead());
+    WasmInliner inliner(&graph_reducer, env, wire_bytes, detected, mcgraph,
+                        source_positions, node_origins, loop_infos,
+                        func_index);
+    graph_reducer.AddReducer(&inliner);
+    graph_reducer.ReduceGraph();
+  }
+
   // Lower SIMD first, i64x2 nodes will be lowered to int64 nodes, then int64
   // lowering will take care of them.
   auto sig = CreateMachineSignature(mcgraph->zone(), func_body.sig,
@@ -7848,6 +7966,7 @@ Vector<const char> GetDebugName(Zone* zone, int index) {
 
 wasm::WasmCompilationResult ExecuteTurbofanWasmCompilation(
     wasm::WasmEngine* wasm_engine, wasm::CompilationEnv* env,
+    const wasm::WireBytesStorage* wire_bytes,
     const wasm::FunctionBody& func_body, int func_index, Counters* counters,
     wasm::WasmFeatures* detected) {
   TRACE_EVENT2(TRACE_DISABLED_BY_DEFAULT("v8.wasm.detailed"),
@@ -7880,9 +7999,9 @@ wasm::WasmCompilationResult ExecuteTurbofanWasmCompilation(
 
   std::vector<WasmLoopInfo> loop_infos;
 
-  if (!BuildGraphForWasmFunction(wasm_engine->allocator(), env, func_body,
-                                 func_index, detected, mcgraph, &loop_infos,
-                                 node_origins, source_positions)) {
+  if (!BuildGraphForWasmFunction(wasm_engine->allocator(), env, wire_bytes,
+                                 func_body, func_index, detected, mcgraph,
+                                 &loop_infos, node_origins, source_positions)) {
     return wasm::WasmCompilationResult{};
   }
 
@@ -59,8 +59,9 @@ enum class LoadTransformationKind : uint8_t;
 namespace compiler {
 
 wasm::WasmCompilationResult ExecuteTurbofanWasmCompilation(
-    wasm::WasmEngine*, wasm::CompilationEnv*, const wasm::FunctionBody&,
-    int func_index, Counters*, wasm::WasmFeatures* detected);
+    wasm::WasmEngine*, wasm::CompilationEnv*, const wasm::WireBytesStorage*,
+    const wasm::FunctionBody&, int func_index, Counters*,
+    wasm::WasmFeatures* detected);
 
 // Calls to Wasm imports are handled in several different ways, depending on the
 // type of the target function/callable and whether the signature matches the
@@ -529,6 +530,16 @@ class WasmGraphBuilder {
   Node* CheckBoundsAndAlignment(int8_t access_size, Node* index,
                                 uint64_t offset, wasm::WasmCodePosition);
 
+  // Small memory.copy and memory.fill operations with a constant {size} are
+  // emitted as a sequence of loads and stores instead of a C call. Returns
+  // false if {size} is not suitable.
+  bool GetInlineBulkMemoryChunks(
+      Node* size, base::SmallVector<MachineRepresentation, 8>* chunks);
+  bool TryInlineMemoryCopy(Node* dst, Node* src, Node* size,
+                           wasm::WasmCodePosition position);
+  bool TryInlineMemoryFill(Node* dst, Node* value, Node* size,
+                           wasm::WasmCodePosition position);
+
   Node* Uint32ToUintptr(Node*);
   const Operator* GetSafeLoadOperator(int offset, wasm::ValueType type);
   const Operator* GetSafeStoreOperator(int offset, wasm::ValueType type);
@@ -0,0 +1,214 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/wasm-inlining.h"
+
+#include "src/codegen/cpu-features.h"
+#include "src/compiler/all-nodes.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/compiler-source-position-table.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/wasm-compiler.h"
+#include "src/wasm/graph-builder-interface.h"
+#include "src/wasm/wasm-features.h"
+#include "src/wasm/wasm-module.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+Reduction WasmInliner::Reduce(Node* node) {
+  if (node->opcode() == IrOpcode::kCall) return ReduceCall(node);
+  return NoChange();
+}
+
+int WasmInliner::GetCalleeIndex(Node* call) const {
+  Node* callee = NodeProperties::GetValueInput(call, 0);
+  IrOpcode::Value reloc_opcode = mcgraph()->machine()->Is32()
+                                     ? IrOpcode::kRelocatableInt32Constant
+                                     : IrOpcode::kRelocatableInt64Constant;
+  if (callee->opcode() != reloc_opcode) return -1;
+  auto info = OpParameter<RelocatablePtrConstantInfo>(callee->op());
+  if (info.rmode() != RelocInfo::WASM_CALL) return -1;
+  // Direct calls encode the index of the callee, see
+  // {WasmGraphBuilder::CallDirect}.
+  return static_cast<int>(info.value());
+}
+
+Reduction WasmInliner::ReduceCall(Node* call) {
+  int index = GetCalleeIndex(call);
+  if (index < 0) return NoChange();
+  uint32_t callee_index = static_cast<uint32_t>(index);
+  const wasm::WasmModule* module = env_->module;
+  CHECK_LT(callee_index, module->functions.size());
+  const wasm::WasmFunction* callee = &module->functions[callee_index];
+  DCHECK(!callee->imported);
+
+  if (callee_index == function_index_) return NoChange();
+  // The handler of an exceptional call would have to be connected to every
+  // throwing node of the callee; leave those calls alone.
+  if (NodeProperties::IsExceptionalCall(call)) return NoChange();
+  int size = static_cast<int>(callee->code.length());
+  if (size > FLAG_wasm_inlining_max_size) return NoChange();
+  if (inlined_bytes_ + size > FLAG_wasm_inlining_budget) return NoChange();
+
+  Vector<const byte> bytes = wire_bytes_->GetCode(callee->code);
+  const wasm::FunctionBody body(callee->sig, callee->code.offset(),
+                                bytes.begin(), bytes.end());
+  WasmGraphBuilder builder(env_, zone(), mcgraph(), body.sig,
+                           source_positions_);
+  std::vector<WasmLoopInfo> loop_infos;
+  NodeId first_callee_node = static_cast<NodeId>(graph()->NodeCount());
+  Node* callee_start;
+  Node* callee_end;
+  wasm::DecodeResult result;
+  {
+    Graph::SubgraphScope scope(graph());
+    graph()->SetEnd(nullptr);
+    result = wasm::BuildTFGraph(zone()->allocator(), env_->enabled_features,
+                                module, &builder, detected_, body, &loop_infos,
+                                node_origins_);
+    callee_start = graph()->start();
+    callee_end = graph()->end();
+  }
+  // The callee graph is not connected to the caller yet, so bailing out below
+  // leaves it unreachable.
+  if (result.failed() || callee_end == nullptr) return NoChange();
+  if (builder.has_simd() &&
+      (!CpuFeatures::SupportsWasmSimd128() || env_->lower_simd)) {
+    return NoChange();
+  }
+  for (Node* input : callee_end->inputs()) {
+    switch (input->opcode()) {
+      case IrOpcode::kReturn:
+      case IrOpcode::kThrow:
+      case IrOpcode::kTerminate:
+        break;
+      default:
+        // Tail calls would have to be turned into regular calls.
+        return NoChange();
+    }
+  }
+
+  // Traps and calls in the callee are attributed to the inlined call, so that
+  // stack traces point into the function being compiled.
+  if (source_positions_ != nullptr) {
+    SourcePosition position = source_positions_->GetSourcePosition(call);
+    Zone temp_zone(zone()->allocator(), ZONE_NAME);
+    AllNodes callee_nodes(&temp_zone, callee_end, graph());
+    for (Node* node : callee_nodes.reachable) {
+      if (node->id() < first_callee_node) continue;
+      if (!source_positions_->GetSourcePosition(node).IsKnown()) continue;
+      source_positions_->SetSourcePosition(node, position);
+    }
+  }
+
+  if (FLAG_trace_wasm_inlining) {
+    PrintF("[function %u: inlining call to function %u (%d bytes)]\n",
+           function_index_, callee_index, size);
+  }
+  inlined_bytes_ += size;
+  loop_infos_->insert(loop_infos_->end(), loop_infos.begin(),
+                      loop_infos.end());
+  return InlineCall(call, callee_start, callee_end, callee_index);
+}
+
+Reduction WasmInliner::InlineCall(Node* call, Node* callee_start,
+                                  Node* callee_end, uint32_t callee_index) {
+  DCHECK_EQ(IrOpcode::kCall, call->opcode());
+
+  // Rewire the function entry: parameters become the call's arguments, and
+  // the callee starts at the call's effect and control.
+  for (Edge edge : callee_start->use_edges()) {
+    Node* use = edge.from();
+    if (use->opcode() == IrOpcode::kParameter) {
+      // Value input 0 of the call is the target, followed by the instance,
+      // which is parameter 0 of the callee.
+      int index = 1 + ParameterIndexOf(use->op());
+      Replace(use, NodeProperties::GetValueInput(call, index));
+    } else if (NodeProperties::IsEffectEdge(edge)) {
+      edge.UpdateTo(NodeProperties::GetEffectInput(call));
+    } else {
+      DCHECK(NodeProperties::IsControlEdge(edge));
+      edge.UpdateTo(NodeProperties::GetControlInput(call));
+    }
+  }
+
+  // Rewire the function exit: throws and loop terminators go to the caller's
+  // end, returns are merged into the continuation of the call.
+  NodeVector returns(zone());
+  for (Node* input : callee_end->inputs()) {
+    if (input->opcode() == IrOpcode::kReturn) {
+      returns.push_back(input);
+    } else {
+      NodeProperties::MergeControlToEnd(graph(), common(), input);
+      Revisit(graph()->end());
+    }
+  }
+  callee_end->Kill();
+
+  if (returns.empty()) {
+    // The callee never returns, so the call and its uses are dead.
+    ReplaceWithValue(call, mcgraph()->Dead(), mcgraph()->Dead(),
+                     mcgraph()->Dead());
+    return Changed(call);
+  }
+
+  int return_count = static_cast<int>(returns.size());
+  NodeVector controls(zone());
+  NodeVector effects(zone());
+  for (Node* ret : returns) {
+    controls.push_back(NodeProperties::GetControlInput(ret));
+    effects.push_back(NodeProperties::GetEffectInput(ret));
+  }
+  Node* control = return_count == 1
+                      ? controls[0]
+                      : graph()->NewNode(common()->Merge(return_count),
+                                         return_count, controls.data());
+  Node* effect = effects[0];
+  if (return_count > 1) {
+    effects.push_back(control);
+    effect = graph()->NewNode(common()->EffectPhi(return_count),
+                              static_cast<int>(effects.size()),
+                              effects.data());
+  }
+
+  // Value input 0 of a return is the number of stack slots to pop.
+  const wasm::FunctionSig* sig = env_->module->functions[callee_index].sig;
+  NodeVector values(zone());
+  for (size_t i = 0; i < sig->return_count(); i++) {
+    int value_index = static_cast<int>(i) + 1;
+    if (return_count == 1) {
+      values.push_back(NodeProperties::GetValueInput(returns[0], value_index));
+      continue;
+    }
+    NodeVector inputs(zone());
+    for (Node* ret : returns) {
+      inputs.push_back(NodeProperties::GetValueInput(ret, value_index));
+    }
+    inputs.push_back(control);
+    MachineRepresentation rep = sig->GetReturn(i).machine_representation();
+    values.push_back(graph()->NewNode(common()->Phi(rep, return_count),
+                                      static_cast<int>(inputs.size()),
+                                      inputs.data()));
+  }
+  for (Node* ret : returns) ret->Kill();
+
+  if (values.size() > 1) {
+    // Multiple return values are used through projections of the call.
+    for (Edge edge : call->use_edges()) {
+      if (!NodeProperties::IsValueEdge(edge)) continue;
+      Node* projection = edge.from();
+      DCHECK_EQ(IrOpcode::kProjection, projection->opcode());
+      ReplaceWithValue(projection, values[ProjectionIndexOf(projection->op())]);
+    }
+  }
+  Node* value = values.size() == 1 ? values[0] : mcgraph()->Dead();
+  ReplaceWithValue(call, value, effect, control);
+  return Replace(value);
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,93 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !V8_ENABLE_WEBASSEMBLY
+#error This header should only be included if WebAssembly is enabled.
+#endif  // !V8_ENABLE_WEBASSEMBLY
+
+#ifndef V8_COMPILER_WASM_INLINING_H_
+#define V8_COMPILER_WASM_INLINING_H_
+
+#include <vector>
+
+#include "src/compiler/graph-reducer.h"
+#include "src/compiler/machine-graph.h"
+
+namespace v8 {
+namespace internal {
+
+namespace wasm {
+struct CompilationEnv;
+class WasmFeatures;
+class WireBytesStorage;
+}  // namespace wasm
+
+namespace compiler {
+
+class NodeOriginTable;
+class SourcePositionTable;
+struct WasmLoopInfo;
+
+// The WasmInliner replaces direct calls to small functions of the same module
+// by the graph of the callee. The callee graph is built by the regular
+// WasmGraphBuilder into the caller's graph and then spliced in place of the
+// call: its parameters are replaced by the call arguments (the caller's
+// instance included), and its returns are merged into the call's uses.
+//
+// Calls are only inlined if they have no exception handler, the callee is not
+// the function being compiled, its body is at most
+// --wasm-inlining-max-size bytes, and the total size inlined into the
+// function stays within --wasm-inlining-budget. Callees that contain tail
+// calls, or SIMD that would need to be lowered, are not inlined.
+class WasmInliner final : public AdvancedReducer {
+ public:
+  WasmInliner(Editor* editor, wasm::CompilationEnv* env,
+              const wasm::WireBytesStorage* wire_bytes,
+              wasm::WasmFeatures* detected, MachineGraph* mcgraph,
+              SourcePositionTable* source_positions,
+              NodeOriginTable* node_origins,
+              std::vector<WasmLoopInfo>* loop_infos, uint32_t function_index)
+      : AdvancedReducer(editor),
+        env_(env),
+        wire_bytes_(wire_bytes),
+        detected_(detected),
+        mcgraph_(mcgraph),
+        source_positions_(source_positions),
+        node_origins_(node_origins),
+        loop_infos_(loop_infos),
+        function_index_(function_index) {}
+
+  const char* reducer_name() const override { return "WasmInliner"; }
+
+  Reduction Reduce(Node* node) final;
+
+ private:
+  Zone* zone() const { return mcgraph_->zone(); }
+  CommonOperatorBuilder* common() const { return mcgraph_->common(); }
+  Graph* graph() const { return mcgraph_->graph(); }
+  MachineGraph* mcgraph() const { return mcgraph_; }
+
+  Reduction ReduceCall(Node* call);
+  Reduction InlineCall(Node* call, Node* callee_start, Node* callee_end,
+                       uint32_t callee_index);
+
+  // Returns the index of the function called directly by {call}, or -1.
+  int GetCalleeIndex(Node* call) const;
+
+  wasm::CompilationEnv* const env_;
+  const wasm::WireBytesStorage* const wire_bytes_;
+  wasm::WasmFeatures* const detected_;
+  MachineGraph* const mcgraph_;
+  SourcePositionTable* const source_positions_;
+  NodeOriginTable* const node_origins_;
+  std::vector<WasmLoopInfo>* const loop_infos_;
+  const uint32_t function_index_;
+  int inlined_bytes_ = 0;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_WASM_INLINING_H_
@@ -4151,14 +4151,13 @@ int Shell::RunMain(Isolate* isolate, bool last_run) {
     }
     WriteLcovData(isolate, options.lcov_file);
     if (last_run && options.stress_snapshot) {
-      static constexpr bool kClearRecompilableData = true;
       i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
       i::Handle<i::Context> i_context = Utils::OpenHandle(*context);
       // TODO(jgruber,v8:10500): Don't deoptimize once we support serialization
       // of optimized code.
       i::Deoptimizer::DeoptimizeAll(i_isolate);
       i::Snapshot::ClearReconstructableDataForSerialization(
-          i_isolate, kClearRecompilableData);
+          i_isolate, v8::SnapshotCreator::FunctionCodeHandling::kClear);
       i::Snapshot::SerializeDeserializeAndVerifyForTesting(i_isolate,
                                                            i_context);
     }
@@ -1591,6 +1591,12 @@ TranslatedValue Deoptimizer::TranslatedValueForWasmReturnKind(
         return TranslatedValue::NewDouble(
             &translated_state_,
             input_->GetDoubleRegister(wasm::kFpReturnRegisters[0].code()));
+      case wasm::kOptRef:
+        // Externref values are returned to JavaScript unchanged.
+        return TranslatedValue::NewTagged(
+            &translated_state_,
+            Object(static_cast<Address>(
+                input_->GetRegister(kReturnRegister0.code()))));
       default:
         UNREACHABLE();
     }
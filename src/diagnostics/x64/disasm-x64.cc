@@ -1079,6 +1079,11 @@ int DisassemblerX64::AVXInstruction(byte* data) {
         AppendToBuffer(",%s", NameOfXMMRegister((*current++) >> 4));
         break;
       }
+      case 0x38:
+        AppendToBuffer("vinserti128 ymm%d,ymm%d,", regop, vvvv);
+        current += PrintRightXMMOperand(current);
+        AppendToBuffer(",0x%x", *current++);
+        break;
       default:
         UnimplementedInstruction();
     }
@@ -1460,6 +1465,9 @@ int DisassemblerX64::AVXInstruction(byte* data) {
         AppendToBuffer(",0x%x", *current++);
         break;
       }
+      case 0x77:
+        AppendToBuffer("vzeroupper");
+        break;
 #define SSE_UNOP_CASE(instruction, unused, code)                       \
   case 0x##code:                                                       \
     AppendToBuffer("v" #instruction " %s,", NameOfXMMRegister(regop)); \
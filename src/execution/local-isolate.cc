@@ -39,6 +39,13 @@ bool LocalIsolate::is_collecting_type_profile() const {
   return isolate_->is_collecting_type_profile();
 }
 
+void LocalIsolate::RegisterDeserializerStarted() {
+  isolate_->RegisterDeserializerStarted();
+}
+void LocalIsolate::RegisterDeserializerFinished() {
+  isolate_->RegisterDeserializerFinished();
+}
+
 // static
 bool StackLimitCheck::HasOverflowed(LocalIsolate* local_isolate) {
   return GetCurrentStackPosition() < local_isolate->stack_limit();
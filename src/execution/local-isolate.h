@@ -53,6 +53,7 @@ class V8_EXPORT_PRIVATE LocalIsolate final : private HiddenLocalFactory {
   inline Address isolate_root() const;
   inline ReadOnlyHeap* read_only_heap() const;
   inline Object root(RootIndex index) const;
+  inline Handle<Object> root_handle(RootIndex index) const;
 
   StringTable* string_table() const { return isolate_->string_table(); }
   base::SharedMutex* internalized_string_access() {
@@ -83,6 +84,10 @@ class V8_EXPORT_PRIVATE LocalIsolate final : private HiddenLocalFactory {
 
   bool is_collecting_type_profile() const;
 
+  // See Isolate::RegisterDeserializerStarted.
+  void RegisterDeserializerStarted();
+  void RegisterDeserializerFinished();
+
   LocalLogger* logger() const { return logger_.get(); }
   ThreadId thread_id() const { return thread_id_; }
   Address stack_limit() const { return stack_limit_; }
@@ -92,6 +97,10 @@ class V8_EXPORT_PRIVATE LocalIsolate final : private HiddenLocalFactory {
 
   LocalIsolate* AsLocalIsolate() { return this; }
 
+  // Only for accessing main thread state that is immutable once the isolate
+  // is set up, such as the external reference table or the builtins.
+  Isolate* GetMainThreadIsolateUnsafe() const { return isolate_; }
+
  private:
   friend class v8::internal::LocalFactory;
 
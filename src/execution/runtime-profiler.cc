@@ -61,9 +61,10 @@ static const int kMidTierGlobalTicksScaleFactor = 100;
 // tierup.
 static const int kMaxAdditionalMidTierGlobalTicks = 10;
 
-#define OPTIMIZATION_REASON_LIST(V)   \
-  V(DoNotOptimize, "do not optimize") \
-  V(HotAndStable, "hot and stable")   \
+#define OPTIMIZATION_REASON_LIST(V)                \
+  V(DoNotOptimize, "do not optimize")              \
+  V(HotAndStable, "hot and stable")                \
+  V(HotInTieringProfile, "hot in tiering profile") \
   V(SmallFunction, "small function")
 
 enum class OptimizationReason : uint8_t {
@@ -140,6 +141,11 @@ void RuntimeProfiler::Optimize(JSFunction function, OptimizationReason reason,
                                CodeKind code_kind) {
   DCHECK_NE(reason, OptimizationReason::kDoNotOptimize);
   TraceRecompile(function, reason, code_kind, isolate_);
+  if (reason == OptimizationReason::kHotInTieringProfile) {
+    // The profile hint is only used once; if the optimized code deopts, the
+    // function has to earn its next optimization through ticks as usual.
+    function.shared().set_hot_in_tiering_profile(false);
+  }
   function.MarkForOptimization(ConcurrencyMode::kConcurrent);
 }
 
@@ -285,6 +291,11 @@ OptimizationReason RuntimeProfiler::ShouldOptimize(JSFunction function,
   }
   if (ticks >= ticks_for_optimization) {
     return OptimizationReason::kHotAndStable;
+  } else if (!FLAG_turboprop && ticks > 0 &&
+             function.shared().hot_in_tiering_profile()) {
+    // A previous run of this script recorded the function as optimized, so
+    // optimize it as soon as it has gathered one budget's worth of feedback.
+    return OptimizationReason::kHotInTieringProfile;
   } else if (ShouldOptimizeAsSmallFunction(bytecode.length(), ticks,
                                            any_ic_changed_,
                                            active_tier_is_turboprop)) {
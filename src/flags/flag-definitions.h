@@ -776,6 +776,8 @@ DEFINE_BOOL(turbo_move_optimization, true, "optimize gap moves in TurboFan")
 DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_loop_peeling, true, "Turbofan loop peeling")
 DEFINE_BOOL(turbo_loop_variable, true, "Turbofan loop variable optimization")
+DEFINE_BOOL(turbo_bounds_check_elimination, true,
+            "use loop conditions to remove redundant bounds checks in TurboFan")
 DEFINE_BOOL(turbo_loop_rotation, true, "Turbofan loop rotation")
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_escape, true, "enable escape analysis")
@@ -802,7 +804,8 @@ DEFINE_BOOL(turbo_dynamic_map_checks, true,
             "if all handlers in an IC are the same for turboprop and NCI")
 DEFINE_BOOL(turbo_compress_translation_arrays, false,
             "compress translation arrays (experimental)")
-DEFINE_BOOL(turbo_inline_js_wasm_calls, false, "inline JS->Wasm calls")
+DEFINE_BOOL(turbo_inline_js_wasm_calls, false,
+            "inline JS->Wasm calls into optimized JavaScript code")
 
 // Native context independent (NCI) code.
 DEFINE_BOOL(turbo_nci, false,
@@ -812,6 +815,9 @@ DEFINE_BOOL(turbo_nci, false,
 DEFINE_IMPLICATION(turbo_nci, turbo_collect_feedback_in_generic_lowering)
 DEFINE_BOOL(print_nci_code, false, "print native context independent code.")
 DEFINE_BOOL(trace_turbo_nci, false, "trace native context independent code.")
+DEFINE_BOOL(turbo_nci_code_cache, false,
+            "include native context independent code in the code cache.")
+DEFINE_IMPLICATION(turbo_nci_code_cache, turbo_nci)
 DEFINE_BOOL(turbo_collect_feedback_in_generic_lowering, true,
             "enable experimental feedback collection in generic lowering.")
 // TODO(jgruber,v8:8888): Remove this flag once we've settled on an ageing
@@ -866,6 +872,15 @@ DEFINE_BOOL(wasm_tier_up, true,
             "have an effect)")
 DEFINE_BOOL(wasm_dynamic_tiering, false,
             "enable dynamic tier up to the optimizing compiler")
+DEFINE_INT(wasm_tiering_budget, 64,
+           "number of calls to a Liftoff function before it is tiered up by "
+           "--wasm-dynamic-tiering (rounded up to a power of two)")
+DEFINE_INT(wasm_tiering_batch_size, 8,
+           "number of functions that --wasm-dynamic-tiering collects before "
+           "handing them to background compilation")
+DEFINE_INT(wasm_caching_threshold, 1000000,
+           "size of code (in bytes) tiered up by --wasm-dynamic-tiering after "
+           "which a module is cached again")
 DEFINE_DEBUG_BOOL(trace_wasm_decoder, false, "trace decoding of wasm code")
 DEFINE_DEBUG_BOOL(trace_wasm_compiler, false, "trace compiling of wasm code")
 DEFINE_DEBUG_BOOL(trace_wasm_interpreter, false,
@@ -944,9 +959,19 @@ DEFINE_BOOL(wasm_stack_checks, true,
             "enable stack checks (disable for performance testing only)")
 DEFINE_BOOL(wasm_math_intrinsics, true,
             "intrinsify some Math imports into wasm")
+DEFINE_UINT(wasm_inline_bulk_memory_max_size, 64,
+            "maximum constant size in bytes of memory.copy and memory.fill to "
+            "emit inline instead of calling into C (at most 255)")
 
 DEFINE_BOOL(wasm_loop_unrolling, false,
             "enable loop unrolling for wasm functions (experimental)")
+DEFINE_BOOL(wasm_inlining, false,
+            "enable inlining of direct wasm calls in TurboFan (experimental)")
+DEFINE_INT(wasm_inlining_max_size, 100,
+           "maximum body size in bytes of a wasm function to be inlined")
+DEFINE_INT(wasm_inlining_budget, 1000,
+           "maximum total body size in bytes inlined into one wasm function")
+DEFINE_DEBUG_BOOL(trace_wasm_inlining, false, "trace wasm function inlining")
 DEFINE_BOOL(wasm_trap_handler, true,
             "use signal handlers to catch out of bounds memory access in wasm"
             " (currently Linux x86_64 only)")
@@ -966,9 +991,17 @@ DEFINE_DEBUG_BOOL(trace_wasm_lazy_compilation, false,
                   "trace lazy compilation of wasm functions")
 DEFINE_BOOL(wasm_lazy_validation, false,
             "enable lazy validation for lazily compiled wasm functions")
+DEFINE_BOOL(wasm_parallel_validation, true,
+            "validate lazily compiled wasm functions on multiple threads")
 DEFINE_BOOL(wasm_simd_ssse3_codegen, false, "allow wasm SIMD SSSE3 codegen")
+DEFINE_BOOL(wasm_simd_revectorize, false,
+            "combine adjacent wasm SIMD operations on memory into 256-bit "
+            "operations (x64 with AVX2 only)")
 
 DEFINE_BOOL(wasm_code_gc, true, "enable garbage collection of wasm code")
+DEFINE_STRING(wasm_code_cache_dir, nullptr,
+              "directory of a persistent cache of compiled wasm modules, "
+              "used by asynchronous and streaming compilation")
 DEFINE_BOOL(trace_wasm_code_gc, false, "trace garbage collection of wasm code")
 DEFINE_BOOL(stress_wasm_code_gc, false,
             "stress test garbage collection of wasm code")
@@ -1303,6 +1336,18 @@ DEFINE_BOOL(
 // TODO(leszeks): Parallel compile tasks currently don't support off-thread
 // finalization.
 DEFINE_NEG_IMPLICATION(parallel_compile_tasks, finalize_streaming_on_background)
+DEFINE_BOOL(parallel_streaming_compile, false,
+            "compile the eager inner functions of streamed scripts in "
+            "parallel on worker threads")
+// Parallel streaming compile finalizes all functions together on the main
+// thread.
+DEFINE_NEG_IMPLICATION(parallel_streaming_compile,
+                       finalize_streaming_on_background)
+DEFINE_BOOL(concurrent_cache_deserialization, true,
+            "enable deserializing code caches on background")
+DEFINE_BOOL(record_called_functions, false,
+            "record which functions have been called, for tiering profiles and "
+            "compile hints")
 DEFINE_BOOL(disable_old_api_accessors, false,
             "Disable old-style API accessors whose setters trigger through the "
             "prototype chain")
@@ -1571,6 +1616,19 @@ DEFINE_BOOL(profile_deserialization, false,
             "Print the time it takes to deserialize the snapshot.")
 DEFINE_BOOL(serialization_statistics, false,
             "Collect statistics on serialized objects.")
+DEFINE_BOOL(snapshot_compression_lz, false,
+            "compress the snapshot with the LZ codec, which decompresses "
+            "faster than zlib at the cost of a larger snapshot")
+DEFINE_UINT(snapshot_compression_chunk_size, 256,
+            "size in KB of the independently compressed chunks of the "
+            "snapshot (0 for a single chunk)")
+DEFINE_BOOL(parallel_snapshot_decompression, true,
+            "decompress snapshot chunks in parallel on worker threads")
+DEFINE_STRING(read_only_space_file, nullptr,
+              "map the shared read-only space from this file, which is "
+              "created from the snapshot if it is missing or out of date "
+              "(requires a shared read-only heap with pointer compression "
+              "and a fixed --hash-seed)")
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
 DEFINE_BOOL(regexp_mode_modifiers, false, "enable inline flags in regexp.")
@@ -1977,6 +2035,8 @@ DEFINE_BOOL(single_threaded, false, "disable the use of background tasks")
 DEFINE_IMPLICATION(single_threaded, single_threaded_gc)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(single_threaded, compiler_dispatcher)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_streaming_compile)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_snapshot_decompression)
 DEFINE_NEG_IMPLICATION(single_threaded, stress_concurrent_inlining)
 
 //
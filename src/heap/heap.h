@@ -2383,6 +2383,7 @@ class Heap {
 
   // The allocator interface.
   friend class Factory;
+  template <typename IsolateT>
   friend class Deserializer;
 
   // The Isolate constructs us.
@@ -2436,6 +2437,7 @@ class V8_NODISCARD AlwaysAllocateScope {
 
  private:
   friend class AlwaysAllocateScopeForTesting;
+  template <typename IsolateT>
   friend class Deserializer;
   friend class DeserializerAllocator;
   friend class Evacuator;
@@ -355,7 +355,8 @@ bool NativeContextInferrer::InferForJSFunction(Isolate* isolate,
                                                                     function);
   // The context may be a smi during deserialization.
   if (maybe_context.IsSmi()) {
-    DCHECK_EQ(maybe_context, Deserializer::uninitialized_field_value());
+    DCHECK_EQ(maybe_context,
+              Deserializer<Isolate>::uninitialized_field_value());
     return false;
   }
   if (!maybe_context.IsContext()) {
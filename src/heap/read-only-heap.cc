@@ -10,6 +10,7 @@
 #include "src/base/lazy-instance.h"
 #include "src/base/platform/mutex.h"
 #include "src/common/ptr-compr-inl.h"
+#include "src/flags/flags.h"
 #include "src/heap/basic-memory-chunk.h"
 #include "src/heap/heap-write-barrier-inl.h"
 #include "src/heap/memory-chunk.h"
@@ -19,6 +20,7 @@
 #include "src/objects/objects-inl.h"
 #include "src/objects/smi.h"
 #include "src/snapshot/read-only-deserializer.h"
+#include "src/snapshot/snapshot.h"
 #include "src/utils/allocation.h"
 
 namespace v8 {
@@ -45,6 +47,35 @@ std::shared_ptr<ReadOnlyArtifacts> InitializeSharedReadOnlyArtifacts() {
   *read_only_artifacts_.Pointer() = artifacts;
   return artifacts;
 }
+
+// With --read-only-space-file, the read-only space is mapped from the given
+// file instead of being deserialized. The file is only usable when the pages
+// are remapped into each Isolate's pointer compression cage, since the page
+// contents then only depend on the cage offsets of the pages. The hash seed
+// lives in the read-only space, so a file is only used with a fixed
+// --hash-seed; otherwise every process would share the seed of the process
+// that wrote the file. The flag hash in the file's header covers the seed.
+bool CanUseReadOnlySpaceFile(Isolate* isolate) {
+  return FLAG_read_only_space_file != nullptr && COMPRESS_POINTERS_BOOL &&
+         FLAG_hash_seed != 0 && isolate->snapshot_blob() != nullptr;
+}
+
+bool InitializeArtifactsFromFile(Isolate* isolate,
+                                 std::shared_ptr<ReadOnlyArtifacts> artifacts) {
+  if (!CanUseReadOnlySpaceFile(isolate)) return false;
+  return static_cast<PointerCompressedReadOnlyArtifacts*>(artifacts.get())
+      ->InitializeFromFile(
+          isolate, FLAG_read_only_space_file,
+          Snapshot::GetExpectedChecksum(isolate->snapshot_blob()));
+}
+
+void WriteArtifactsToFile(Isolate* isolate,
+                          std::shared_ptr<ReadOnlyArtifacts> artifacts) {
+  if (!CanUseReadOnlySpaceFile(isolate)) return;
+  static_cast<PointerCompressedReadOnlyArtifacts*>(artifacts.get())
+      ->WriteToFile(FLAG_read_only_space_file,
+                    Snapshot::GetExpectedChecksum(isolate->snapshot_blob()));
+}
 }  // namespace
 
 bool ReadOnlyHeap::IsSharedMemoryAvailable() {
@@ -75,10 +106,16 @@ void ReadOnlyHeap::SetUp(Isolate* isolate,
       if (!artifacts) {
         artifacts = InitializeSharedReadOnlyArtifacts();
         artifacts->InitializeChecksum(read_only_snapshot_data);
-        ro_heap = CreateInitalHeapForBootstrapping(isolate, artifacts);
-        ro_heap->DeseralizeIntoIsolate(isolate, read_only_snapshot_data,
-                                       can_rehash);
-        read_only_heap_created = true;
+        if (InitializeArtifactsFromFile(isolate, artifacts)) {
+          ro_heap = artifacts->GetReadOnlyHeapForIsolate(isolate);
+          isolate->SetUpFromReadOnlyArtifacts(artifacts, ro_heap);
+        } else {
+          ro_heap = CreateInitalHeapForBootstrapping(isolate, artifacts);
+          ro_heap->DeseralizeIntoIsolate(isolate, read_only_snapshot_data,
+                                         can_rehash);
+          read_only_heap_created = true;
+          WriteArtifactsToFile(isolate, artifacts);
+        }
       } else {
         // With pointer compression, there is one ReadOnlyHeap per Isolate.
         // Without PC, there is only one shared between all Isolates.
@@ -4,14 +4,23 @@
 
 #include "src/heap/read-only-spaces.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "include/v8-internal.h"
 #include "include/v8-platform.h"
+#include "src/base/lazy-instance.h"
 #include "src/base/logging.h"
+#include "src/base/page-allocator.h"
+#include "src/base/platform/platform.h"
 #include "src/common/globals.h"
 #include "src/common/ptr-compr-inl.h"
 #include "src/execution/isolate.h"
+#include "src/flags/flags.h"
 #include "src/heap/allocation-stats.h"
 #include "src/heap/basic-memory-chunk.h"
 #include "src/heap/combined-heap.h"
@@ -23,6 +32,7 @@
 #include "src/objects/property-details.h"
 #include "src/objects/string.h"
 #include "src/snapshot/read-only-deserializer.h"
+#include "src/utils/version.h"
 
 namespace v8 {
 namespace internal {
@@ -267,6 +277,245 @@ void PointerCompressedReadOnlyArtifacts::VerifyHeapAndSpaceRelationships(
             isolate->heap()->read_only_space());
 }
 
+namespace {
+
+// A read-only space file starts with a header of uint32_t-sized entries:
+//   magic number, version hash, flag hash, read-only snapshot checksum,
+//   capacity, page count, object cache length,
+//   followed by (offset, size) for each page, the read-only roots and the
+//   read-only object cache.
+// Page offsets, roots and cache entries are offsets from the cage base. Page
+// contents follow the header, each at an offset aligned to the allocation page
+// size, so that it can be mapped directly.
+constexpr uint32_t kReadOnlySpaceFileMagic = 0x524F5346;  // "ROSF"
+
+enum ReadOnlySpaceFileHeader {
+  kMagicIndex,
+  kVersionHashIndex,
+  kFlagHashIndex,
+  kChecksumIndex,
+  kCapacityIndex,
+  kPageCountIndex,
+  kObjectCacheLengthIndex,
+  kReadOnlySpaceFileHeaderSize
+};
+
+// Upper bounds that reject corrupt headers before they are used to size
+// allocations.
+constexpr uint32_t kMaxReadOnlySpaceFilePages = 1024;
+constexpr uint32_t kMaxReadOnlyObjectCacheLength = 1 << 20;
+
+// Files are mapped with the default platform allocator, since mapping files is
+// not part of the embedder-provided v8::PageAllocator interface.
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(base::PageAllocator, FilePageAllocator)
+
+bool ReadWords(FILE* file, uint32_t* words, size_t count) {
+  return fread(words, kUInt32Size, count, file) == count;
+}
+
+bool WriteZeros(FILE* file, size_t count) {
+  static const byte kZeros[256] = {0};
+  while (count > 0) {
+    size_t chunk = std::min(count, sizeof(kZeros));
+    if (fwrite(kZeros, 1, chunk, file) != chunk) return false;
+    count -= chunk;
+  }
+  return true;
+}
+
+// Checks that every page would be mapped inside the pointer compression cage,
+// behind the Isolate at its start, at an offset that the cage's page allocator
+// can hand out, and without overlapping another page. Roots must be heap
+// objects inside one of the pages, cache entries either that or Smis.
+bool ValidateCageOffsets(Isolate* isolate,
+                         const std::vector<uint32_t>& page_entries,
+                         const std::vector<uint32_t>& roots,
+                         const std::vector<uint32_t>& object_cache) {
+  const size_t cage_page_size = isolate->heap()
+                                    ->memory_allocator()
+                                    ->data_page_allocator()
+                                    ->AllocatePageSize();
+  const Address isolate_end =
+      reinterpret_cast<Address>(isolate) + sizeof(Isolate);
+  const size_t min_offset =
+      RoundUp(isolate_end - isolate->isolate_root(), cage_page_size);
+
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (size_t i = 0; i < page_entries.size(); i += 2) {
+    size_t start = page_entries[i];
+    size_t end = start + page_entries[i + 1];
+    if (start % cage_page_size != 0 || start < min_offset ||
+        end > kPtrComprHeapReservationSize) {
+      return false;
+    }
+    ranges.emplace_back(start, end);
+  }
+  std::sort(ranges.begin(), ranges.end());
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    if (ranges[i].first < ranges[i - 1].second) return false;
+  }
+
+  auto is_object_in_pages = [&ranges](uint32_t entry) {
+    if ((entry & kHeapObjectTagMask) != kHeapObjectTag) return false;
+    return std::any_of(ranges.begin(), ranges.end(),
+                       [entry](const std::pair<size_t, size_t>& range) {
+                         return entry >= range.first && entry < range.second;
+                       });
+  };
+  for (uint32_t root : roots) {
+    if (!is_object_in_pages(root)) return false;
+  }
+  for (uint32_t entry : object_cache) {
+    if ((entry & kSmiTagMask) != kSmiTag && !is_object_in_pages(entry)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool PointerCompressedReadOnlyArtifacts::InitializeFromFile(
+    Isolate* isolate, const char* file_name, uint32_t snapshot_checksum) {
+  DCHECK(ReadOnlyHeap::IsReadOnlySpaceShared());
+  DCHECK(pages_.empty());
+
+  FILE* file = base::OS::FOpen(file_name, "rb");
+  if (file == nullptr) return false;
+
+  // Read and check everything before mapping, so that a file written for a
+  // different build or snapshot is simply ignored.
+  uint32_t header[kReadOnlySpaceFileHeaderSize];
+  std::vector<uint32_t> page_entries;
+  std::vector<uint32_t> roots(kReadOnlyRootsCount);
+  std::vector<uint32_t> object_cache;
+  bool valid =
+      ReadWords(file, header, kReadOnlySpaceFileHeaderSize) &&
+      header[kMagicIndex] == kReadOnlySpaceFileMagic &&
+      header[kVersionHashIndex] == Version::Hash() &&
+      header[kFlagHashIndex] == FlagList::Hash() &&
+      header[kChecksumIndex] == snapshot_checksum &&
+      header[kPageCountIndex] > 0 &&
+      header[kPageCountIndex] <= kMaxReadOnlySpaceFilePages &&
+      header[kObjectCacheLengthIndex] <= kMaxReadOnlyObjectCacheLength;
+  if (valid) {
+    page_entries.resize(2 * size_t{header[kPageCountIndex]});
+    object_cache.resize(header[kObjectCacheLengthIndex]);
+    valid = ReadWords(file, page_entries.data(), page_entries.size()) &&
+            ReadWords(file, roots.data(), roots.size()) &&
+            ReadWords(file, object_cache.data(), object_cache.size()) &&
+            ValidateCageOffsets(isolate, page_entries, roots, object_cache);
+  }
+
+  const size_t page_size = FilePageAllocator()->AllocatePageSize();
+  const size_t header_size =
+      (kReadOnlySpaceFileHeaderSize + page_entries.size() + roots.size() +
+       object_cache.size()) *
+      kUInt32Size;
+  size_t file_size = 0;
+  if (valid && fseek(file, 0, SEEK_END) == 0) {
+    long end = ftell(file);  // NOLINT(runtime/int)
+    if (end > 0) file_size = static_cast<size_t>(end);
+  }
+  // Mapping beyond the end of the file would fault on access, so check that
+  // every page is in the file.
+  size_t offset = RoundUp(header_size, page_size);
+  for (size_t i = 0; valid && i < page_entries.size(); i += 2) {
+    size_t size = page_entries[i + 1];
+    valid = size > 0 && size % page_size == 0 && offset + size <= file_size;
+    offset += size;
+  }
+
+  std::vector<std::unique_ptr<PageAllocator::SharedMemory>> shared_memory;
+  offset = RoundUp(header_size, page_size);
+  for (size_t i = 0; valid && i < page_entries.size(); i += 2) {
+    size_t size = page_entries[i + 1];
+    auto memory = FilePageAllocator()->MapSharedFile(file, offset, size);
+    valid = memory &&
+            reinterpret_cast<ReadOnlyPage*>(memory->GetMemory())->size() <=
+                size;
+    if (valid) shared_memory.push_back(std::move(memory));
+    offset += size;
+  }
+  fclose(file);
+  if (!valid) return false;
+
+  stats_.IncreaseCapacity(header[kCapacityIndex]);
+  for (size_t i = 0; i < shared_memory.size(); ++i) {
+    ReadOnlyPage* page =
+        reinterpret_cast<ReadOnlyPage*>(shared_memory[i]->GetMemory());
+    pages_.push_back(page);
+    page_offsets_.push_back(page_entries[2 * i]);
+    shared_memory_.push_back(std::move(shared_memory[i]));
+    stats_.IncreaseAllocatedBytes(page->allocated_bytes(), page);
+  }
+  for (size_t i = 0; i < kReadOnlyRootsCount; ++i) {
+    read_only_roots_[i] = roots[i];
+  }
+
+  set_shared_read_only_space(
+      std::make_unique<SharedReadOnlySpace>(isolate->heap(), this));
+  std::unique_ptr<ReadOnlyHeap> ro_heap(
+      new ReadOnlyHeap(shared_read_only_space()));
+  // Like the roots, the cache holds offsets, which GetReadOnlyHeapForIsolate
+  // rebases to the cage of each Isolate.
+  for (uint32_t entry : object_cache) {
+    ro_heap->read_only_object_cache_.push_back(Object(Address{entry}));
+  }
+  ro_heap->init_complete_ = true;
+  set_read_only_heap(std::move(ro_heap));
+  return true;
+}
+
+void PointerCompressedReadOnlyArtifacts::WriteToFile(
+    const char* file_name, uint32_t snapshot_checksum) const {
+  const size_t page_size = FilePageAllocator()->AllocatePageSize();
+  const std::vector<Object>& object_cache =
+      read_only_heap()->read_only_object_cache_;
+
+  std::vector<uint32_t> header(kReadOnlySpaceFileHeaderSize);
+  header[kMagicIndex] = kReadOnlySpaceFileMagic;
+  header[kVersionHashIndex] = Version::Hash();
+  header[kFlagHashIndex] = FlagList::Hash();
+  header[kChecksumIndex] = snapshot_checksum;
+  header[kCapacityIndex] = static_cast<uint32_t>(stats_.Capacity());
+  header[kPageCountIndex] = static_cast<uint32_t>(pages_.size());
+  header[kObjectCacheLengthIndex] = static_cast<uint32_t>(object_cache.size());
+  for (size_t i = 0; i < pages_.size(); ++i) {
+    header.push_back(page_offsets_[i]);
+    size_t size = RoundUp(shared_memory_[i]->GetSize(), page_size);
+    header.push_back(static_cast<uint32_t>(size));
+  }
+  for (size_t i = 0; i < kReadOnlyRootsCount; ++i) {
+    header.push_back(static_cast<uint32_t>(read_only_roots_[i]));
+  }
+  for (Object object : object_cache) {
+    header.push_back(CompressTagged(object.ptr()));
+  }
+
+  // Processes starting at the same time may all write the file. Writing to a
+  // temporary file and renaming it ensures that no process maps a partially
+  // written file.
+  std::string temp_name = std::string(file_name) + ".tmp" +
+                          std::to_string(base::OS::GetCurrentProcessId());
+  FILE* file = base::OS::FOpen(temp_name.c_str(), "wb");
+  if (file == nullptr) return;
+  bool success = fwrite(header.data(), kUInt32Size, header.size(), file) ==
+                 header.size();
+  size_t offset = header.size() * kUInt32Size;
+  for (size_t i = 0; success && i < pages_.size(); ++i) {
+    size_t size = shared_memory_[i]->GetSize();
+    success = WriteZeros(file, RoundUp(offset, page_size) - offset) &&
+              fwrite(shared_memory_[i]->GetMemory(), 1, size, file) == size &&
+              WriteZeros(file, RoundUp(size, page_size) - size);
+    offset = RoundUp(offset, page_size) + RoundUp(size, page_size);
+  }
+  success = fclose(file) == 0 && success;
+  if (!success || std::rename(temp_name.c_str(), file_name) != 0) {
+    base::OS::Remove(temp_name.c_str());
+  }
+}
+
 // -----------------------------------------------------------------------------
 // ReadOnlySpace implementation
 
@@ -145,6 +145,20 @@ class PointerCompressedReadOnlyArtifacts : public ReadOnlyArtifacts {
   void ReinstallReadOnlySpace(Isolate* isolate) override;
   void VerifyHeapAndSpaceRelationships(Isolate* isolate) override;
 
+  // Initializes the artifacts from pages mapped from a file written by
+  // WriteToFile, instead of from a deserialized Isolate. Since the pages are
+  // mapped read-only and shared, every process that uses the same file shares
+  // the physical memory of the read-only space. Returns false if the file does
+  // not exist, was written for a different build, flags or snapshot, or its
+  // pages would not fit into the pointer compression cage of |isolate|.
+  bool InitializeFromFile(Isolate* isolate, const char* file_name,
+                          uint32_t snapshot_checksum);
+  // Writes the pages, roots and object cache to a file for InitializeFromFile.
+  // The contents of the pages only refer to each other as offsets from the
+  // cage base, so the file is valid for any cage as long as the pages are
+  // mapped at the same offsets.
+  void WriteToFile(const char* file_name, uint32_t snapshot_checksum) const;
+
  private:
   SharedReadOnlySpace* CreateReadOnlySpace(Isolate* isolate);
   Tagged_t OffsetForPage(size_t index) const { return page_offsets_[index]; }
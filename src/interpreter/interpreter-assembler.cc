@@ -1188,6 +1188,63 @@ void InterpreterAssembler::InlineShortStar(TNode<WordT> target_bytecode) {
   implicit_register_use_ = previous_acc_use;
 }
 
+void InterpreterAssembler::JumpIfBooleanDispatchLookahead(
+    TNode<WordT> target_bytecode) {
+  Label do_inline_jump_if_true(this), do_inline_jump_if_false(this),
+      done(this);
+
+  TNode<Int32T> next_bytecode = TruncateWordToInt32(target_bytecode);
+  GotoIf(Word32Equal(next_bytecode,
+                     Int32Constant(static_cast<int>(Bytecode::kJumpIfTrue))),
+         &do_inline_jump_if_true);
+  Branch(Word32Equal(next_bytecode,
+                     Int32Constant(static_cast<int>(Bytecode::kJumpIfFalse))),
+         &do_inline_jump_if_false, &done);
+
+  // As for Star lookahead, each inlined jump gets its own indirect jumps for
+  // better branch prediction.
+  BIND(&do_inline_jump_if_true);
+  InlineJumpIfBoolean(Bytecode::kJumpIfTrue, target_bytecode);
+
+  BIND(&do_inline_jump_if_false);
+  InlineJumpIfBoolean(Bytecode::kJumpIfFalse, target_bytecode);
+
+  BIND(&done);
+}
+
+void InterpreterAssembler::InlineJumpIfBoolean(Bytecode jump_bytecode,
+                                               TNode<WordT> target_bytecode) {
+  DCHECK(jump_bytecode == Bytecode::kJumpIfTrue ||
+         jump_bytecode == Bytecode::kJumpIfFalse);
+  if (FLAG_trace_ignition_dispatches) {
+    TraceBytecodeDispatch(target_bytecode);
+  }
+
+  Bytecode previous_bytecode = bytecode_;
+  ImplicitRegisterUse previous_acc_use = implicit_register_use_;
+  bytecode_ = jump_bytecode;
+  implicit_register_use_ = ImplicitRegisterUse::kNone;
+
+#ifdef V8_TRACE_UNOPTIMIZED
+  TraceBytecode(Runtime::kTraceUnoptimizedBytecodeEntry);
+#endif
+
+  TNode<Object> accumulator = GetAccumulator();
+  TNode<IntPtrT> relative_jump = Signed(BytecodeOperandUImmWord(0));
+  CSA_ASSERT(this, IsBoolean(CAST(accumulator)));
+  TNode<Oddball> value = jump_bytecode == Bytecode::kJumpIfTrue
+                             ? TrueConstant()
+                             : FalseConstant();
+
+  DCHECK_EQ(implicit_register_use_,
+            Bytecodes::GetImplicitRegisterUse(bytecode_));
+
+  JumpIfTaggedEqual(accumulator, value, relative_jump);
+
+  bytecode_ = previous_bytecode;
+  implicit_register_use_ = previous_acc_use;
+}
+
 void InterpreterAssembler::Dispatch() {
   Comment("========= Dispatch");
   DCHECK_IMPLIES(Bytecodes::MakesCallAlongCriticalPath(bytecode_), made_call_);
@@ -1200,6 +1257,8 @@ void InterpreterAssembler::DispatchToBytecodeWithOptionalStarLookahead(
     TNode<WordT> target_bytecode) {
   if (Bytecodes::IsStarLookahead(bytecode_, operand_scale_)) {
     StarDispatchLookahead(target_bytecode);
+  } else if (Bytecodes::IsJumpIfBooleanLookahead(bytecode_, operand_scale_)) {
+    JumpIfBooleanDispatchLookahead(target_bytecode);
   }
   DispatchToBytecode(target_bytecode, BytecodeOffset());
 }
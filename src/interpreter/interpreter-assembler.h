@@ -387,6 +387,17 @@ class V8_EXPORT_PRIVATE InterpreterAssembler : public CodeStubAssembler {
   // the next dispatch offset.
   void InlineShortStar(TNode<WordT> target_bytecode);
 
+  // Look ahead for JumpIfTrue or JumpIfFalse after a bytecode that always
+  // produces a Boolean, and perform the jump in a branch without dispatching
+  // to its handler. Anything after this point can assume that the following
+  // instruction was neither of them.
+  void JumpIfBooleanDispatchLookahead(TNode<WordT> target_bytecode);
+
+  // Build code for the |jump_bytecode| (JumpIfTrue or JumpIfFalse) at the
+  // current BytecodeOffset(), including the subsequent dispatch.
+  void InlineJumpIfBoolean(Bytecode jump_bytecode,
+                           TNode<WordT> target_bytecode);
+
   // Dispatch to the bytecode handler with code entry point |handler_entry|.
   void DispatchToBytecodeHandlerEntry(TNode<RawPtrT> handler_entry,
                                       TNode<IntPtrT> bytecode_offset);
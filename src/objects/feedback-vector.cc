@@ -251,8 +251,9 @@ Handle<FeedbackVector> FeedbackVector::New(
 
   DCHECK_EQ(vector->shared_function_info(), *shared);
   DCHECK_EQ(vector->optimization_marker(),
-            FLAG_log_function_events ? OptimizationMarker::kLogFirstExecution
-                                     : OptimizationMarker::kNone);
+            FLAG_log_function_events || FLAG_record_called_functions
+                ? OptimizationMarker::kLogFirstExecution
+                : OptimizationMarker::kNone);
   // TODO(mythria): This might change if NCI code is installed on feedback
   // vector. Update this accordingly.
   DCHECK_EQ(vector->optimization_tier(), OptimizationTier::kNone);
@@ -461,8 +462,9 @@ void FeedbackVector::ClearOptimizationTier(FeedbackCell feedback_cell) {
 void FeedbackVector::InitializeOptimizationState() {
   int32_t state = 0;
   state = OptimizationMarkerBits::update(
-      state, FLAG_log_function_events ? OptimizationMarker::kLogFirstExecution
-                                      : OptimizationMarker::kNone);
+      state, FLAG_log_function_events || FLAG_record_called_functions
+                 ? OptimizationMarker::kLogFirstExecution
+                 : OptimizationMarker::kNone);
   state = OptimizationTierBits::update(state, OptimizationTier::kNone);
   set_flags(state);
 }
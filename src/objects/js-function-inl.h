@@ -114,6 +114,9 @@ void JSFunction::MarkForOptimization(ConcurrencyMode mode) {
     }
   }
 
+  if (FLAG_record_called_functions) {
+    shared().set_has_been_marked_for_optimization(true);
+  }
   SetOptimizationMarker(mode == ConcurrencyMode::kConcurrent
                             ? OptimizationMarker::kCompileOptimizedConcurrent
                             : OptimizationMarker::kCompileOptimized);
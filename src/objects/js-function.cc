@@ -377,9 +377,11 @@ void JSFunction::InitializeFeedbackCell(
   const bool needs_feedback_vector =
       !FLAG_lazy_feedback_allocation || FLAG_always_opt ||
       function->shared().may_have_cached_code() ||
-      // We also need a feedback vector for certain log events, collecting type
-      // profile and more precise code coverage.
-      FLAG_log_function_events || !isolate->is_best_effort_code_coverage() ||
+      // We also need a feedback vector for certain log events, recording
+      // tiering profiles, collecting type profile and more precise code
+      // coverage.
+      FLAG_log_function_events || FLAG_record_called_functions ||
+      !isolate->is_best_effort_code_coverage() ||
       isolate->is_collecting_type_profile();
 
   if (needs_feedback_vector) {
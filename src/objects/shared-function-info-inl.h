@@ -238,6 +238,16 @@ BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2,
 BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, may_have_cached_code,
                     SharedFunctionInfo::MayHaveCachedCodeBit)
 
+BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, hot_in_tiering_profile,
+                    SharedFunctionInfo::HotInTieringProfileBit)
+
+BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, has_been_called,
+                    SharedFunctionInfo::HasBeenCalledBit)
+
+BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2,
+                    has_been_marked_for_optimization,
+                    SharedFunctionInfo::HasBeenMarkedForOptimizationBit)
+
 BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags, syntax_kind,
                     SharedFunctionInfo::FunctionSyntaxKindBits)
 
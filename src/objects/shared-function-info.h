@@ -422,6 +422,20 @@ class SharedFunctionInfo
   // hence the 'may'.
   DECL_BOOLEAN_ACCESSORS(may_have_cached_code)
 
+  // True if a tiering profile recorded by an earlier run of the script marked
+  // this function as optimized. Cleared once the function has been marked for
+  // optimization on the strength of the hint.
+  DECL_BOOLEAN_ACCESSORS(hot_in_tiering_profile)
+
+  // True if a closure of this function has been called, or marked for
+  // optimization, in this isolate while --record-called-functions was set.
+  // Calls are recorded on the first execution of each feedback vector, like
+  // --log-function-events does. Unlike is_compiled(), these are not set by
+  // eager compilation, so tiering profiles and compile hints use them as
+  // evidence of execution.
+  DECL_BOOLEAN_ACCESSORS(has_been_called)
+  DECL_BOOLEAN_ACCESSORS(has_been_marked_for_optimization)
+
   // Returns the cached Code object for this SFI if it exists, an empty handle
   // otherwise.
   MaybeHandle<Code> TryGetCachedCode(Isolate* isolate);
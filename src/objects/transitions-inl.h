@@ -162,7 +162,7 @@ bool TransitionArray::GetTargetIfExists(int transition_number, Isolate* isolate,
   // transition.
   if (raw.IsSmi()) {
     DCHECK(isolate->has_active_deserializer());
-    DCHECK_EQ(raw.ToSmi(), Deserializer::uninitialized_field_value());
+    DCHECK_EQ(raw.ToSmi(), Deserializer<Isolate>::uninitialized_field_value());
     return false;
   }
   if (raw->GetHeapObjectIfStrong(&heap_object) &&
@@ -39,6 +39,22 @@ void LiteralBuffer::ExpandBuffer() {
   backing_store_ = new_store;
 }
 
+void LiteralBuffer::AddOneByteChars(const uint16_t* chars, int length) {
+  DCHECK(is_one_byte());
+  if (length == 0) return;
+  if (position_ + length > backing_store_.length()) {
+    int min_capacity = std::max({kInitialCapacity, position_ + length});
+    Vector<byte> new_store = Vector<byte>::New(NewCapacity(min_capacity));
+    if (position_ > 0) {
+      MemCopy(new_store.begin(), backing_store_.begin(), position_);
+    }
+    backing_store_.Dispose();
+    backing_store_ = new_store;
+  }
+  CopyChars(&backing_store_[position_], chars, length);
+  position_ += length;
+}
+
 void LiteralBuffer::ConvertToTwoByte() {
   DCHECK(is_one_byte());
   Vector<byte> new_store;
@@ -37,6 +37,9 @@ class LiteralBuffer final {
     AddTwoByteChar(code_unit);
   }
 
+  // Adds a run of ASCII code units, growing the backing store at most once.
+  void AddOneByteChars(const uint16_t* chars, int length);
+
   bool is_one_byte() const { return is_one_byte_; }
 
   bool Equals(Vector<const char> keyword) const {
@@ -5,6 +5,7 @@
 #ifndef V8_PARSING_PARSE_INFO_H_
 #define V8_PARSING_PARSE_INFO_H_
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -273,6 +274,16 @@ class V8_EXPORT_PRIVATE ParseInfo {
   v8::Extension* extension() const { return extension_; }
   void set_extension(v8::Extension* extension) { extension_ = extension; }
 
+  // Start positions of functions that should be compiled eagerly, sorted in
+  // ascending order. Not owned.
+  const std::vector<int>* compile_hints() const { return compile_hints_; }
+  void set_compile_hints(const std::vector<int>* compile_hints) {
+    DCHECK_IMPLIES(compile_hints != nullptr,
+                   std::is_sorted(compile_hints->begin(),
+                                  compile_hints->end()));
+    compile_hints_ = compile_hints;
+  }
+
   void set_consumed_preparse_data(std::unique_ptr<ConsumedPreparseData> data) {
     consumed_preparse_data_.swap(data);
   }
@@ -335,6 +346,7 @@ class V8_EXPORT_PRIVATE ParseInfo {
 
   std::unique_ptr<Zone> zone_;
   v8::Extension* extension_;
+  const std::vector<int>* compile_hints_;
   DeclarationScope* script_scope_;
   uintptr_t stack_limit_;
   int parameters_end_pos_;
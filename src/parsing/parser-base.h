@@ -3449,6 +3449,7 @@ ParserBase<Impl>::ParseLeftHandSideContinuation(ExpressionT result) {
           // For call of an identifier we want to report position of
           // the identifier as position of the call in the stack trace.
           pos = position();
+          impl()->RecordIdentifierCall(result);
         } else {
           // For other kinds of calls we record position of the parenthesis as
           // position of the call. Note that this is extremely important for
@@ -4460,7 +4461,9 @@ ParserBase<Impl>::ParseArrowFunctionLiteral(
 
   FunctionKind kind = formal_parameters.scope->function_kind();
   FunctionLiteral::EagerCompileHint eager_compile_hint =
-      default_eager_compile_hint_;
+      impl()->HasCompileHint(formal_parameters.scope->start_position())
+          ? FunctionLiteral::kShouldEagerCompile
+          : default_eager_compile_hint_;
   bool can_preparse = impl()->parse_lazily() &&
                       eager_compile_hint == FunctionLiteral::kShouldLazyCompile;
   // TODO(marja): consider lazy-parsing inner arrow functions too. is_this
@@ -2512,7 +2512,9 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
   }
 
   FunctionLiteral::EagerCompileHint eager_compile_hint =
-      function_state_->next_function_is_likely_called() || is_wrapped
+      function_state_->next_function_is_likely_called() || is_wrapped ||
+              HasCompileHint(peek_position()) ||
+              IsCalledFunctionDeclaration(function_name, function_syntax_kind)
           ? FunctionLiteral::kShouldEagerCompile
           : default_eager_compile_hint();
 
@@ -5,7 +5,10 @@
 #ifndef V8_PARSING_PARSER_H_
 #define V8_PARSING_PARSER_H_
 
+#include <algorithm>
 #include <cstddef>
+#include <set>
+#include <utility>
 
 #include "src/ast/ast-source-ranges.h"
 #include "src/ast/ast-value-factory.h"
@@ -363,6 +366,32 @@ class V8_EXPORT_PRIVATE Parser : public NON_EXPORTED_BASE(ParserBase<Parser>) {
     return scope()->GetDeclarationScope()->has_checked_syntax();
   }
 
+  // Whether the function starting at |position| is expected to be called
+  // while the script loads, either because the embedder listed it in the
+  // compile hints or because of a //# allFunctionsCalledOnLoad comment.
+  bool HasCompileHint(int position) const {
+    if (V8_UNLIKELY(scanner()->SawMagicCommentCompileHintsAll())) return true;
+    const std::vector<int>* compile_hints = info()->compile_hints();
+    return V8_UNLIKELY(compile_hints != nullptr) &&
+           std::binary_search(compile_hints->begin(), compile_hints->end(),
+                              position);
+  }
+
+  // With --parallel-streaming-compile, a function declaration is expected to
+  // be called while the script loads if the fully parsed code declaring it
+  // has already called it by name, e.g. a bundle's top-level code calling a
+  // hoisted function declared further down.
+  void RecordIdentifierCall(Expression* callee) {
+    if (!FLAG_parallel_streaming_compile || !callee->IsVariableProxy()) return;
+    if (!scope()->is_declaration_scope()) return;
+    called_identifiers_.emplace(scope(), callee->AsVariableProxy()->raw_name());
+  }
+  bool IsCalledFunctionDeclaration(const AstRawString* name,
+                                   FunctionSyntaxKind function_syntax_kind) {
+    if (function_syntax_kind != FunctionSyntaxKind::kDeclaration) return false;
+    return called_identifiers_.count(std::make_pair(scope(), name)) != 0;
+  }
+
   void InitializeVariables(
       ScopedPtrList<Statement>* statements, VariableKind kind,
       const DeclarationParsingResult::Declaration* declaration);
@@ -1091,6 +1120,9 @@ class V8_EXPORT_PRIVATE Parser : public NON_EXPORTED_BASE(ParserBase<Parser>) {
   bool temp_zoned_;
   ConsumedPreparseData* consumed_preparse_data_;
   std::vector<uint8_t> preparse_data_buffer_;
+  // Identifiers called directly from a declaration scope, see
+  // RecordIdentifierCall().
+  std::set<std::pair<Scope*, const AstRawString*>> called_identifiers_;
 
   // If not kNoSourcePosition, indicates that the first function literal
   // encountered is a dynamic function, see CreateDynamicFunction(). This field
@@ -1027,6 +1027,10 @@ class PreParser : public ParserBase<PreParser> {
 
   bool HasCheckedSyntax() { return false; }
 
+  bool HasCompileHint(int position) const { return false; }
+
+  void RecordIdentifierCall(const PreParserExpression& callee) {}
+
   void ParseStatementListAndLogFunction(PreParserFormalParameters* formals);
 
   struct TemplateLiteralState {};
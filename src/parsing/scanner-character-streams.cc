@@ -621,6 +621,18 @@ bool Utf8ExternalStreamingStream::SkipToPosition(size_t position) {
     if (t != unibrow::Utf8::kIncomplete) {
       chars++;
       if (t > unibrow::Utf16::kMaxNonSurrogateCharCode) chars++;
+      // Fast path for ascii sequences. A supplementary character can step
+      // one past {position}.
+      DCHECK_EQ(state, unibrow::Utf8::State::kAccept);
+      if (chars < position && cursor < end &&
+          *cursor <= unibrow::Utf8::kMaxOneByteChar) {
+        size_t remaining = end - cursor;
+        int max_length =
+            static_cast<int>(std::min(remaining, position - chars));
+        int ascii_length = NonAsciiStart(cursor, max_length);
+        cursor += ascii_length;
+        chars += ascii_length;
+      }
     }
   }
 
@@ -240,6 +240,14 @@ inline bool MultilineCommentCharacterNeedsSlowPath(uint8_t scan_flags) {
   return (scan_flags & static_cast<uint8_t>(
                            ScanFlags::kMultilineCommentCharacterNeedsSlowPath));
 }
+// Returns whether any code unit in {word} may be a line terminator. U+2028 and
+// U+2029 only differ in the lowest bit, so they are tested together.
+inline bool WordMayHaveLineTerminator(Utf16CharacterStream::Word word) {
+  return Utf16CharacterStream::WordHasCodeUnit(word, '\n') ||
+         Utf16CharacterStream::WordHasCodeUnit(word, '\r') ||
+         Utf16CharacterStream::WordHasCodeUnit(
+             word | Utf16CharacterStream::kWordLowBits, 0x2029);
+}
 inline bool MayTerminateString(uint8_t scan_flags) {
   return (scan_flags & static_cast<uint8_t>(ScanFlags::kStringTerminator));
 }
@@ -273,25 +281,26 @@ V8_INLINE Token::Value Scanner::ScanIdentifierOrKeywordInner() {
       // Otherwise we'll fall into the slow path after scanning the identifier.
       DCHECK(!IdentifierNeedsSlowPath(scan_flags));
       AddLiteralChar(static_cast<char>(c0_));
-      AdvanceUntil([this, &scan_flags](uc32 c0) {
-        if (V8_UNLIKELY(static_cast<uint32_t>(c0) > kMaxAscii)) {
-          // A non-ascii character means we need to drop through to the slow
-          // path.
-          // TODO(leszeks): This would be most efficient as a goto to the slow
-          // path, check codegen and maybe use a bool instead.
-          scan_flags |=
-              static_cast<uint8_t>(ScanFlags::kIdentifierNeedsSlowPath);
-          return true;
-        }
-        uint8_t char_flags = character_scan_flags[c0];
-        scan_flags |= char_flags;
-        if (TerminatesLiteral(char_flags)) {
-          return true;
-        } else {
-          AddLiteralChar(static_cast<char>(c0));
-          return false;
-        }
-      });
+      // The identifier characters are only checked here; they are copied to
+      // the literal buffer a buffered run at a time.
+      AdvanceUntilCollecting(
+          [&scan_flags](uc32 c0) {
+            if (V8_UNLIKELY(static_cast<uint32_t>(c0) > kMaxAscii)) {
+              // A non-ascii character means we need to drop through to the
+              // slow path.
+              // TODO(leszeks): This would be most efficient as a goto to the
+              // slow path, check codegen and maybe use a bool instead.
+              scan_flags |=
+                  static_cast<uint8_t>(ScanFlags::kIdentifierNeedsSlowPath);
+              return true;
+            }
+            uint8_t char_flags = character_scan_flags[c0];
+            scan_flags |= char_flags;
+            return TerminatesLiteral(char_flags);
+          },
+          [this](const uint16_t* start, const uint16_t* end) {
+            AddLiteralChars(start, end);
+          });
 
       if (V8_LIKELY(!IdentifierNeedsSlowPath(scan_flags))) {
         if (!CanBeKeyword(scan_flags)) return Token::IDENTIFIER;
@@ -323,12 +332,21 @@ V8_INLINE Token::Value Scanner::SkipWhiteSpace() {
   // We won't skip behind the end of input.
   DCHECK(!IsWhiteSpaceOrLineTerminator(kEndOfInput));
 
-  // Advance as long as character is a WhiteSpace or LineTerminator.
-  while (IsWhiteSpaceOrLineTerminator(c0_)) {
-    if (!next().after_line_terminator && unibrow::IsLineTerminator(c0_)) {
-      next().after_line_terminator = true;
-    }
-    Advance();
+  // Advance as long as character is a WhiteSpace or LineTerminator. Runs of
+  // spaces, as used for indentation, are skipped a word at a time.
+  if (IsWhiteSpaceOrLineTerminator(c0_)) {
+    bool after_line_terminator =
+        next().after_line_terminator || unibrow::IsLineTerminator(c0_);
+    AdvanceUntilByWord(
+        [](Utf16CharacterStream::Word word) {
+          return word != Utf16CharacterStream::WordOf(' ');
+        },
+        [&after_line_terminator](uc32 c0) {
+          if (!IsWhiteSpaceOrLineTerminator(c0)) return true;
+          if (unibrow::IsLineTerminator(c0)) after_line_terminator = true;
+          return false;
+        });
+    next().after_line_terminator = after_line_terminator;
   }
 
   // Return whether or not we skipped any characters.
@@ -95,6 +95,7 @@ Scanner::Scanner(Utf16CharacterStream* source, UnoptimizedCompileFlags flags)
     : flags_(flags),
       source_(source),
       found_html_comment_(false),
+      saw_magic_comment_compile_hints_all_(false),
       octal_pos_(Location::invalid()),
       octal_message_(MessageTemplate::kNone) {
   DCHECK_NOT_NULL(source);
@@ -209,7 +210,9 @@ Token::Value Scanner::SkipSingleLineComment() {
   // separately by the lexical grammar and becomes part of the
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
-  AdvanceUntil([](uc32 c0_) { return unibrow::IsLineTerminator(c0_); });
+  AdvanceUntilByWord(WordMayHaveLineTerminator, [](uc32 c0_) {
+    return unibrow::IsLineTerminator(c0_);
+  });
 
   return Token::WHITESPACE;
 }
@@ -239,6 +242,11 @@ void Scanner::TryToParseSourceURLComment() {
   if (!name.is_one_byte()) return;
   Vector<const uint8_t> name_literal = name.one_byte_literal();
   LiteralBuffer* value;
+  if (name_literal == StaticOneByteVector("allFunctionsCalledOnLoad")) {
+    // This magic comment has no value.
+    saw_magic_comment_compile_hints_all_ = true;
+    return;
+  }
   if (name_literal == StaticOneByteVector("sourceURL")) {
     value = &source_url_;
   } else if (name_literal == StaticOneByteVector("sourceMappingURL")) {
@@ -276,13 +284,18 @@ Token::Value Scanner::SkipMultiLineComment() {
   // Until we see the first newline, check for * and newline characters.
   if (!next().after_line_terminator) {
     do {
-      AdvanceUntil([](uc32 c0) {
-        if (V8_UNLIKELY(static_cast<uint32_t>(c0) > kMaxAscii)) {
-          return unibrow::IsLineTerminator(c0);
-        }
-        uint8_t char_flags = character_scan_flags[c0];
-        return MultilineCommentCharacterNeedsSlowPath(char_flags);
-      });
+      AdvanceUntilByWord(
+          [](Utf16CharacterStream::Word word) {
+            return Utf16CharacterStream::WordHasCodeUnit(word, '*') ||
+                   WordMayHaveLineTerminator(word);
+          },
+          [](uc32 c0) {
+            if (V8_UNLIKELY(static_cast<uint32_t>(c0) > kMaxAscii)) {
+              return unibrow::IsLineTerminator(c0);
+            }
+            uint8_t char_flags = character_scan_flags[c0];
+            return MultilineCommentCharacterNeedsSlowPath(char_flags);
+          });
 
       while (c0_ == '*') {
         Advance();
@@ -301,7 +314,11 @@ Token::Value Scanner::SkipMultiLineComment() {
 
   // After we've seen newline, simply try to find '*/'.
   while (c0_ != kEndOfInput) {
-    AdvanceUntil([](uc32 c0) { return c0 == '*'; });
+    AdvanceUntilByWord(
+        [](Utf16CharacterStream::Word word) {
+          return Utf16CharacterStream::WordHasCodeUnit(word, '*');
+        },
+        [](uc32 c0) { return c0 == '*'; });
 
     while (c0_ == '*') {
       Advance();
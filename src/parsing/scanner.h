@@ -8,6 +8,7 @@
 #define V8_PARSING_SCANNER_H_
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "include/v8.h"
@@ -93,6 +94,90 @@ class Utf16CharacterStream {
     }
   }
 
+  // Like AdvanceUntil, but additionally passes each buffered run of code
+  // units that was advanced over to {consume_run} as a [start, end) range,
+  // before the buffer is refilled.
+  template <typename FunctionType, typename RunFunctionType>
+  V8_INLINE uc32 AdvanceUntilCollecting(FunctionType check,
+                                        RunFunctionType consume_run) {
+    while (true) {
+      const uint16_t* run_start = buffer_cursor_;
+      auto next_cursor_pos =
+          std::find_if(buffer_cursor_, buffer_end_, [&check](uint16_t raw_c0_) {
+            uc32 c0_ = static_cast<uc32>(raw_c0_);
+            return check(c0_);
+          });
+      consume_run(run_start, next_cursor_pos);
+
+      if (next_cursor_pos == buffer_end_) {
+        buffer_cursor_ = buffer_end_;
+        if (!ReadBlockChecked()) {
+          buffer_cursor_++;
+          return kEndOfInput;
+        }
+      } else {
+        buffer_cursor_ = next_cursor_pos + 1;
+        return static_cast<uc32>(*next_cursor_pos);
+      }
+    }
+  }
+
+  // Blocks of code units that AdvanceUntilByWord tests at once.
+  using Word = uint64_t;
+  static constexpr int kCodeUnitsPerWord = sizeof(Word) / sizeof(uint16_t);
+  static constexpr Word kWordLowBits = 0x0001000100010001;
+  static constexpr Word kWordHighBits = 0x8000800080008000;
+
+  // Returns a word with {code_unit} in every lane.
+  static constexpr Word WordOf(uint16_t code_unit) {
+    return kWordLowBits * code_unit;
+  }
+
+  // Returns whether any of the code units in {word} is {code_unit}.
+  static constexpr bool WordHasCodeUnit(Word word, uint16_t code_unit) {
+    return (((word ^ WordOf(code_unit)) - kWordLowBits) &
+            ~(word ^ WordOf(code_unit)) & kWordHighBits) != 0;
+  }
+
+  // Like AdvanceUntil, but skips over whole words of kCodeUnitsPerWord code
+  // units for which {word_may_match} returns false, and only calls {check}
+  // on the code units of the remaining words. {word_may_match} may return
+  // true spuriously, but must not return false for a word containing a code
+  // unit that satisfies {check}.
+  template <typename WordFunctionType, typename FunctionType>
+  V8_INLINE uc32 AdvanceUntilByWord(WordFunctionType word_may_match,
+                                    FunctionType check) {
+    while (true) {
+      const uint16_t* cursor = buffer_cursor_;
+      while (cursor < buffer_end_) {
+        const uint16_t* word_end = cursor + kCodeUnitsPerWord;
+        if (word_end <= buffer_end_) {
+          Word word;
+          memcpy(&word, cursor, sizeof(word));
+          if (!word_may_match(word)) {
+            cursor = word_end;
+            continue;
+          }
+        } else {
+          word_end = buffer_end_;
+        }
+        for (; cursor < word_end; ++cursor) {
+          uc32 c0 = static_cast<uc32>(*cursor);
+          if (check(c0)) {
+            buffer_cursor_ = cursor + 1;
+            return c0;
+          }
+        }
+      }
+
+      buffer_cursor_ = buffer_end_;
+      if (!ReadBlockChecked()) {
+        buffer_cursor_++;
+        return kEndOfInput;
+      }
+    }
+  }
+
   // Go back one by one character in the input stream.
   // This undoes the most recent Advance().
   inline void Back() {
@@ -414,6 +499,12 @@ class V8_EXPORT_PRIVATE Scanner {
 
   bool FoundHtmlComment() const { return found_html_comment_; }
 
+  // Whether the source contained a //# allFunctionsCalledOnLoad comment before
+  // the current position.
+  bool SawMagicCommentCompileHintsAll() const {
+    return saw_magic_comment_compile_hints_all_;
+  }
+
   const Utf16CharacterStream* stream() const { return source_; }
 
  private:
@@ -484,6 +575,7 @@ class V8_EXPORT_PRIVATE Scanner {
     next_next_ = &token_storage_[2];
 
     found_html_comment_ = false;
+    saw_magic_comment_compile_hints_all_ = false;
     scanner_error_ = MessageTemplate::kNone;
   }
 
@@ -506,6 +598,10 @@ class V8_EXPORT_PRIVATE Scanner {
 
   V8_INLINE void AddLiteralChar(char c) { next().literal_chars.AddChar(c); }
 
+  V8_INLINE void AddLiteralChars(const uint16_t* start, const uint16_t* end) {
+    next().literal_chars.AddOneByteChars(start, static_cast<int>(end - start));
+  }
+
   V8_INLINE void AddRawLiteralChar(uc32 c) {
     next().raw_literal_chars.AddChar(c);
   }
@@ -529,6 +625,18 @@ class V8_EXPORT_PRIVATE Scanner {
     c0_ = source_->AdvanceUntil(check);
   }
 
+  template <typename FunctionType, typename RunFunctionType>
+  V8_INLINE void AdvanceUntilCollecting(FunctionType check,
+                                        RunFunctionType consume_run) {
+    c0_ = source_->AdvanceUntilCollecting(check, consume_run);
+  }
+
+  template <typename WordFunctionType, typename FunctionType>
+  V8_INLINE void AdvanceUntilByWord(WordFunctionType word_may_match,
+                                    FunctionType check) {
+    c0_ = source_->AdvanceUntilByWord(word_may_match, check);
+  }
+
   bool CombineSurrogatePair() {
     DCHECK(!unibrow::Utf16::IsLeadSurrogate(kEndOfInput));
     if (unibrow::Utf16::IsLeadSurrogate(c0_)) {
@@ -728,6 +836,7 @@ class V8_EXPORT_PRIVATE Scanner {
   // Values parsed from magic comments.
   LiteralBuffer source_url_;
   LiteralBuffer source_mapping_url_;
+  bool saw_magic_comment_compile_hints_all_;
 
   // Last-seen positions of potentially problematic tokens.
   Location octal_pos_;
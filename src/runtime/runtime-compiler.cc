@@ -161,12 +161,15 @@ RUNTIME_FUNCTION(Runtime_FunctionFirstExecution) {
   CONVERT_ARG_HANDLE_CHECKED(JSFunction, function, 0);
   DCHECK_EQ(function->feedback_vector().optimization_marker(),
             OptimizationMarker::kLogFirstExecution);
-  DCHECK(FLAG_log_function_events);
+  DCHECK(FLAG_log_function_events || FLAG_record_called_functions);
   Handle<SharedFunctionInfo> sfi(function->shared(), isolate);
-  Handle<String> name = SharedFunctionInfo::DebugName(sfi);
-  LOG(isolate,
-      FunctionEvent("first-execution", Script::cast(sfi->script()).id(), 0,
-                    sfi->StartPosition(), sfi->EndPosition(), *name));
+  if (FLAG_record_called_functions) sfi->set_has_been_called(true);
+  if (FLAG_log_function_events) {
+    Handle<String> name = SharedFunctionInfo::DebugName(sfi);
+    LOG(isolate,
+        FunctionEvent("first-execution", Script::cast(sfi->script()).id(), 0,
+                      sfi->StartPosition(), sfi->EndPosition(), *name));
+  }
   function->feedback_vector().ClearOptimizationMarker();
   // Return the code to continue execution, we don't care at this point whether
   // this is for lazy compilation or has been eagerly complied.
@@ -0,0 +1,164 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/code-cache-bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "src/base/memory.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/objects/objects-inl.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+#include "src/objects/string-inl.h"
+#include "src/snapshot/code-serializer.h"
+#include "src/utils/version.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+uint32_t ReadWord(const byte* data, int index) {
+  return base::ReadUnalignedValue<uint32_t>(
+      reinterpret_cast<Address>(data) + index * kUInt32Size);
+}
+
+void WriteWord(byte* data, int index, uint32_t value) {
+  base::WriteUnalignedValue<uint32_t>(
+      reinterpret_cast<Address>(data) + index * kUInt32Size, value);
+}
+
+// Keeps NUL characters and encodes lone surrogates, so that different names
+// never map to the same key.
+std::string NameToUtf8(String name) {
+  int length = 0;
+  std::unique_ptr<char[]> chars =
+      name.ToCString(ALLOW_NULLS, FAST_STRING_TRAVERSAL, &length);
+  return std::string(chars.get(), length);
+}
+
+}  // namespace
+
+// static
+ScriptCompiler::CachedData* CodeCacheBundle::Create(
+    Isolate* isolate, const std::vector<Handle<SharedFunctionInfo>>& scripts) {
+  // Keyed by UTF-8 name; std::string compares bytes as unsigned, which is the
+  // order Lookup relies on.
+  std::map<std::string, std::unique_ptr<ScriptCompiler::CachedData>> caches;
+  for (Handle<SharedFunctionInfo> toplevel : scripts) {
+    DCHECK(toplevel->is_toplevel());
+    Object name = Script::cast(toplevel->script()).name();
+    if (!name.IsString()) continue;
+    std::string key = NameToUtf8(String::cast(name));
+    if (caches.count(key) != 0) continue;
+    std::unique_ptr<ScriptCompiler::CachedData> cache(
+        CodeSerializer::Serialize(toplevel));
+    if (!cache) continue;
+    caches.emplace(std::move(key), std::move(cache));
+  }
+
+  uint32_t count = static_cast<uint32_t>(caches.size());
+  size_t names_start = (kHeaderSize + size_t{count} * kEntrySize) * kUInt32Size;
+  size_t names_length = 0;
+  for (const auto& entry : caches) names_length += entry.first.size();
+  size_t size = names_start + names_length;
+  for (const auto& entry : caches) {
+    size = RoundUp(size, kPointerAlignment) + entry.second->length;
+  }
+  CHECK_LE(size, static_cast<size_t>(kMaxInt));
+
+  int length = static_cast<int>(size);
+  byte* data = NewArray<byte>(length);
+  memset(data, 0, length);
+  WriteWord(data, kMagicNumberIndex, kMagicNumber);
+  WriteWord(data, kVersionHashIndex, Version::Hash());
+  WriteWord(data, kFlagHashIndex, FlagList::Hash());
+  WriteWord(data, kEntryCountIndex, count);
+  WriteWord(data, kNamesLengthIndex, static_cast<uint32_t>(names_length));
+
+  int index = kHeaderSize;
+  size_t name_offset = 0;
+  size_t cache_offset = names_start + names_length;
+  for (const auto& entry : caches) {
+    const std::string& name = entry.first;
+    const ScriptCompiler::CachedData* cache = entry.second.get();
+    cache_offset = RoundUp(cache_offset, kPointerAlignment);
+    WriteWord(data, index + kNameOffsetIndex,
+              static_cast<uint32_t>(name_offset));
+    WriteWord(data, index + kNameLengthIndex,
+              static_cast<uint32_t>(name.size()));
+    WriteWord(data, index + kCacheOffsetIndex,
+              static_cast<uint32_t>(cache_offset));
+    WriteWord(data, index + kCacheLengthIndex,
+              static_cast<uint32_t>(cache->length));
+    CopyBytes(data + names_start + name_offset,
+              reinterpret_cast<const byte*>(name.data()), name.size());
+    CopyBytes(data + cache_offset, cache->data, cache->length);
+    index += kEntrySize;
+    name_offset += name.size();
+    cache_offset += cache->length;
+  }
+  DCHECK_EQ(cache_offset, size);
+
+  return new ScriptCompiler::CachedData(
+      data, length, ScriptCompiler::CachedData::BufferOwned);
+}
+
+// static
+Vector<const byte> CodeCacheBundle::Lookup(const byte* data, int length,
+                                           String name) {
+  if (length < kHeaderSize * kUInt32Size) return {};
+  if (ReadWord(data, kMagicNumberIndex) != kMagicNumber ||
+      ReadWord(data, kVersionHashIndex) != Version::Hash() ||
+      ReadWord(data, kFlagHashIndex) != FlagList::Hash()) {
+    return {};
+  }
+  uint32_t count = ReadWord(data, kEntryCountIndex);
+  uint32_t names_length = ReadWord(data, kNamesLengthIndex);
+  uint64_t names_start =
+      (kHeaderSize + uint64_t{count} * kEntrySize) * kUInt32Size;
+  if (names_start + names_length > static_cast<uint64_t>(length)) return {};
+  const byte* names = data + names_start;
+
+  // Only the entries visited by the binary search are validated, so that the
+  // lookup does not depend on the size of the bundle.
+  std::string key = NameToUtf8(name);
+  uint32_t low = 0;
+  uint32_t high = count;
+  while (low < high) {
+    uint32_t mid = low + (high - low) / 2;
+    int index = kHeaderSize + static_cast<int>(mid) * kEntrySize;
+    uint32_t name_offset = ReadWord(data, index + kNameOffsetIndex);
+    uint32_t name_length = ReadWord(data, index + kNameLengthIndex);
+    if (uint64_t{name_offset} + name_length > names_length) return {};
+    int result = memcmp(names + name_offset, key.data(),
+                        std::min<size_t>(name_length, key.size()));
+    if (result == 0 && name_length != key.size()) {
+      result = name_length < key.size() ? -1 : 1;
+    }
+    if (result < 0) {
+      low = mid + 1;
+    } else if (result > 0) {
+      high = mid;
+    } else {
+      uint32_t cache_offset = ReadWord(data, index + kCacheOffsetIndex);
+      uint32_t cache_length = ReadWord(data, index + kCacheLengthIndex);
+      if (uint64_t{cache_offset} + cache_length >
+          static_cast<uint64_t>(length)) {
+        return {};
+      }
+      return Vector<const byte>(data + cache_offset, cache_length);
+    }
+  }
+  return {};
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,76 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SNAPSHOT_CODE_CACHE_BUNDLE_H_
+#define V8_SNAPSHOT_CODE_CACHE_BUNDLE_H_
+
+#include <vector>
+
+#include "include/v8.h"
+#include "src/handles/handles.h"
+#include "src/utils/vector.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class SharedFunctionInfo;
+class String;
+
+// A code cache bundle holds the code caches of many scripts in a single
+// buffer, keyed by script name, so that an embedder can ship and map one file
+// instead of one cache per script. The bundle is only a container: every
+// entry is a regular code cache, which is checked and deserialized when its
+// script is compiled. Startup therefore only pays for the scripts that are
+// loaded, and within them only for the functions that were compiled when the
+// caches were created.
+//
+// The bundle starts with a sequence of uint32_t words:
+//   magic number, version hash, flag hash, entry count, names length,
+//   followed by (name offset, name length, cache offset, cache length) for
+//   each entry, sorted by name.
+// The UTF-8 names of all entries follow, and then the caches. Offsets are
+// relative to the start of the bundle, and every cache starts at a
+// pointer-aligned offset so that it can be used in place when the bundle
+// itself is pointer-aligned, e.g. when it is memory-mapped.
+//
+// Only the names share one string table: each cache still has its own copy
+// of the strings it references, and a script's cache is deserialized as a
+// whole rather than function by function. Sharing strings between caches or
+// materializing single functions would need references across caches and
+// per-function entry points in the code serializer.
+class CodeCacheBundle : public AllStatic {
+ public:
+  // Serializes the code caches of the given toplevel functions. Scripts
+  // without a string name, with a name seen before, or that cannot be
+  // serialized are left out.
+  V8_EXPORT_PRIVATE static ScriptCompiler::CachedData* Create(
+      Isolate* isolate, const std::vector<Handle<SharedFunctionInfo>>& scripts);
+
+  // Returns the code cache stored for {name}, pointing into {data}, or an
+  // empty vector if there is none or the bundle was rejected.
+  V8_EXPORT_PRIVATE static Vector<const byte> Lookup(const byte* data,
+                                                     int length, String name);
+
+ private:
+  static const uint32_t kMagicNumber = 0x43434244;  // "CCBD"
+
+  static const int kMagicNumberIndex = 0;
+  static const int kVersionHashIndex = 1;
+  static const int kFlagHashIndex = 2;
+  static const int kEntryCountIndex = 3;
+  static const int kNamesLengthIndex = 4;
+  static const int kHeaderSize = 5;
+
+  static const int kNameOffsetIndex = 0;
+  static const int kNameLengthIndex = 1;
+  static const int kCacheOffsetIndex = 2;
+  static const int kCacheLengthIndex = 3;
+  static const int kEntrySize = 4;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_SNAPSHOT_CODE_CACHE_BUNDLE_H_
@@ -4,12 +4,21 @@
 
 #include "src/snapshot/code-serializer.h"
 
+#include <unordered_map>
+
 #include "src/base/platform/platform.h"
+#include "src/codegen/compilation-cache.h"
 #include "src/codegen/macro-assembler.h"
 #include "src/common/globals.h"
 #include "src/debug/debug.h"
+#include "src/execution/local-isolate-inl.h"
+#include "src/execution/protectors.h"
+#include "src/handles/local-handles-inl.h"
+#include "src/handles/persistent-handles.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/local-factory-inl.h"
+#include "src/heap/local-heap-inl.h"
+#include "src/heap/parked-scope.h"
 #include "src/logging/counters.h"
 #include "src/logging/log.h"
 #include "src/objects/objects-inl.h"
@@ -18,6 +27,7 @@
 #include "src/snapshot/object-deserializer.h"
 #include "src/snapshot/snapshot-utils.h"
 #include "src/snapshot/snapshot.h"
+#include "src/utils/address-map.h"
 #include "src/utils/version.h"
 
 namespace v8 {
@@ -65,11 +75,15 @@ ScriptCompiler::CachedData* CodeSerializer::Serialize(
   // Serialize code object.
   Handle<String> source(String::cast(script->source()), isolate);
   HandleScope scope(isolate);
+  Handle<HeapObject> root = info;
+  if (FLAG_turbo_nci_code_cache) {
+    root = CollectCachedOptimizedCode(isolate, info);
+  }
   CodeSerializer cs(isolate, SerializedCodeData::SourceHash(
                                  source, script->origin_options()));
   DisallowGarbageCollection no_gc;
   cs.reference_map()->AddAttachedReference(*source);
-  ScriptData* script_data = cs.SerializeSharedFunctionInfo(info);
+  ScriptData* script_data = cs.SerializeObjectGraph(root);
 
   if (FLAG_profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
@@ -88,10 +102,14 @@ ScriptCompiler::CachedData* CodeSerializer::Serialize(
 
 ScriptData* CodeSerializer::SerializeSharedFunctionInfo(
     Handle<SharedFunctionInfo> info) {
+  return SerializeObjectGraph(info);
+}
+
+ScriptData* CodeSerializer::SerializeObjectGraph(Handle<HeapObject> root) {
   DisallowGarbageCollection no_gc;
 
   VisitRootPointer(Root::kHandleScope, nullptr,
-                   FullObjectSlot(info.location()));
+                   FullObjectSlot(root.location()));
   SerializeDeferredObjects();
   Pad();
 
@@ -130,13 +148,38 @@ void CodeSerializer::SerializeObjectImpl(Handle<HeapObject> obj) {
 
   if (SerializeReadOnlyObject(obj)) return;
 
-  CHECK(!obj->IsCode());
+  if (obj->IsCode()) {
+    Handle<Code> code = Handle<Code>::cast(obj);
+    // Builtins are shared by all isolates of a build, so refer to them by
+    // index. The only other code we expect is the native context independent
+    // code picked by CollectCachedOptimizedCode.
+    if (code->is_builtin()) {
+      sink_.Put(kBuiltinReference, "BuiltinRef");
+      sink_.PutInt(code->builtin_index(), "builtin_index");
+      return;
+    }
+    CHECK(FLAG_turbo_nci_code_cache);
+    CHECK(CodeKindIsNativeContextIndependentJSFunction(code->kind()));
+    SerializeGeneric(obj);
+    return;
+  }
 
   ReadOnlyRoots roots(isolate());
   if (ElideObject(*obj)) {
     return SerializeObject(roots.undefined_value_handle());
   }
 
+  if (obj->IsCodeDataContainer()) {
+    // Don't follow the link into the native context's optimized code list;
+    // the deserialized code is put on a list of its own native context.
+    Handle<CodeDataContainer> container = Handle<CodeDataContainer>::cast(obj);
+    Object next_code_link = container->next_code_link();
+    container->set_next_code_link(roots.undefined_value());
+    SerializeGeneric(obj);
+    container->set_next_code_link(next_code_link);
+    return;
+  }
+
   if (obj->IsScript()) {
     Handle<Script> script_obj = Handle<Script>::cast(obj);
     DCHECK_NE(script_obj->compilation_type(), Script::COMPILATION_TYPE_EVAL);
@@ -180,8 +223,19 @@ void CodeSerializer::SerializeObjectImpl(Handle<HeapObject> obj) {
     }
     DCHECK(!sfi->HasDebugInfo());
 
+    // Execution evidence belongs to this isolate, not to the cached script.
+    bool has_been_called = sfi->has_been_called();
+    bool has_been_marked_for_optimization =
+        sfi->has_been_marked_for_optimization();
+    sfi->set_has_been_called(false);
+    sfi->set_has_been_marked_for_optimization(false);
+
     SerializeGeneric(obj);
 
+    sfi->set_has_been_called(has_been_called);
+    sfi->set_has_been_marked_for_optimization(
+        has_been_marked_for_optimization);
+
     // Restore debug info
     if (!debug_info.is_null()) {
       sfi->set_script_or_debug_info(debug_info, kReleaseStore);
@@ -264,88 +318,278 @@ void CreateInterpreterDataForDeserializedCode(Isolate* isolate,
 #endif  // V8_TARGET_ARCH_ARM
 
 namespace {
-class StressOffThreadDeserializeThread final : public base::Thread {
- public:
-  explicit StressOffThreadDeserializeThread(Isolate* isolate,
-                                            const SerializedCodeData* scd)
-      : Thread(
-            base::Thread::Options("StressOffThreadDeserializeThread", 2 * MB)),
-        isolate_(isolate),
-        scd_(scd) {}
 
-  MaybeHandle<SharedFunctionInfo> maybe_result() const { return maybe_result_; }
+bool IsCacheablePrimitive(HeapObject object) {
+  return ReadOnlyHeap::Contains(object) || object.IsString() ||
+         object.IsHeapNumber() || object.IsBigInt();
+}
 
-  void Run() final {
-    LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
-    MaybeHandle<SharedFunctionInfo> local_maybe_result =
-        ObjectDeserializer::DeserializeSharedFunctionInfoOffThread(
-            &local_isolate, scd_, local_isolate.factory()->empty_string());
+// Copy-on-write arrays hold the constant elements of array literals.
+bool IsCacheableCOWArray(HeapObject object) {
+  if (object.map() != object.GetReadOnlyRoots().fixed_cow_array_map()) {
+    return false;
+  }
+  FixedArray array = FixedArray::cast(object);
+  for (int i = 0; i < array.length(); i++) {
+    Object element = array.get(i);
+    if (element.IsHeapObject() &&
+        !IsCacheablePrimitive(HeapObject::cast(element))) {
+      return false;
+    }
+  }
+  return true;
+}
 
-    maybe_result_ =
-        local_isolate.heap()->NewPersistentMaybeHandle(local_maybe_result);
+// Objects that may be embedded into cached optimized code for {script}. Like
+// the objects embedded into bytecode, these do not refer to a native context;
+// see also Code::IsNativeContextIndependent. Functions of other scripts are
+// not cached, since their scripts would be deserialized as duplicates.
+bool IsCacheableEmbeddedObject(HeapObject object, Script script) {
+  if (IsCacheablePrimitive(object)) return true;
+  if (object.IsSharedFunctionInfo()) {
+    return SharedFunctionInfo::cast(object).script() == script;
   }
+  return object.IsScopeInfo() || object.IsArrayBoilerplateDescription() ||
+         object.IsObjectBoilerplateDescription() ||
+         object.IsTemplateObjectDescription() ||
+         object.IsFixedDoubleArray() || IsCacheableCOWArray(object);
+}
 
- private:
-  Isolate* isolate_;
-  const SerializedCodeData* scd_;
-  MaybeHandle<SharedFunctionInfo> maybe_result_;
-};
-}  // namespace
+bool IsCacheableOptimizedCode(Code code, Script script) {
+  if (!CodeKindIsNativeContextIndependentJSFunction(code.kind())) return false;
+  if (code.marked_for_deoptimization()) return false;
+
+  // Code targets must be builtins, and runtime entries or wasm calls cannot be
+  // serialized at all.
+  static constexpr int kModeMask =
+      RelocInfo::ModeMask(RelocInfo::FULL_EMBEDDED_OBJECT) |
+      RelocInfo::ModeMask(RelocInfo::COMPRESSED_EMBEDDED_OBJECT) |
+      RelocInfo::ModeMask(RelocInfo::DATA_EMBEDDED_OBJECT) |
+      RelocInfo::ModeMask(RelocInfo::CODE_TARGET) |
+      RelocInfo::ModeMask(RelocInfo::RELATIVE_CODE_TARGET) |
+      RelocInfo::ModeMask(RelocInfo::RUNTIME_ENTRY) |
+      RelocInfo::ModeMask(RelocInfo::WASM_CALL) |
+      RelocInfo::ModeMask(RelocInfo::WASM_STUB_CALL);
+  for (RelocIterator it(code, kModeMask); !it.done(); it.next()) {
+    RelocInfo::Mode mode = it.rinfo()->rmode();
+    if (RelocInfo::IsEmbeddedObjectMode(mode)) {
+      if (!IsCacheableEmbeddedObject(it.rinfo()->target_object(), script)) {
+        return false;
+      }
+    } else if (RelocInfo::IsCodeTargetMode(mode)) {
+      Code target =
+          Code::GetCodeFromTargetAddress(it.rinfo()->target_address());
+      if (!target.is_builtin()) return false;
+    } else {
+      return false;
+    }
+  }
 
-MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
-    Isolate* isolate, ScriptData* cached_data, Handle<String> source,
-    ScriptOriginOptions origin_options) {
-  base::ElapsedTimer timer;
-  if (FLAG_profile_deserialization || FLAG_log_function_events) timer.Start();
+  // The deoptimizer materializes literals into the unoptimized frames.
+  DeoptimizationData data =
+      DeoptimizationData::cast(code.deoptimization_data());
+  if (data.length() == 0) return true;
+  FixedArray literals = data.LiteralArray();
+  for (int i = 0; i < literals.length(); i++) {
+    Object literal = literals.get(i);
+    if (literal.IsHeapObject() &&
+        !IsCacheableEmbeddedObject(HeapObject::cast(literal), script)) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  HandleScope scope(isolate);
+}  // namespace
 
-  SerializedCodeData::SanityCheckResult sanity_check_result =
-      SerializedCodeData::CHECK_SUCCESS;
-  const SerializedCodeData scd = SerializedCodeData::FromCachedData(
-      cached_data, SerializedCodeData::SourceHash(source, origin_options),
-      &sanity_check_result);
-  if (sanity_check_result != SerializedCodeData::CHECK_SUCCESS) {
-    if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
-    DCHECK(cached_data->rejected());
-    isolate->counters()->code_cache_reject_reason()->AddSample(
-        sanity_check_result);
-    return MaybeHandle<SharedFunctionInfo>();
+// static
+Handle<HeapObject> CodeSerializer::CollectCachedOptimizedCode(
+    Isolate* isolate, Handle<SharedFunctionInfo> toplevel) {
+  DCHECK(FLAG_turbo_nci_code_cache);
+  Handle<Script> script(Script::cast(toplevel->script()), isolate);
+
+  std::vector<Handle<SharedFunctionInfo>> shareds;
+  std::vector<Handle<Code>> codes;
+  {
+    SharedFunctionInfo::ScriptIterator it(isolate, *script);
+    for (SharedFunctionInfo info = it.Next(); !info.is_null();
+         info = it.Next()) {
+      if (!info.may_have_cached_code() || !info.is_compiled()) continue;
+      Handle<SharedFunctionInfo> shared(info, isolate);
+      Handle<Code> code;
+      if (!shared->TryGetCachedCode(isolate).ToHandle(&code)) continue;
+      if (!IsCacheableOptimizedCode(*code, *script)) continue;
+      shareds.push_back(shared);
+      codes.push_back(code);
+    }
+  }
+  if (codes.empty()) return toplevel;
+
+  // Compilation dependencies are recorded on the objects depended upon, so
+  // walk the heap to find them. Only protector cells can be re-validated in
+  // another isolate, since they are roots; code depending on maps or
+  // allocation sites is not cached.
+  std::vector<std::vector<int>> protectors(codes.size());
+  std::vector<bool> rejected(codes.size(), false);
+  {
+    RootIndexMap root_index_map(isolate);
+    HeapObjectIterator iterator(isolate->heap());
+    std::unordered_map<Address, size_t> index_of;
+    for (size_t i = 0; i < codes.size(); i++) {
+      index_of[codes[i]->ptr()] = i;
+    }
+    for (HeapObject obj = iterator.Next(); !obj.is_null();
+         obj = iterator.Next()) {
+      DependentCode dependent_code;
+      if (obj.IsMap()) {
+        dependent_code = Map::cast(obj).dependent_code();
+      } else if (obj.IsPropertyCell()) {
+        dependent_code = PropertyCell::cast(obj).dependent_code();
+      } else if (obj.IsAllocationSite()) {
+        dependent_code = AllocationSite::cast(obj).dependent_code();
+      } else {
+        continue;
+      }
+      RootIndex root_index = RootIndex::kFirstRoot;
+      bool is_protector = obj.IsPropertyCell() &&
+                          root_index_map.Lookup(obj, &root_index);
+      for (; dependent_code.length() > 0;
+           dependent_code = dependent_code.next_link()) {
+        for (int i = 0; i < dependent_code.count(); i++) {
+          HeapObject target;
+          if (!dependent_code.object_at(i)->GetHeapObjectIfWeak(&target)) {
+            continue;
+          }
+          auto entry = index_of.find(target.ptr());
+          if (entry == index_of.end()) continue;
+          if (is_protector &&
+              dependent_code.group() ==
+                  DependentCode::kPropertyCellChangedGroup) {
+            protectors[entry->second].push_back(static_cast<int>(root_index));
+          } else {
+            rejected[entry->second] = true;
+          }
+        }
+      }
+    }
   }
 
-  // Deserialize.
-  MaybeHandle<SharedFunctionInfo> maybe_result;
-  // TODO(leszeks): Add LocalHeap support to deserializer
-  if (false && FLAG_stress_background_compile) {
-    StressOffThreadDeserializeThread thread(isolate, &scd);
-    CHECK(thread.Start());
-    thread.Join();
+  Handle<FixedArray> list = isolate->factory()->NewFixedArray(
+      kFirstCachedCodeIndex + static_cast<int>(codes.size()) *
+                                  kCachedCodeEntrySize);
+  list->set(kToplevelIndex, *toplevel);
+  int index = kFirstCachedCodeIndex;
+  for (size_t i = 0; i < codes.size(); i++) {
+    if (rejected[i]) continue;
+    Handle<FixedArray> cells = isolate->factory()->NewFixedArray(
+        static_cast<int>(protectors[i].size()));
+    for (size_t j = 0; j < protectors[i].size(); j++) {
+      cells->set(static_cast<int>(j), Smi::FromInt(protectors[i][j]));
+    }
+    list->set(index + kCachedCodeSharedIndex, *shareds[i]);
+    list->set(index + kCachedCodeCodeIndex, *codes[i]);
+    list->set(index + kCachedCodeProtectorsIndex, *cells);
+    index += kCachedCodeEntrySize;
+  }
+  if (index == kFirstCachedCodeIndex) return toplevel;
+  return FixedArray::ShrinkOrEmpty(isolate, list, index);
+}
 
-    maybe_result = thread.maybe_result();
+// static
+Handle<SharedFunctionInfo> CodeSerializer::InstallCachedOptimizedCode(
+    Isolate* isolate, Handle<HeapObject> root) {
+  if (root->IsSharedFunctionInfo()) {
+    return Handle<SharedFunctionInfo>::cast(root);
+  }
+  Handle<FixedArray> list = Handle<FixedArray>::cast(root);
+  Handle<SharedFunctionInfo> toplevel(
+      SharedFunctionInfo::cast(list->get(kToplevelIndex)), isolate);
+
+  // Deoptimization finds optimized code through the optimized code lists of
+  // native contexts, so the code can only be used if there is one to put it
+  // on.
+  bool has_native_context = !isolate->context().is_null();
+  for (int i = kFirstCachedCodeIndex; i < list->length();
+       i += kCachedCodeEntrySize) {
+    Handle<SharedFunctionInfo> shared(
+        SharedFunctionInfo::cast(list->get(i + kCachedCodeSharedIndex)),
+        isolate);
+    Handle<Code> code(Code::cast(list->get(i + kCachedCodeCodeIndex)),
+                      isolate);
+    Handle<FixedArray> cells(
+        FixedArray::cast(list->get(i + kCachedCodeProtectorsIndex)), isolate);
+
+    bool valid = has_native_context;
+    for (int j = 0; valid && j < cells->length(); j++) {
+      int index = Smi::ToInt(cells->get(j));
+      if (index < 0 || index >= static_cast<int>(RootIndex::kRootListLength)) {
+        valid = false;
+        continue;
+      }
+      Object cell = isolate->root(static_cast<RootIndex>(index));
+      valid = cell.IsPropertyCell() &&
+              PropertyCell::cast(cell).value() ==
+                  Smi::FromInt(Protectors::kProtectorValid);
+    }
+    if (!valid) {
+      // Fall back to recompiling when the function gets hot.
+      shared->set_may_have_cached_code(false);
+      continue;
+    }
 
-    // Fix-up result script source.
-    Handle<SharedFunctionInfo> result;
-    if (maybe_result.ToHandle(&result)) {
-      Script::cast(result->script()).set_source(*source);
+    for (int j = 0; j < cells->length(); j++) {
+      RootIndex index = static_cast<RootIndex>(Smi::ToInt(cells->get(j)));
+      Handle<PropertyCell> cell(PropertyCell::cast(isolate->root(index)),
+                                isolate);
+      DependentCode::InstallDependency(
+          isolate, MaybeObjectHandle::Weak(code), cell,
+          DependentCode::kPropertyCellChangedGroup);
+    }
+    isolate->native_context()->AddOptimizedCode(*code);
+    isolate->compilation_cache()->PutCode(shared, code);
+    shared->set_may_have_cached_code(true);
+    if (FLAG_trace_turbo_nci) {
+      CompilationCacheCode::TraceInsertion(shared, code);
     }
-  } else {
-    maybe_result = ObjectDeserializer::DeserializeSharedFunctionInfo(
-        isolate, &scd, source);
   }
+  return toplevel;
+}
 
-  Handle<SharedFunctionInfo> result;
-  if (!maybe_result.ToHandle(&result)) {
-    // Deserializing may fail if the reservations cannot be fulfilled.
-    if (FLAG_profile_deserialization) PrintF("[Deserializing failed]\n");
-    return MaybeHandle<SharedFunctionInfo>();
+namespace {
+class StressOffThreadDeserializeThread final : public base::Thread {
+ public:
+  explicit StressOffThreadDeserializeThread(Isolate* isolate,
+                                            ScriptData* cached_data)
+      : Thread(
+            base::Thread::Options("StressOffThreadDeserializeThread", 2 * MB)),
+        isolate_(isolate),
+        cached_data_(cached_data) {}
+
+  void Run() final {
+    LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(&local_isolate);
+    LocalHandleScope handle_scope(&local_isolate);
+    off_thread_data_ =
+        CodeSerializer::StartDeserializeOffThread(&local_isolate, cached_data_);
   }
 
-  if (FLAG_profile_deserialization) {
-    double ms = timer.Elapsed().InMillisecondsF();
-    int length = cached_data->length();
-    PrintF("[Deserializing from %d bytes took %0.3f ms]\n", length, ms);
+  MaybeHandle<SharedFunctionInfo> Finalize(Isolate* isolate,
+                                           Handle<String> source,
+                                           ScriptOriginOptions origin_options) {
+    return CodeSerializer::FinishOffThreadDeserialize(
+        isolate, std::move(off_thread_data_), cached_data_, source,
+        origin_options);
   }
 
+ private:
+  Isolate* isolate_;
+  ScriptData* cached_data_;
+  CodeSerializer::OffThreadDeserializeData off_thread_data_;
+};
+
+void FinalizeDeserialization(Isolate* isolate,
+                             Handle<SharedFunctionInfo> result,
+                             const base::ElapsedTimer& timer) {
   const bool log_code_creation =
       isolate->logger()->is_listening_to_code_events() ||
       isolate->is_profiling() ||
@@ -405,6 +649,162 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     Handle<Script> script(Script::cast(result->script()), isolate);
     Script::InitLineEnds(isolate, script);
   }
+}
+
+}  // namespace
+
+MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
+    Isolate* isolate, ScriptData* cached_data, Handle<String> source,
+    ScriptOriginOptions origin_options) {
+  if (FLAG_stress_background_compile && !FLAG_turbo_nci_code_cache) {
+    StressOffThreadDeserializeThread thread(isolate, cached_data);
+    CHECK(thread.Start());
+    {
+      ParkedScope parked_scope(isolate->main_thread_local_isolate());
+      thread.Join();
+    }
+    return thread.Finalize(isolate, source, origin_options);
+  }
+
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization || FLAG_log_function_events) timer.Start();
+
+  HandleScope scope(isolate);
+
+  SerializedCodeData::SanityCheckResult sanity_check_result =
+      SerializedCodeData::CHECK_SUCCESS;
+  const SerializedCodeData scd = SerializedCodeData::FromCachedData(
+      cached_data, SerializedCodeData::SourceHash(source, origin_options),
+      &sanity_check_result);
+  if (sanity_check_result != SerializedCodeData::CHECK_SUCCESS) {
+    if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
+    DCHECK(cached_data->rejected());
+    isolate->counters()->code_cache_reject_reason()->AddSample(
+        sanity_check_result);
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+
+  // Deserialize.
+  MaybeHandle<SharedFunctionInfo> maybe_result =
+      ObjectDeserializer::DeserializeSharedFunctionInfo(isolate, &scd, source);
+
+  Handle<SharedFunctionInfo> result;
+  if (!maybe_result.ToHandle(&result)) {
+    // Deserializing may fail if the reservations cannot be fulfilled.
+    if (FLAG_profile_deserialization) PrintF("[Deserializing failed]\n");
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = cached_data->length();
+    PrintF("[Deserializing from %d bytes took %0.3f ms]\n", length, ms);
+  }
+
+  FinalizeDeserialization(isolate, result, timer);
+
+  return scope.CloseAndEscape(result);
+}
+
+CodeSerializer::OffThreadDeserializeData
+CodeSerializer::StartDeserializeOffThread(LocalIsolate* local_isolate,
+                                          ScriptData* cached_data) {
+  OffThreadDeserializeData result;
+
+  // Code objects can only be allocated on the main thread.
+  DCHECK(!FLAG_turbo_nci_code_cache);
+
+  const SerializedCodeData scd =
+      SerializedCodeData::FromCachedDataWithoutSource(
+          cached_data, &result.sanity_check_result);
+  if (result.sanity_check_result != SerializedCodeData::CHECK_SUCCESS) {
+    // Exit early but don't report yet, we'll re-check this when finishing on
+    // the main thread.
+    DCHECK(cached_data->rejected());
+    return result;
+  }
+
+  MaybeHandle<SharedFunctionInfo> local_maybe_result =
+      OffThreadObjectDeserializer::DeserializeSharedFunctionInfo(
+          local_isolate, &scd, &result.scripts);
+
+  result.maybe_result =
+      local_isolate->heap()->NewPersistentMaybeHandle(local_maybe_result);
+  result.persistent_handles = local_isolate->heap()->DetachPersistentHandles();
+
+  return result;
+}
+
+MaybeHandle<SharedFunctionInfo> CodeSerializer::FinishOffThreadDeserialize(
+    Isolate* isolate, OffThreadDeserializeData&& data, ScriptData* cached_data,
+    Handle<String> source, ScriptOriginOptions origin_options) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization || FLAG_log_function_events) timer.Start();
+
+  HandleScope scope(isolate);
+
+  // Do a source sanity check now that we have the source. It's important for
+  // FromPartiallySanityCheckedCachedData call that the sanity_check_result
+  // holds the result of the off-thread sanity check.
+  SerializedCodeData::SanityCheckResult sanity_check_result =
+      data.sanity_check_result;
+  const SerializedCodeData scd =
+      SerializedCodeData::FromPartiallySanityCheckedCachedData(
+          cached_data, SerializedCodeData::SourceHash(source, origin_options),
+          &sanity_check_result);
+  if (sanity_check_result != SerializedCodeData::CHECK_SUCCESS) {
+    // The only case where the deserialization result could exist despite a
+    // check failure is on a source mismatch, since we can't test for this
+    // off-thread.
+    DCHECK_IMPLIES(!data.maybe_result.is_null(),
+                   sanity_check_result == SerializedCodeData::SOURCE_MISMATCH);
+    if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
+    DCHECK(cached_data->rejected());
+    isolate->counters()->code_cache_reject_reason()->AddSample(
+        sanity_check_result);
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+
+  Handle<SharedFunctionInfo> result;
+  if (!data.maybe_result.ToHandle(&result)) {
+    // Deserializing may fail if the reservations cannot be fulfilled.
+    if (FLAG_profile_deserialization) {
+      PrintF("[Off-thread deserializing failed]\n");
+    }
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+
+  // Change the result persistent handle into a regular handle.
+  DCHECK(data.persistent_handles->Contains(result.location()));
+  result = handle(*result, isolate);
+
+  // Attach the source to the deserialized scripts and register them with the
+  // isolate, which could not be done off-thread.
+  DCHECK_EQ(data.scripts.size(), 1);
+  for (Handle<Script> script : data.scripts) {
+    DCHECK(data.persistent_handles->Contains(script.location()));
+    DCHECK_EQ(script->source(), ReadOnlyRoots(isolate).empty_string());
+    script->set_source(*source);
+    // Assign a new script id to avoid collision.
+    script->set_id(isolate->GetNextScriptId());
+    LOG(isolate,
+        ScriptEvent(Logger::ScriptEventType::kDeserialize, script->id()));
+    LOG(isolate, ScriptDetails(*script));
+    Handle<WeakArrayList> list = isolate->factory()->script_list();
+    list = WeakArrayList::AddToEnd(isolate, list,
+                                   MaybeObjectHandle::Weak(script));
+    isolate->heap()->SetRootScriptList(*list);
+  }
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = cached_data->length();
+    PrintF("[Finishing off-thread deserialize from %d bytes took %0.3f ms]\n",
+           length, ms);
+  }
+
+  FinalizeDeserialization(isolate, result, timer);
+
   return scope.CloseAndEscape(result);
 }
 
@@ -441,16 +841,28 @@ SerializedCodeData::SerializedCodeData(const std::vector<byte>* payload,
 
 SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
     uint32_t expected_source_hash) const {
+  SanityCheckResult result = SanityCheckWithoutSource();
+  if (result != CHECK_SUCCESS) return result;
+  return SanityCheckJustSource(expected_source_hash);
+}
+
+SerializedCodeData::SanityCheckResult
+SerializedCodeData::SanityCheckJustSource(uint32_t expected_source_hash) const {
+  uint32_t source_hash = GetHeaderValue(kSourceHashOffset);
+  if (source_hash != expected_source_hash) return SOURCE_MISMATCH;
+  return CHECK_SUCCESS;
+}
+
+SerializedCodeData::SanityCheckResult
+SerializedCodeData::SanityCheckWithoutSource() const {
   if (this->size_ < kHeaderSize) return INVALID_HEADER;
   uint32_t magic_number = GetMagicNumber();
   if (magic_number != kMagicNumber) return MAGIC_NUMBER_MISMATCH;
   uint32_t version_hash = GetHeaderValue(kVersionHashOffset);
-  uint32_t source_hash = GetHeaderValue(kSourceHashOffset);
   uint32_t flags_hash = GetHeaderValue(kFlagHashOffset);
   uint32_t payload_length = GetHeaderValue(kPayloadLengthOffset);
   uint32_t c = GetHeaderValue(kChecksumOffset);
   if (version_hash != Version::Hash()) return VERSION_MISMATCH;
-  if (source_hash != expected_source_hash) return SOURCE_MISMATCH;
   if (flags_hash != FlagList::Hash()) return FLAGS_MISMATCH;
   uint32_t max_payload_length = this->size_ - kHeaderSize;
   if (payload_length > max_payload_length) return LENGTH_MISMATCH;
@@ -503,5 +915,43 @@ SerializedCodeData SerializedCodeData::FromCachedData(
   return scd;
 }
 
+SerializedCodeData SerializedCodeData::FromCachedDataWithoutSource(
+    ScriptData* cached_data, SanityCheckResult* rejection_result) {
+  DisallowGarbageCollection no_gc;
+  SerializedCodeData scd(cached_data);
+  *rejection_result = scd.SanityCheckWithoutSource();
+  if (*rejection_result != CHECK_SUCCESS) {
+    cached_data->Reject();
+    return SerializedCodeData(nullptr, 0);
+  }
+  return scd;
+}
+
+SerializedCodeData SerializedCodeData::FromPartiallySanityCheckedCachedData(
+    ScriptData* cached_data, uint32_t expected_source_hash,
+    SanityCheckResult* rejection_result) {
+  DisallowGarbageCollection no_gc;
+  // The previous call to FromCachedDataWithoutSource may have already rejected
+  // the cached data, so re-use the previous rejection result if it's not a
+  // success.
+  if (*rejection_result != CHECK_SUCCESS) {
+    // FromCachedDataWithoutSource doesn't check the source, so there can't be
+    // a source mismatch.
+    DCHECK_NE(*rejection_result, SOURCE_MISMATCH);
+    cached_data->Reject();
+    return SerializedCodeData(nullptr, 0);
+  }
+  SerializedCodeData scd(cached_data);
+  *rejection_result = scd.SanityCheckJustSource(expected_source_hash);
+  if (*rejection_result != CHECK_SUCCESS) {
+    // This check only checks the source, so the only possible failure is a
+    // source mismatch.
+    DCHECK_EQ(*rejection_result, SOURCE_MISMATCH);
+    cached_data->Reject();
+    return SerializedCodeData(nullptr, 0);
+  }
+  return scd;
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -6,6 +6,7 @@
 #define V8_SNAPSHOT_CODE_SERIALIZER_H_
 
 #include "src/base/macros.h"
+#include "src/handles/persistent-handles.h"
 #include "src/snapshot/serializer.h"
 #include "src/snapshot/snapshot-data.h"
 
@@ -57,6 +58,27 @@ class CodeSerializer : public Serializer {
       Isolate* isolate, ScriptData* cached_data, Handle<String> source,
       ScriptOriginOptions origin_options);
 
+  // Off-thread deserialization is split in two: StartDeserializeOffThread runs
+  // on a background thread and checks everything but the source hash, and
+  // FinishOffThreadDeserialize checks the source on the main thread, attaches
+  // it to the deserialized script and registers that script with the isolate.
+  struct OffThreadDeserializeData;
+
+  V8_WARN_UNUSED_RESULT static OffThreadDeserializeData
+  StartDeserializeOffThread(LocalIsolate* isolate, ScriptData* cached_data);
+
+  V8_WARN_UNUSED_RESULT static MaybeHandle<SharedFunctionInfo>
+  FinishOffThreadDeserialize(Isolate* isolate, OffThreadDeserializeData&& data,
+                             ScriptData* cached_data, Handle<String> source,
+                             ScriptOriginOptions origin_options);
+
+  // With --turbo-nci-code-cache the deserialized root is a list holding the
+  // toplevel SharedFunctionInfo followed by cached native context independent
+  // code. Re-validates the code's dependencies, inserts the valid code into
+  // the compilation cache and returns the toplevel SharedFunctionInfo.
+  static Handle<SharedFunctionInfo> InstallCachedOptimizedCode(
+      Isolate* isolate, Handle<HeapObject> root);
+
   uint32_t source_hash() const { return source_hash_; }
 
  protected:
@@ -67,6 +89,22 @@ class CodeSerializer : public Serializer {
   void SerializeGeneric(Handle<HeapObject> heap_object);
 
  private:
+  // Layout of the root list built by CollectCachedOptimizedCode: the
+  // toplevel SharedFunctionInfo, then one entry per cached Code object.
+  static const int kToplevelIndex = 0;
+  static const int kFirstCachedCodeIndex = 1;
+  static const int kCachedCodeSharedIndex = 0;
+  static const int kCachedCodeCodeIndex = 1;
+  static const int kCachedCodeProtectorsIndex = 2;
+  static const int kCachedCodeEntrySize = 3;
+
+  // Returns the object to use as serialization root: {toplevel} itself, or
+  // a list as described above if there is cacheable optimized code.
+  static Handle<HeapObject> CollectCachedOptimizedCode(
+      Isolate* isolate, Handle<SharedFunctionInfo> toplevel);
+
+  ScriptData* SerializeObjectGraph(Handle<HeapObject> root);
+
   void SerializeObjectImpl(Handle<HeapObject> o) override;
 
   bool SerializeReadOnlyObject(Handle<HeapObject> obj);
@@ -109,6 +147,11 @@ class SerializedCodeData : public SerializedData {
   static SerializedCodeData FromCachedData(ScriptData* cached_data,
                                            uint32_t expected_source_hash,
                                            SanityCheckResult* rejection_result);
+  static SerializedCodeData FromCachedDataWithoutSource(
+      ScriptData* cached_data, SanityCheckResult* rejection_result);
+  static SerializedCodeData FromPartiallySanityCheckedCachedData(
+      ScriptData* cached_data, uint32_t expected_source_hash,
+      SanityCheckResult* rejection_result);
 
   // Used when producing.
   SerializedCodeData(const std::vector<byte>* payload,
@@ -132,6 +175,18 @@ class SerializedCodeData : public SerializedData {
   }
 
   SanityCheckResult SanityCheck(uint32_t expected_source_hash) const;
+  SanityCheckResult SanityCheckWithoutSource() const;
+  SanityCheckResult SanityCheckJustSource(uint32_t expected_source_hash) const;
+};
+
+struct CodeSerializer::OffThreadDeserializeData {
+ private:
+  friend class CodeSerializer;
+  MaybeHandle<SharedFunctionInfo> maybe_result;
+  std::vector<Handle<Script>> scripts;
+  std::unique_ptr<PersistentHandles> persistent_handles;
+  SerializedCodeData::SanityCheckResult sanity_check_result =
+      SerializedCodeData::CHECK_SUCCESS;
 };
 
 }  // namespace internal
@@ -11,9 +11,11 @@
 #include "src/common/external-pointer.h"
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
+#include "src/execution/local-isolate-inl.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap-write-barrier-inl.h"
 #include "src/heap/heap-write-barrier.h"
+#include "src/heap/local-heap-inl.h"
 #include "src/heap/read-only-heap.h"
 #include "src/interpreter/interpreter.h"
 #include "src/logging/log.h"
@@ -150,9 +152,10 @@ class SlotAccessorForRootSlots {
 
 // A SlotAccessor for creating a Handle, which saves a Handle allocation when
 // a Handle already exists.
+template <typename IsolateT>
 class SlotAccessorForHandle {
  public:
-  SlotAccessorForHandle(Handle<HeapObject>* handle, Isolate* isolate)
+  SlotAccessorForHandle(Handle<HeapObject>* handle, IsolateT* isolate)
       : handle_(handle), isolate_(isolate) {}
 
   MaybeObjectSlot slot() const { UNREACHABLE(); }
@@ -186,35 +189,54 @@ class SlotAccessorForHandle {
 
  private:
   Handle<HeapObject>* handle_;
-  Isolate* isolate_;
+  IsolateT* isolate_;
 };
 
+template <typename IsolateT>
 template <typename TSlot>
-int Deserializer::WriteAddress(TSlot dest, Address value) {
+int Deserializer<IsolateT>::WriteAddress(TSlot dest, Address value) {
   DCHECK(!next_reference_is_weak_);
   base::Memcpy(dest.ToVoidPtr(), &value, kSystemPointerSize);
   STATIC_ASSERT(IsAligned(kSystemPointerSize, TSlot::kSlotDataSize));
   return (kSystemPointerSize / TSlot::kSlotDataSize);
 }
 
+template <typename IsolateT>
 template <typename TSlot>
-int Deserializer::WriteExternalPointer(TSlot dest, Address value,
-                                       ExternalPointerTag tag) {
+int Deserializer<IsolateT>::WriteExternalPointer(TSlot dest, Address value,
+                                                 ExternalPointerTag tag) {
   DCHECK(!next_reference_is_weak_);
-  InitExternalPointerField(dest.address(), isolate(), value, tag);
+  InitExternalPointerField(dest.address(), main_thread_isolate(), value, tag);
   STATIC_ASSERT(IsAligned(kExternalPointerSize, TSlot::kSlotDataSize));
   return (kExternalPointerSize / TSlot::kSlotDataSize);
 }
 
-Deserializer::Deserializer(Isolate* isolate, Vector<const byte> payload,
-                           uint32_t magic_number, bool deserializing_user_code,
-                           bool can_rehash)
+namespace {
+Isolate* GetMainThreadIsolate(Isolate* isolate) { return isolate; }
+Isolate* GetMainThreadIsolate(LocalIsolate* isolate) {
+  return isolate->GetMainThreadIsolateUnsafe();
+}
+}  // namespace
+
+template <typename IsolateT>
+Isolate* Deserializer<IsolateT>::main_thread_isolate() const {
+  return GetMainThreadIsolate(isolate_);
+}
+
+template <typename IsolateT>
+Deserializer<IsolateT>::Deserializer(IsolateT* isolate,
+                                     Vector<const byte> payload,
+                                     uint32_t magic_number,
+                                     bool deserializing_user_code,
+                                     bool can_rehash)
     : isolate_(isolate),
       source_(payload),
       magic_number_(magic_number),
       deserializing_user_code_(deserializing_user_code),
       can_rehash_(can_rehash) {
   DCHECK_NOT_NULL(isolate);
+  DCHECK_IMPLIES((std::is_same<IsolateT, LocalIsolate>::value),
+                 deserializing_user_code);
   isolate_->RegisterDeserializerStarted();
 
   // We start the indices here at 1, so that we can distinguish between an
@@ -228,10 +250,14 @@ Deserializer::Deserializer(Isolate* isolate, Vector<const byte> payload,
   // The read-only deserializer is run by read-only heap set-up before the
   // heap is fully set up. External reference table relies on a few parts of
   // this set-up (like old-space), so it may be uninitialized at this point.
-  if (isolate->isolate_data()->external_reference_table()->is_initialized()) {
+  Isolate* main_isolate = main_thread_isolate();
+  if (main_isolate->isolate_data()
+          ->external_reference_table()
+          ->is_initialized()) {
     // Count the number of external references registered through the API.
-    if (isolate->api_external_references() != nullptr) {
-      while (isolate->api_external_references()[num_api_references_] != 0) {
+    if (main_isolate->api_external_references() != nullptr) {
+      while (main_isolate->api_external_references()[num_api_references_] !=
+             0) {
         num_api_references_++;
       }
     }
@@ -240,14 +266,18 @@ Deserializer::Deserializer(Isolate* isolate, Vector<const byte> payload,
   CHECK_EQ(magic_number_, SerializedData::kMagicNumber);
 }
 
-void Deserializer::Rehash() {
+template <typename IsolateT>
+void Deserializer<IsolateT>::Rehash() {
   DCHECK(can_rehash() || deserializing_user_code());
+  // User code only contains objects that are rehashed in place, which is
+  // safe to do off-thread on objects that are not yet published.
   for (Handle<HeapObject> item : to_rehash_) {
-    item->RehashBasedOnMap(isolate());
+    item->RehashBasedOnMap(main_thread_isolate());
   }
 }
 
-Deserializer::~Deserializer() {
+template <typename IsolateT>
+Deserializer<IsolateT>::~Deserializer() {
 #ifdef DEBUG
   // Do not perform checks if we aborted deserialization.
   if (source_.position() == 0) return;
@@ -262,33 +292,40 @@ Deserializer::~Deserializer() {
 
 // This is called on the roots.  It is the driver of the deserialization
 // process.  It is also called on the body of each function.
-void Deserializer::VisitRootPointers(Root root, const char* description,
-                                     FullObjectSlot start, FullObjectSlot end) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::VisitRootPointers(Root root,
+                                               const char* description,
+                                               FullObjectSlot start,
+                                               FullObjectSlot end) {
   ReadData(FullMaybeObjectSlot(start), FullMaybeObjectSlot(end));
 }
 
-void Deserializer::Synchronize(VisitorSynchronization::SyncTag tag) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::Synchronize(VisitorSynchronization::SyncTag tag) {
   static const byte expected = kSynchronize;
   CHECK_EQ(expected, source_.Get());
 }
 
-void Deserializer::DeserializeDeferredObjects() {
+template <typename IsolateT>
+void Deserializer<IsolateT>::DeserializeDeferredObjects() {
   for (int code = source_.Get(); code != kSynchronize; code = source_.Get()) {
     SnapshotSpace space = NewObject::Decode(code);
     ReadObject(space);
   }
 }
 
-void Deserializer::LogNewMapEvents() {
+template <typename IsolateT>
+void Deserializer<IsolateT>::LogNewMapEvents() {
   DisallowGarbageCollection no_gc;
   for (Handle<Map> map : new_maps_) {
     DCHECK(FLAG_log_maps);
-    LOG(isolate(), MapCreate(*map));
-    LOG(isolate(), MapDetails(*map));
+    LOG(main_thread_isolate(), MapCreate(*map));
+    LOG(main_thread_isolate(), MapDetails(*map));
   }
 }
 
-void Deserializer::WeakenDescriptorArrays() {
+template <typename IsolateT>
+void Deserializer<IsolateT>::WeakenDescriptorArrays() {
   DisallowGarbageCollection no_gc;
   for (Handle<DescriptorArray> descriptor_array : new_descriptor_arrays_) {
     DCHECK(descriptor_array->IsStrongDescriptorArray());
@@ -298,11 +335,12 @@ void Deserializer::WeakenDescriptorArrays() {
   }
 }
 
-void Deserializer::LogScriptEvents(Script script) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::LogScriptEvents(Script script) {
   DisallowGarbageCollection no_gc;
-  LOG(isolate(),
+  LOG(main_thread_isolate(),
       ScriptEvent(Logger::ScriptEventType::kDeserialize, script.id()));
-  LOG(isolate(), ScriptDetails(script));
+  LOG(main_thread_isolate(), ScriptDetails(script));
 }
 
 StringTableInsertionKey::StringTableInsertionKey(Handle<String> string)
@@ -316,18 +354,28 @@ bool StringTableInsertionKey::IsMatch(Isolate* isolate, String string) {
   return string_->SlowEquals(string);
 }
 
+bool StringTableInsertionKey::IsMatch(LocalIsolate* isolate, String string) {
+  return string_->SlowEquals(string);
+}
+
 Handle<String> StringTableInsertionKey::AsHandle(Isolate* isolate) {
   return string_;
 }
 
+Handle<String> StringTableInsertionKey::AsHandle(LocalIsolate* isolate) {
+  return string_;
+}
+
 uint32_t StringTableInsertionKey::ComputeRawHashField(String string) {
   // Make sure raw_hash_field() is computed.
   string.EnsureHash();
   return string.raw_hash_field();
 }
 
-void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
-                                        SnapshotSpace space) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::PostProcessNewObject(Handle<Map> map,
+                                                  Handle<HeapObject> obj,
+                                                  SnapshotSpace space) {
   DCHECK_EQ(*map, obj->map());
   DisallowGarbageCollection no_gc;
   InstanceType instance_type = map->instance_type();
@@ -357,8 +405,12 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
       Handle<String> result =
           isolate()->string_table()->LookupKey(isolate(), &key);
 
-      if (FLAG_thin_strings && *result != *string) {
-        string->MakeThin(isolate(), *result);
+      if (std::is_same<IsolateT, LocalIsolate>::value) {
+        // Off-thread, the new string is only referenced by the backreference
+        // entry, so it is enough to redirect that to the existing string.
+        if (*result != *string) obj.PatchValue(*result);
+      } else if (FLAG_thin_strings && *result != *string) {
+        string->MakeThin(main_thread_isolate(), *result);
         // Mutate the given object handle so that the backreference entry is
         // also updated.
         obj.PatchValue(*result);
@@ -378,7 +430,11 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
   }
 
   if (InstanceTypeChecker::IsScript(instance_type)) {
-    LogScriptEvents(Script::cast(*obj));
+    // Off-thread deserialized scripts are logged once they are registered on
+    // the main thread.
+    if (std::is_same<IsolateT, Isolate>::value) {
+      LogScriptEvents(Script::cast(*obj));
+    }
   } else if (InstanceTypeChecker::IsCode(instance_type)) {
     // We flush all code pages after deserializing the startup snapshot.
     // Hence we only remember each individual code object when deserializing
@@ -401,16 +457,22 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
     call_handler_infos_.push_back(Handle<CallHandlerInfo>::cast(obj));
 #endif
   } else if (InstanceTypeChecker::IsExternalString(instance_type)) {
+    // External strings and array buffers need main thread state, but they
+    // never occur in user code, which is all that is deserialized off-thread.
+    DCHECK((std::is_same<IsolateT, Isolate>::value));
+    Isolate* main_isolate = main_thread_isolate();
     Handle<ExternalString> string = Handle<ExternalString>::cast(obj);
     uint32_t index = string->GetResourceRefForDeserialization();
     Address address =
-        static_cast<Address>(isolate()->api_external_references()[index]);
-    string->AllocateExternalPointerEntries(isolate());
-    string->set_address_as_resource(isolate(), address);
-    isolate()->heap()->UpdateExternalString(*string, 0,
-                                            string->ExternalPayloadSize());
-    isolate()->heap()->RegisterExternalString(*string);
+        static_cast<Address>(main_isolate->api_external_references()[index]);
+    string->AllocateExternalPointerEntries(main_isolate);
+    string->set_address_as_resource(main_isolate, address);
+    main_isolate->heap()->UpdateExternalString(*string, 0,
+                                               string->ExternalPayloadSize());
+    main_isolate->heap()->RegisterExternalString(*string);
   } else if (InstanceTypeChecker::IsJSDataView(instance_type)) {
+    DCHECK((std::is_same<IsolateT, Isolate>::value));
+    Isolate* main_isolate = main_thread_isolate();
     Handle<JSDataView> data_view = Handle<JSDataView>::cast(obj);
     JSArrayBuffer buffer = JSArrayBuffer::cast(data_view->buffer());
     void* backing_store = nullptr;
@@ -421,18 +483,20 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
       // a numbered reference to an already deserialized backing store.
       backing_store = backing_stores_[store_index]->buffer_start();
     }
-    data_view->AllocateExternalPointerEntries(isolate());
+    data_view->AllocateExternalPointerEntries(main_isolate);
     data_view->set_data_pointer(
-        isolate(),
+        main_isolate,
         reinterpret_cast<uint8_t*>(backing_store) + data_view->byte_offset());
   } else if (InstanceTypeChecker::IsJSTypedArray(instance_type)) {
+    DCHECK((std::is_same<IsolateT, Isolate>::value));
+    Isolate* main_isolate = main_thread_isolate();
     Handle<JSTypedArray> typed_array = Handle<JSTypedArray>::cast(obj);
     // Fixup typed array pointers.
     if (typed_array->is_on_heap()) {
       Address raw_external_pointer = typed_array->external_pointer_raw();
-      typed_array->AllocateExternalPointerEntries(isolate());
+      typed_array->AllocateExternalPointerEntries(main_isolate);
       typed_array->SetOnHeapDataPtr(
-          isolate(), HeapObject::cast(typed_array->base_pointer()),
+          main_isolate, HeapObject::cast(typed_array->base_pointer()),
           raw_external_pointer);
     } else {
       // Serializer writes backing store ref as a DataPtr() value.
@@ -442,18 +506,19 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
       auto start = backing_store
                        ? reinterpret_cast<byte*>(backing_store->buffer_start())
                        : nullptr;
-      typed_array->AllocateExternalPointerEntries(isolate());
-      typed_array->SetOffHeapDataPtr(isolate(), start,
+      typed_array->AllocateExternalPointerEntries(main_isolate);
+      typed_array->SetOffHeapDataPtr(main_isolate, start,
                                      typed_array->byte_offset());
     }
   } else if (InstanceTypeChecker::IsJSArrayBuffer(instance_type)) {
+    DCHECK((std::is_same<IsolateT, Isolate>::value));
     Handle<JSArrayBuffer> buffer = Handle<JSArrayBuffer>::cast(obj);
     // Postpone allocation of backing store to avoid triggering the GC.
     if (buffer->GetBackingStoreRefForDeserialization() != kNullRefSentinel) {
       new_off_heap_array_buffers_.push_back(buffer);
     } else {
-      buffer->AllocateExternalPointerEntries(isolate());
-      buffer->set_backing_store(isolate(), nullptr);
+      buffer->AllocateExternalPointerEntries(main_thread_isolate());
+      buffer->set_backing_store(main_thread_isolate(), nullptr);
     }
   } else if (InstanceTypeChecker::IsBytecodeArray(instance_type)) {
     // TODO(mythria): Remove these once we store the default values for these
@@ -471,7 +536,8 @@ void Deserializer::PostProcessNewObject(Handle<Map> map, Handle<HeapObject> obj,
                                     HeapObject::RequiredAlignment(*map)));
 }
 
-HeapObjectReferenceType Deserializer::GetAndResetNextReferenceType() {
+template <typename IsolateT>
+HeapObjectReferenceType Deserializer<IsolateT>::GetAndResetNextReferenceType() {
   HeapObjectReferenceType type = next_reference_is_weak_
                                      ? HeapObjectReferenceType::WEAK
                                      : HeapObjectReferenceType::STRONG;
@@ -479,7 +545,8 @@ HeapObjectReferenceType Deserializer::GetAndResetNextReferenceType() {
   return type;
 }
 
-Handle<HeapObject> Deserializer::GetBackReferencedObject() {
+template <typename IsolateT>
+Handle<HeapObject> Deserializer<IsolateT>::GetBackReferencedObject() {
   Handle<HeapObject> obj = back_refs_[source_.GetInt()];
 
   // We don't allow ThinStrings in backreferences -- if internalization produces
@@ -491,15 +558,17 @@ Handle<HeapObject> Deserializer::GetBackReferencedObject() {
   return obj;
 }
 
-Handle<HeapObject> Deserializer::ReadObject() {
+template <typename IsolateT>
+Handle<HeapObject> Deserializer<IsolateT>::ReadObject() {
   Handle<HeapObject> ret;
-  CHECK_EQ(ReadSingleBytecodeData(source_.Get(),
-                                  SlotAccessorForHandle(&ret, isolate())),
+  CHECK_EQ(ReadSingleBytecodeData(
+               source_.Get(), SlotAccessorForHandle<IsolateT>(&ret, isolate())),
            1);
   return ret;
 }
 
-Handle<HeapObject> Deserializer::ReadObject(SnapshotSpace space) {
+template <typename IsolateT>
+Handle<HeapObject> Deserializer<IsolateT>::ReadObject(SnapshotSpace space) {
   const int size_in_tagged = source_.GetInt();
   const int size_in_bytes = size_in_tagged * kTaggedSize;
 
@@ -583,7 +652,8 @@ Handle<HeapObject> Deserializer::ReadObject(SnapshotSpace space) {
   return obj;
 }
 
-Handle<HeapObject> Deserializer::ReadMetaMap() {
+template <typename IsolateT>
+Handle<HeapObject> Deserializer<IsolateT>::ReadMetaMap() {
   const SnapshotSpace space = SnapshotSpace::kReadOnlyHeap;
   const int size_in_bytes = Map::kSize;
   const int size_in_tagged = size_in_bytes / kTaggedSize;
@@ -605,9 +675,10 @@ Handle<HeapObject> Deserializer::ReadMetaMap() {
   return obj;
 }
 
-class Deserializer::RelocInfoVisitor {
+template <typename IsolateT>
+class Deserializer<IsolateT>::RelocInfoVisitor {
  public:
-  RelocInfoVisitor(Deserializer* deserializer,
+  RelocInfoVisitor(Deserializer<IsolateT>* deserializer,
                    const std::vector<Handle<HeapObject>>* objects)
       : deserializer_(deserializer), objects_(objects), current_object_(0) {}
   ~RelocInfoVisitor() { DCHECK_EQ(current_object_, objects_->size()); }
@@ -620,35 +691,40 @@ class Deserializer::RelocInfoVisitor {
   void VisitOffHeapTarget(Code host, RelocInfo* rinfo);
 
  private:
-  Isolate* isolate() { return deserializer_->isolate(); }
+  // Code objects are only deserialized on the main thread.
+  Isolate* isolate() { return deserializer_->main_thread_isolate(); }
   SnapshotByteSource& source() { return deserializer_->source_; }
 
-  Deserializer* deserializer_;
+  Deserializer<IsolateT>* deserializer_;
   const std::vector<Handle<HeapObject>>* objects_;
   int current_object_;
 };
 
-void Deserializer::RelocInfoVisitor::VisitCodeTarget(Code host,
-                                                     RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitCodeTarget(
+    Code host, RelocInfo* rinfo) {
   HeapObject object = *objects_->at(current_object_++);
   rinfo->set_target_address(Code::cast(object).raw_instruction_start());
 }
 
-void Deserializer::RelocInfoVisitor::VisitEmbeddedPointer(Code host,
-                                                          RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitEmbeddedPointer(
+    Code host, RelocInfo* rinfo) {
   HeapObject object = *objects_->at(current_object_++);
   // Embedded object reference must be a strong one.
   rinfo->set_target_object(isolate()->heap(), object);
 }
 
-void Deserializer::RelocInfoVisitor::VisitRuntimeEntry(Code host,
-                                                       RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitRuntimeEntry(
+    Code host, RelocInfo* rinfo) {
   // We no longer serialize code that contains runtime entries.
   UNREACHABLE();
 }
 
-void Deserializer::RelocInfoVisitor::VisitExternalReference(Code host,
-                                                            RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitExternalReference(
+    Code host, RelocInfo* rinfo) {
   byte data = source().Get();
   CHECK_EQ(data, kExternalReference);
 
@@ -663,8 +739,9 @@ void Deserializer::RelocInfoVisitor::VisitExternalReference(Code host,
   }
 }
 
-void Deserializer::RelocInfoVisitor::VisitInternalReference(Code host,
-                                                            RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitInternalReference(
+    Code host, RelocInfo* rinfo) {
   byte data = source().Get();
   CHECK_EQ(data, kInternalReference);
 
@@ -681,8 +758,9 @@ void Deserializer::RelocInfoVisitor::VisitInternalReference(Code host,
       rinfo->pc(), target, rinfo->rmode());
 }
 
-void Deserializer::RelocInfoVisitor::VisitOffHeapTarget(Code host,
-                                                        RelocInfo* rinfo) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::RelocInfoVisitor::VisitOffHeapTarget(
+    Code host, RelocInfo* rinfo) {
   byte data = source().Get();
   CHECK_EQ(data, kOffHeapTarget);
 
@@ -704,9 +782,10 @@ void Deserializer::RelocInfoVisitor::VisitOffHeapTarget(Code host,
   }
 }
 
+template <typename IsolateT>
 template <typename SlotAccessor>
-int Deserializer::ReadRepeatedObject(SlotAccessor slot_accessor,
-                                     int repeat_count) {
+int Deserializer<IsolateT>::ReadRepeatedObject(SlotAccessor slot_accessor,
+                                               int repeat_count) {
   CHECK_LE(2, repeat_count);
 
   Handle<HeapObject> heap_object = ReadObject();
@@ -758,8 +837,10 @@ constexpr byte VerifyBytecodeCount(byte bytecode) {
       : case SpaceEncoder<bytecode>::Encode(SnapshotSpace::kMap)  \
       : case SpaceEncoder<bytecode>::Encode(SnapshotSpace::kReadOnlyHeap)
 
-void Deserializer::ReadData(Handle<HeapObject> object, int start_slot_index,
-                            int end_slot_index) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::ReadData(Handle<HeapObject> object,
+                                      int start_slot_index,
+                                      int end_slot_index) {
   int current = start_slot_index;
   while (current < end_slot_index) {
     byte data = source_.Get();
@@ -769,8 +850,9 @@ void Deserializer::ReadData(Handle<HeapObject> object, int start_slot_index,
   CHECK_EQ(current, end_slot_index);
 }
 
-void Deserializer::ReadData(FullMaybeObjectSlot start,
-                            FullMaybeObjectSlot end) {
+template <typename IsolateT>
+void Deserializer<IsolateT>::ReadData(FullMaybeObjectSlot start,
+                                      FullMaybeObjectSlot end) {
   FullMaybeObjectSlot current = start;
   while (current < end) {
     byte data = source_.Get();
@@ -779,9 +861,10 @@ void Deserializer::ReadData(FullMaybeObjectSlot start,
   CHECK_EQ(current, end);
 }
 
+template <typename IsolateT>
 template <typename SlotAccessor>
-int Deserializer::ReadSingleBytecodeData(byte data,
-                                         SlotAccessor slot_accessor) {
+int Deserializer<IsolateT>::ReadSingleBytecodeData(byte data,
+                                                   SlotAccessor slot_accessor) {
   using TSlot = decltype(slot_accessor.slot());
 
   switch (data) {
@@ -805,11 +888,12 @@ int Deserializer::ReadSingleBytecodeData(byte data,
     // Reference an object in the read-only heap. This should be used when an
     // object is read-only, but is not a root.
     case kReadOnlyHeapRef: {
-      DCHECK(isolate()->heap()->deserialization_complete());
+      Heap* heap = main_thread_isolate()->heap();
+      DCHECK(heap->deserialization_complete());
       uint32_t chunk_index = source_.GetInt();
       uint32_t chunk_offset = source_.GetInt();
 
-      ReadOnlySpace* read_only_space = isolate()->heap()->read_only_space();
+      ReadOnlySpace* read_only_space = heap->read_only_space();
       ReadOnlyPage* page = read_only_space->pages()[chunk_index];
       Address address = page->OffsetToAddress(chunk_offset);
       HeapObject heap_object = HeapObject::FromAddress(address);
@@ -828,14 +912,25 @@ int Deserializer::ReadSingleBytecodeData(byte data,
       return slot_accessor.Write(heap_object, GetAndResetNextReferenceType());
     }
 
+    // Find a builtin by its index and write a pointer to its Code object to
+    // the current object.
+    case kBuiltinReference: {
+      DCHECK(deserializing_user_code());
+      int builtin_index = source_.GetInt();
+      CHECK(Builtins::IsBuiltinId(builtin_index));
+      Handle<HeapObject> heap_object =
+          main_thread_isolate()->builtins()->builtin_handle(builtin_index);
+      return slot_accessor.Write(heap_object, GetAndResetNextReferenceType());
+    }
+
     // Find an object in the startup object cache and write a pointer to it to
     // the current object.
     case kStartupObjectCache: {
       int cache_index = source_.GetInt();
       // TODO(leszeks): Could we use the address of the startup_object_cache
       // entry as a Handle backing?
-      HeapObject heap_object =
-          HeapObject::cast(isolate()->startup_object_cache()->at(cache_index));
+      HeapObject heap_object = HeapObject::cast(
+          main_thread_isolate()->startup_object_cache()->at(cache_index));
       return slot_accessor.Write(heap_object, GetAndResetNextReferenceType());
     }
 
@@ -1000,11 +1095,12 @@ int Deserializer::ReadSingleBytecodeData(byte data,
     }
 
     case kOffHeapBackingStore: {
-      AlwaysAllocateScope scope(isolate()->heap());
+      DCHECK((std::is_same<IsolateT, Isolate>::value));
+      AlwaysAllocateScope scope(main_thread_isolate()->heap());
       int byte_length = source_.GetInt();
-      std::unique_ptr<BackingStore> backing_store =
-          BackingStore::Allocate(isolate(), byte_length, SharedFlag::kNotShared,
-                                 InitializedFlag::kUninitialized);
+      std::unique_ptr<BackingStore> backing_store = BackingStore::Allocate(
+          main_thread_isolate(), byte_length, SharedFlag::kNotShared,
+          InitializedFlag::kUninitialized);
       CHECK_NOT_NULL(backing_store);
       source_.CopyRaw(backing_store->buffer_start(), byte_length);
       backing_stores_.push_back(std::move(backing_store));
@@ -1015,11 +1111,12 @@ int Deserializer::ReadSingleBytecodeData(byte data,
     case kApiReference: {
       uint32_t reference_id = static_cast<uint32_t>(source_.GetInt());
       Address address;
-      if (isolate()->api_external_references()) {
+      const intptr_t* api_external_references =
+          main_thread_isolate()->api_external_references();
+      if (api_external_references) {
         DCHECK_WITH_MSG(reference_id < num_api_references_,
                         "too few external references provided through the API");
-        address = static_cast<Address>(
-            isolate()->api_external_references()[reference_id]);
+        address = static_cast<Address>(api_external_references[reference_id]);
       } else {
         address = reinterpret_cast<Address>(NoExternalReferencesCallback);
       }
@@ -1110,9 +1207,11 @@ int Deserializer::ReadSingleBytecodeData(byte data,
 #undef CASE_R2
 #undef CASE_R1
 
-Address Deserializer::ReadExternalReferenceCase() {
+template <typename IsolateT>
+Address Deserializer<IsolateT>::ReadExternalReferenceCase() {
   uint32_t reference_id = static_cast<uint32_t>(source_.GetInt());
-  return isolate()->external_reference_table()->address(reference_id);
+  return main_thread_isolate()->external_reference_table()->address(
+      reference_id);
 }
 
 namespace {
@@ -1130,8 +1229,28 @@ AllocationType SpaceToType(SnapshotSpace space) {
 }
 }  // namespace
 
-HeapObject Deserializer::Allocate(SnapshotSpace space, int size,
-                                  AllocationAlignment alignment) {
+template <>
+HeapObject Deserializer<Isolate>::AllocateRaw(AllocationType allocation,
+                                              int size,
+                                              AllocationAlignment alignment) {
+  return isolate()->heap()->AllocateRawWith<Heap::kRetryOrFail>(
+      size, allocation, AllocationOrigin::kRuntime, alignment);
+}
+
+template <>
+HeapObject Deserializer<LocalIsolate>::AllocateRaw(
+    AllocationType allocation, int size, AllocationAlignment alignment) {
+  // Background threads can only allocate in old space, so user code with code
+  // objects (see --turbo-nci-code-cache) has to be deserialized on the main
+  // thread.
+  CHECK_EQ(allocation, AllocationType::kOld);
+  return HeapObject::FromAddress(isolate()->heap()->AllocateRawOrFail(
+      size, allocation, AllocationOrigin::kRuntime, alignment));
+}
+
+template <typename IsolateT>
+HeapObject Deserializer<IsolateT>::Allocate(SnapshotSpace space, int size,
+                                            AllocationAlignment alignment) {
 #ifdef DEBUG
   if (!previous_allocation_obj_.is_null()) {
     // Make sure that the previous object is initialized sufficiently to
@@ -1141,8 +1260,7 @@ HeapObject Deserializer::Allocate(SnapshotSpace space, int size,
   }
 #endif
 
-  HeapObject obj = isolate()->heap()->AllocateRawWith<Heap::kRetryOrFail>(
-      size, SpaceToType(space), AllocationOrigin::kRuntime, alignment);
+  HeapObject obj = AllocateRaw(SpaceToType(space), size, alignment);
 
 #ifdef DEBUG
   previous_allocation_obj_ = handle(obj, isolate());
@@ -1152,5 +1270,9 @@ HeapObject Deserializer::Allocate(SnapshotSpace space, int size,
   return obj;
 }
 
+template class EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE) Deserializer<Isolate>;
+template class EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE)
+    Deserializer<LocalIsolate>;
+
 }  // namespace internal
 }  // namespace v8
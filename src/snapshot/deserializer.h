@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "src/base/export-template.h"
 #include "src/common/globals.h"
 #include "src/objects/allocation-site.h"
 #include "src/objects/api-callbacks.h"
@@ -24,6 +25,7 @@ namespace v8 {
 namespace internal {
 
 class HeapObject;
+class LocalIsolate;
 class Object;
 
 // Used for platforms with embedded constant pools to trigger deserialization
@@ -38,7 +40,10 @@ class Object;
 #endif
 
 // A Deserializer reads a snapshot and reconstructs the Object graph it defines.
-class V8_EXPORT_PRIVATE Deserializer : public SerializerDeserializer {
+// Deserializing into a LocalIsolate is only supported for user code (i.e. the
+// code cache), and only for objects that live in old space.
+template <typename IsolateT>
+class Deserializer : public SerializerDeserializer {
  public:
   // Smi value for filling in not-yet initialized tagged field values with a
   // valid tagged pointer. A field value equal to this doesn't necessarily
@@ -61,7 +66,7 @@ class V8_EXPORT_PRIVATE Deserializer : public SerializerDeserializer {
 
  protected:
   // Create a deserializer from a snapshot byte source.
-  Deserializer(Isolate* isolate, Vector<const byte> payload,
+  Deserializer(IsolateT* isolate, Vector<const byte> payload,
                uint32_t magic_number, bool deserializing_user_code,
                bool can_rehash);
 
@@ -91,7 +96,11 @@ class V8_EXPORT_PRIVATE Deserializer : public SerializerDeserializer {
     CHECK_EQ(new_off_heap_array_buffers().size(), 0);
   }
 
-  Isolate* isolate() const { return isolate_; }
+  IsolateT* isolate() const { return isolate_; }
+
+  // The main thread Isolate. When deserializing into a LocalIsolate, this must
+  // only be used to access state that is immutable once the isolate is set up.
+  Isolate* main_thread_isolate() const;
 
   SnapshotByteSource* source() { return &source_; }
   const std::vector<Handle<AllocationSite>>& new_allocation_sites() const {
@@ -206,9 +215,11 @@ class V8_EXPORT_PRIVATE Deserializer : public SerializerDeserializer {
 
   HeapObject Allocate(SnapshotSpace space, int size,
                       AllocationAlignment alignment);
+  HeapObject AllocateRaw(AllocationType allocation, int size,
+                         AllocationAlignment alignment);
 
   // Cached current isolate.
-  Isolate* isolate_;
+  IsolateT* isolate_;
 
   // Objects from the attached object descriptions in the serialized user code.
   std::vector<Handle<HeapObject>> attached_objects_;
@@ -271,6 +282,7 @@ class StringTableInsertionKey final : public StringTableKey {
   explicit StringTableInsertionKey(Handle<String> string);
 
   bool IsMatch(Isolate* isolate, String string);
+  bool IsMatch(LocalIsolate* isolate, String string);
 
   V8_WARN_UNUSED_RESULT Handle<String> AsHandle(Isolate* isolate);
   V8_WARN_UNUSED_RESULT Handle<String> AsHandle(LocalIsolate* isolate);
@@ -282,6 +294,19 @@ class StringTableInsertionKey final : public StringTableKey {
   DISALLOW_GARBAGE_COLLECTION(no_gc)
 };
 
+template <>
+HeapObject Deserializer<Isolate>::AllocateRaw(AllocationType allocation,
+                                              int size,
+                                              AllocationAlignment alignment);
+template <>
+HeapObject Deserializer<LocalIsolate>::AllocateRaw(
+    AllocationType allocation, int size, AllocationAlignment alignment);
+
+extern template class EXPORT_TEMPLATE_DECLARE(V8_EXPORT_PRIVATE)
+    Deserializer<Isolate>;
+extern template class EXPORT_TEMPLATE_DECLARE(V8_EXPORT_PRIVATE)
+    Deserializer<LocalIsolate>;
+
 }  // namespace internal
 }  // namespace v8
 
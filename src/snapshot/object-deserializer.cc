@@ -5,8 +5,13 @@
 #include "src/snapshot/object-deserializer.h"
 
 #include "src/codegen/assembler-inl.h"
+#include "src/codegen/flush-instruction-cache.h"
 #include "src/execution/isolate.h"
+#include "src/execution/local-isolate-inl.h"
+#include "src/handles/local-handles-inl.h"
 #include "src/heap/heap-inl.h"
+#include "src/heap/local-factory-inl.h"
+#include "src/heap/local-heap-inl.h"
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/js-array-buffer-inl.h"
 #include "src/objects/objects.h"
@@ -29,17 +34,8 @@ ObjectDeserializer::DeserializeSharedFunctionInfo(
   d.AddAttachedObject(source);
 
   Handle<HeapObject> result;
-  return d.Deserialize().ToHandle(&result)
-             ? Handle<SharedFunctionInfo>::cast(result)
-             : MaybeHandle<SharedFunctionInfo>();
-}
-
-MaybeHandle<SharedFunctionInfo>
-ObjectDeserializer::DeserializeSharedFunctionInfoOffThread(
-    LocalIsolate* isolate, const SerializedCodeData* data,
-    Handle<String> source) {
-  // TODO(leszeks): Add LocalHeap support to deserializer
-  UNREACHABLE();
+  if (!d.Deserialize().ToHandle(&result)) return {};
+  return CodeSerializer::InstallCachedOptimizedCode(isolate, result);
 }
 
 MaybeHandle<HeapObject> ObjectDeserializer::Deserialize() {
@@ -47,9 +43,13 @@ MaybeHandle<HeapObject> ObjectDeserializer::Deserialize() {
   HandleScope scope(isolate());
   Handle<HeapObject> result;
   {
+    // Optimized code may be part of the cache with --turbo-nci-code-cache.
+    CodePageCollectionMemoryModificationScope code_allocation(
+        isolate()->heap());
     result = ReadObject();
     DeserializeDeferredObjects();
-    CHECK(new_code_objects().empty());
+    CHECK_IMPLIES(!FLAG_turbo_nci_code_cache, new_code_objects().empty());
+    FlushICache();
     LinkAllocationSites();
     CHECK(new_maps().empty());
     WeakenDescriptorArrays();
@@ -60,6 +60,14 @@ MaybeHandle<HeapObject> ObjectDeserializer::Deserialize() {
   return scope.CloseAndEscape(result);
 }
 
+void ObjectDeserializer::FlushICache() {
+  DCHECK(deserializing_user_code());
+  for (Handle<Code> code : new_code_objects()) {
+    FlushInstructionCache(code->raw_instruction_start(),
+                          code->raw_instruction_size());
+  }
+}
+
 void ObjectDeserializer::CommitPostProcessedObjects() {
   for (Handle<JSArrayBuffer> buffer : new_off_heap_array_buffers()) {
     uint32_t store_index = buffer->GetBackingStoreRefForDeserialization();
@@ -100,5 +108,49 @@ void ObjectDeserializer::LinkAllocationSites() {
   }
 }
 
+OffThreadObjectDeserializer::OffThreadObjectDeserializer(
+    LocalIsolate* isolate, const SerializedCodeData* data)
+    : Deserializer(isolate, data->Payload(), data->GetMagicNumber(), true,
+                   false) {}
+
+MaybeHandle<SharedFunctionInfo>
+OffThreadObjectDeserializer::DeserializeSharedFunctionInfo(
+    LocalIsolate* isolate, const SerializedCodeData* data,
+    std::vector<Handle<Script>>* deserialized_scripts) {
+  OffThreadObjectDeserializer d(isolate, data);
+
+  // The source is only attached on the main thread.
+  d.AddAttachedObject(isolate->factory()->empty_string());
+
+  Handle<HeapObject> result;
+  if (!d.Deserialize(deserialized_scripts).ToHandle(&result)) return {};
+  return Handle<SharedFunctionInfo>::cast(result);
+}
+
+MaybeHandle<HeapObject> OffThreadObjectDeserializer::Deserialize(
+    std::vector<Handle<Script>>* deserialized_scripts) {
+  DCHECK(deserializing_user_code());
+  LocalHandleScope scope(isolate());
+  Handle<HeapObject> result;
+  {
+    result = ReadObject();
+    DeserializeDeferredObjects();
+    CHECK(new_code_objects().empty());
+    CHECK(new_allocation_sites().empty());
+    CHECK(new_maps().empty());
+    WeakenDescriptorArrays();
+  }
+
+  Rehash();
+  CHECK(new_off_heap_array_buffers().empty());
+
+  for (Handle<Script> script : new_scripts()) {
+    deserialized_scripts->push_back(
+        isolate()->heap()->NewPersistentHandle(script));
+  }
+
+  return scope.CloseAndEscape(result);
+}
+
 }  // namespace internal
 }  // namespace v8
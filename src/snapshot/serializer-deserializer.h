@@ -80,7 +80,7 @@ class SerializerDeserializer : public RootVisitor {
 
   enum Bytecode : byte {
     //
-    // ---------- byte code range 0x00..0x1b ----------
+    // ---------- byte code range 0x00..0x1c ----------
     //
 
     // 0x00..0x03  Allocate new object, in specified space.
@@ -146,6 +146,9 @@ class SerializerDeserializer : public RootVisitor {
     // Special construction bytecode for Code object bodies, which have a more
     // complex deserialization ordering and RelocInfo processing.
     kCodeBody,
+    // Reference to a builtin Code object by its builtin index. Only used by the
+    // code serializer, which does not serialize the builtins table.
+    kBuiltinReference,
 
     //
     // ---------- byte code range 0x40..0x7f ----------
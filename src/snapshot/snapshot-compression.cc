@@ -4,7 +4,16 @@
 
 #include "src/snapshot/snapshot-compression.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "include/v8-platform.h"
+#include "src/base/memory.h"
 #include "src/base/platform/elapsed-timer.h"
+#include "src/flags/flags.h"
+#include "src/init/v8.h"
 #include "src/utils/memcopy.h"
 #include "src/utils/utils.h"
 #include "third_party/zlib/google/compression_utils_portable.h"
@@ -12,51 +21,367 @@
 namespace v8 {
 namespace internal {
 
-uint32_t GetUncompressedSize(const Bytef* compressed_data) {
-  uint32_t size;
-  MemCopy(&size, compressed_data, sizeof(size));
-  return size;
+namespace {
+
+// The compressed snapshot starts with a header of uint32_t-sized entries:
+// [0] uncompressed size
+// [1] codec
+// [2] uncompressed chunk size; every chunk but the last has this size
+// [3] chunk count
+// ... compressed size of each chunk
+// followed by the compressed chunks. Chunks are compressed independently, so
+// that they can be decompressed in parallel.
+enum Codec : uint32_t {
+  // Raw deflate, without zlib or gzip headers.
+  kZlib = 0,
+  // The LZ codec below: worse ratio, but several times faster to decompress.
+  kLZ = 1,
+};
+
+constexpr int kUncompressedSizeIndex = 0;
+constexpr int kCodecIndex = 1;
+constexpr int kChunkSizeIndex = 2;
+constexpr int kChunkCountIndex = 3;
+constexpr int kHeaderSize = 4;
+
+uint32_t GetHeaderValue(const byte* data, int index) {
+  return base::ReadUnalignedValue<uint32_t>(reinterpret_cast<Address>(data) +
+                                            index * kUInt32Size);
 }
 
+void SetHeaderValue(byte* data, int index, uint32_t value) {
+  base::WriteUnalignedValue<uint32_t>(
+      reinterpret_cast<Address>(data) + index * kUInt32Size, value);
+}
+
+const char* CodecName(uint32_t codec) {
+  return codec == kLZ ? "lz" : "zlib";
+}
+
+// A byte-oriented LZ77 codec in the style of LZ4. The compressed data is a
+// sequence of
+//   token, [literal length], literals, [offset, [match length]]
+// The high nibble of the token is the literal count, the low nibble the match
+// length minus kLZMinMatch. A nibble of 15 is followed by more length bytes,
+// which are added up until a byte other than 255. The offset is a 16-bit
+// little-endian distance back into the output. The last sequence only has
+// literals, and ends the data. Decompression is bounds-checked, so corrupt
+// data fails instead of reading or writing out of bounds.
+constexpr size_t kLZMinMatch = 4;
+constexpr size_t kLZMaxNibble = 15;
+constexpr ptrdiff_t kLZMaxOffset = 0xFFFF;
+constexpr int kLZHashBits = 14;
+constexpr size_t kLZHashTableSize = size_t{1} << kLZHashBits;
+
+class LZ : public AllStatic {
+ public:
+  static size_t MaxCompressedSize(size_t size) {
+    return size + size / 255 + 16;
+  }
+
+  // Compresses {input} into {output}, which must have room for
+  // MaxCompressedSize(input.size()) bytes, and returns the compressed size.
+  static size_t Compress(Vector<const byte> input, byte* output) {
+    const byte* const base = input.begin();
+    const byte* const end = input.end();
+    const byte* anchor = base;
+    byte* op = output;
+
+    if (input.size() >= kLZMinMatch) {
+      // Positions of the last occurrence of each hashed 4-byte sequence.
+      std::unique_ptr<uint32_t[]> table(new uint32_t[kLZHashTableSize]());
+      const byte* const match_limit = end - kLZMinMatch;
+      const byte* ip = base;
+      while (ip <= match_limit) {
+        uint32_t sequence = base::ReadUnalignedValue<uint32_t>(
+            reinterpret_cast<Address>(ip));
+        uint32_t hash = Hash(sequence);
+        const byte* candidate = base + table[hash];
+        table[hash] = static_cast<uint32_t>(ip - base);
+        if (candidate >= ip || ip - candidate > kLZMaxOffset ||
+            base::ReadUnalignedValue<uint32_t>(
+                reinterpret_cast<Address>(candidate)) != sequence) {
+          ip++;
+          continue;
+        }
+        const byte* match_end = ip + kLZMinMatch;
+        const byte* source = candidate + kLZMinMatch;
+        while (match_end < end && *match_end == *source) {
+          match_end++;
+          source++;
+        }
+        op = EmitSequence(op, anchor, ip - anchor, ip - candidate,
+                          match_end - ip);
+        ip = match_end;
+        anchor = ip;
+      }
+    }
+    if (anchor < end) op = EmitSequence(op, anchor, end - anchor, 0, 0);
+    DCHECK_LE(static_cast<size_t>(op - output),
+              MaxCompressedSize(input.size()));
+    return op - output;
+  }
+
+  // Decompresses {input} into {output}, which must be exactly the size of the
+  // uncompressed data. Returns false if the data is corrupt.
+  static bool Decompress(Vector<const byte> input, Vector<byte> output) {
+    const byte* ip = input.begin();
+    const byte* const in_end = input.end();
+    byte* op = output.begin();
+    byte* const out_end = output.end();
+    while (ip < in_end) {
+      const byte token = *ip++;
+      size_t literal_length = token >> 4;
+      if (literal_length == kLZMaxNibble &&
+          !ReadLength(&ip, in_end, &literal_length)) {
+        return false;
+      }
+      if (literal_length > static_cast<size_t>(in_end - ip) ||
+          literal_length > static_cast<size_t>(out_end - op)) {
+        return false;
+      }
+      MemCopy(op, ip, literal_length);
+      ip += literal_length;
+      op += literal_length;
+      if (ip == in_end) break;
+
+      if (in_end - ip < 2) return false;
+      size_t offset = ip[0] | (ip[1] << 8);
+      ip += 2;
+      if (offset == 0 || offset > static_cast<size_t>(op - output.begin())) {
+        return false;
+      }
+      size_t match_length = token & kLZMaxNibble;
+      if (match_length == kLZMaxNibble &&
+          !ReadLength(&ip, in_end, &match_length)) {
+        return false;
+      }
+      match_length += kLZMinMatch;
+      if (match_length > static_cast<size_t>(out_end - op)) return false;
+      const byte* match = op - offset;
+      if (offset >= match_length) {
+        MemCopy(op, match, match_length);
+        op += match_length;
+      } else {
+        // Overlapping match, which repeats the last {offset} bytes.
+        for (size_t i = 0; i < match_length; i++) *op++ = *match++;
+      }
+    }
+    return op == out_end;
+  }
+
+ private:
+  static uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kLZHashBits);
+  }
+
+  static byte* WriteLength(byte* op, size_t length) {
+    for (; length >= 255; length -= 255) *op++ = 255;
+    *op++ = static_cast<byte>(length);
+    return op;
+  }
+
+  static bool ReadLength(const byte** ip, const byte* end, size_t* length) {
+    byte value;
+    do {
+      if (*ip == end) return false;
+      value = *(*ip)++;
+      *length += value;
+    } while (value == 255);
+    return true;
+  }
+
+  // Emits {literal_length} literals followed by a match, or only the literals
+  // if {match_length} is 0.
+  static byte* EmitSequence(byte* op, const byte* literals,
+                            size_t literal_length, size_t offset,
+                            size_t match_length) {
+    byte* token = op++;
+    *token = static_cast<byte>(std::min(literal_length, kLZMaxNibble) << 4);
+    if (literal_length >= kLZMaxNibble) {
+      op = WriteLength(op, literal_length - kLZMaxNibble);
+    }
+    MemCopy(op, literals, literal_length);
+    op += literal_length;
+    if (match_length == 0) return op;
+
+    DCHECK_GE(match_length, kLZMinMatch);
+    DCHECK(offset > 0 && offset <= static_cast<size_t>(kLZMaxOffset));
+    *op++ = static_cast<byte>(offset);
+    *op++ = static_cast<byte>(offset >> 8);
+    match_length -= kLZMinMatch;
+    *token |= static_cast<byte>(std::min(match_length, kLZMaxNibble));
+    if (match_length >= kLZMaxNibble) {
+      op = WriteLength(op, match_length - kLZMaxNibble);
+    }
+    return op;
+  }
+};
+
+std::vector<byte> CompressChunk(uint32_t codec, Vector<const byte> input) {
+  std::vector<byte> output;
+  if (codec == kLZ) {
+    output.resize(LZ::MaxCompressedSize(input.size()));
+    output.resize(LZ::Compress(input, output.data()));
+    return output;
+  }
+  static_assert(sizeof(Bytef) == 1, "");
+  uLongf compressed_size = compressBound(static_cast<uLongf>(input.size()));
+  output.resize(compressed_size);
+  CHECK_EQ(zlib_internal::CompressHelper(
+               zlib_internal::ZRAW, output.data(), &compressed_size,
+               bit_cast<const Bytef*>(input.begin()),
+               static_cast<uLongf>(input.size()), Z_DEFAULT_COMPRESSION,
+               nullptr, nullptr),
+           Z_OK);
+  output.resize(compressed_size);
+  return output;
+}
+
+void DecompressChunk(uint32_t codec, Vector<const byte> input,
+                     Vector<byte> output) {
+  if (codec == kLZ) {
+    CHECK(LZ::Decompress(input, output));
+    return;
+  }
+  uLongf uncompressed_size = static_cast<uLongf>(output.size());
+  CHECK_EQ(zlib_internal::UncompressHelper(
+               zlib_internal::ZRAW, bit_cast<Bytef*>(output.begin()),
+               &uncompressed_size, bit_cast<const Bytef*>(input.begin()),
+               static_cast<uLong>(input.size())),
+           Z_OK);
+  CHECK_EQ(uncompressed_size, output.size());
+}
+
+// Chunks of a compressed snapshot, with their place in the uncompressed data.
+class ChunkList {
+ public:
+  ChunkList(Vector<const byte> compressed_data, byte* uncompressed_data)
+      : compressed_data_(compressed_data),
+        uncompressed_data_(uncompressed_data) {
+    CHECK_GE(compressed_data.size(), kHeaderSize * kUInt32Size);
+    const byte* data = compressed_data.begin();
+    uncompressed_size_ = GetHeaderValue(data, kUncompressedSizeIndex);
+    codec_ = GetHeaderValue(data, kCodecIndex);
+    chunk_size_ = GetHeaderValue(data, kChunkSizeIndex);
+    chunk_count_ = GetHeaderValue(data, kChunkCountIndex);
+    CHECK(codec_ == kZlib || codec_ == kLZ);
+    CHECK_GE(compressed_data.size(),
+             (kHeaderSize + size_t{chunk_count_}) * kUInt32Size);
+    CHECK_NE(chunk_size_, 0);
+    CHECK_EQ(chunk_count_,
+             (uint64_t{uncompressed_size_} + chunk_size_ - 1) / chunk_size_);
+    size_t offset = (kHeaderSize + size_t{chunk_count_}) * kUInt32Size;
+    compressed_offsets_.reserve(chunk_count_ + 1);
+    for (uint32_t i = 0; i < chunk_count_; i++) {
+      compressed_offsets_.push_back(offset);
+      offset += GetHeaderValue(data, kHeaderSize + i);
+    }
+    compressed_offsets_.push_back(offset);
+    CHECK_EQ(offset, compressed_data.size());
+  }
+
+  static uint32_t UncompressedSize(Vector<const byte> compressed_data) {
+    CHECK_GE(compressed_data.size(), kHeaderSize * kUInt32Size);
+    return GetHeaderValue(compressed_data.begin(), kUncompressedSizeIndex);
+  }
+
+  uint32_t codec() const { return codec_; }
+  uint32_t chunk_count() const { return chunk_count_; }
+
+  void Decompress(uint32_t index) const {
+    DCHECK_LT(index, chunk_count_);
+    uint32_t start = index * chunk_size_;
+    uint32_t size = std::min(chunk_size_, uncompressed_size_ - start);
+    DecompressChunk(
+        codec_,
+        compressed_data_.SubVector(compressed_offsets_[index],
+                                   compressed_offsets_[index + 1]),
+        Vector<byte>(uncompressed_data_ + start, size));
+  }
+
+ private:
+  Vector<const byte> compressed_data_;
+  byte* uncompressed_data_;
+  uint32_t uncompressed_size_;
+  uint32_t codec_;
+  uint32_t chunk_size_;
+  uint32_t chunk_count_;
+  std::vector<size_t> compressed_offsets_;
+};
+
+class DecompressionJob : public v8::JobTask {
+ public:
+  explicit DecompressionJob(const ChunkList* chunks) : chunks_(chunks) {}
+
+  void Run(JobDelegate* delegate) override {
+    while (!delegate->ShouldYield()) {
+      uint32_t index = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= chunks_->chunk_count()) return;
+      chunks_->Decompress(index);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    uint32_t next_chunk = next_chunk_.load(std::memory_order_relaxed);
+    uint32_t chunk_count = chunks_->chunk_count();
+    return next_chunk < chunk_count ? chunk_count - next_chunk : 0;
+  }
+
+ private:
+  const ChunkList* const chunks_;
+  std::atomic<uint32_t> next_chunk_{0};
+};
+
+}  // namespace
+
 SnapshotData SnapshotCompression::Compress(
     const SnapshotData* uncompressed_data) {
   SnapshotData snapshot_data;
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
 
-  static_assert(sizeof(Bytef) == 1, "");
-  const uLongf input_size =
-      static_cast<uLongf>(uncompressed_data->RawData().size());
-  uint32_t payload_length =
-      static_cast<uint32_t>(uncompressed_data->RawData().size());
+  Vector<const byte> input = uncompressed_data->RawData();
+  uint32_t payload_length = static_cast<uint32_t>(input.size());
+  uint32_t codec = FLAG_snapshot_compression_lz ? kLZ : kZlib;
+  uint32_t chunk_size = FLAG_snapshot_compression_chunk_size * KB;
+  if (chunk_size == 0 || chunk_size > payload_length) {
+    chunk_size = std::max(payload_length, uint32_t{1});
+  }
 
-  uLongf compressed_data_size = compressBound(input_size);
+  std::vector<std::vector<byte>> chunks;
+  for (uint32_t start = 0; start < payload_length; start += chunk_size) {
+    uint32_t end = std::min(payload_length - start, chunk_size) + start;
+    chunks.push_back(CompressChunk(codec, input.SubVector(start, end)));
+  }
+  uint32_t chunk_count = static_cast<uint32_t>(chunks.size());
 
-  // Allocating >= the final amount we will need.
-  snapshot_data.AllocateData(
-      static_cast<uint32_t>(sizeof(payload_length) + compressed_data_size));
+  size_t size = (kHeaderSize + size_t{chunk_count}) * kUInt32Size;
+  for (const std::vector<byte>& chunk : chunks) size += chunk.size();
+  CHECK_LE(size, kMaxUInt32);
+  snapshot_data.AllocateData(static_cast<uint32_t>(size));
 
   byte* compressed_data = const_cast<byte*>(snapshot_data.RawData().begin());
-  // Since we are doing raw compression (no zlib or gzip headers), we need to
-  // manually store the uncompressed size.
-  MemCopy(compressed_data, &payload_length, sizeof(payload_length));
-
-  CHECK_EQ(zlib_internal::CompressHelper(
-               zlib_internal::ZRAW, compressed_data + sizeof(payload_length),
-               &compressed_data_size,
-               bit_cast<const Bytef*>(uncompressed_data->RawData().begin()),
-               input_size, Z_DEFAULT_COMPRESSION, nullptr, nullptr),
-           Z_OK);
-
-  // Reallocating to exactly the size we need.
-  snapshot_data.Resize(static_cast<uint32_t>(compressed_data_size) +
-                       sizeof(payload_length));
+  SetHeaderValue(compressed_data, kUncompressedSizeIndex, payload_length);
+  SetHeaderValue(compressed_data, kCodecIndex, codec);
+  SetHeaderValue(compressed_data, kChunkSizeIndex, chunk_size);
+  SetHeaderValue(compressed_data, kChunkCountIndex, chunk_count);
+  byte* chunk_data =
+      compressed_data + (kHeaderSize + chunk_count) * kUInt32Size;
+  for (uint32_t i = 0; i < chunk_count; i++) {
+    SetHeaderValue(compressed_data, kHeaderSize + i,
+                   static_cast<uint32_t>(chunks[i].size()));
+    CopyBytes(chunk_data, chunks[i].data(), chunks[i].size());
+    chunk_data += chunks[i].size();
+  }
   DCHECK_EQ(payload_length,
-            GetUncompressedSize(snapshot_data.RawData().begin()));
+            ChunkList::UncompressedSize(snapshot_data.RawData()));
 
   if (FLAG_profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
-    PrintF("[Compressing %d bytes took %0.3f ms]\n", payload_length, ms);
+    PrintF("[Compressing %d bytes (%s, %u chunks) to %zu bytes took %0.3f "
+           "ms]\n",
+           payload_length, CodecName(codec), chunk_count, size, ms);
   }
   return snapshot_data;
 }
@@ -67,28 +392,30 @@ SnapshotData SnapshotCompression::Decompress(
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
 
-  const Bytef* input_bytef = bit_cast<const Bytef*>(compressed_data.begin());
-
-  // Since we are doing raw compression (no zlib or gzip headers), we need to
-  // manually retrieve the uncompressed size.
-  uint32_t uncompressed_payload_length = GetUncompressedSize(input_bytef);
-  input_bytef += sizeof(uncompressed_payload_length);
-
+  uint32_t uncompressed_payload_length =
+      ChunkList::UncompressedSize(compressed_data);
   snapshot_data.AllocateData(uncompressed_payload_length);
+  ChunkList chunks(compressed_data,
+                   const_cast<byte*>(snapshot_data.RawData().begin()));
 
-  uLongf uncompressed_size = uncompressed_payload_length;
-  CHECK_EQ(zlib_internal::UncompressHelper(
-               zlib_internal::ZRAW,
-               bit_cast<Bytef*>(snapshot_data.RawData().begin()),
-               &uncompressed_size, input_bytef,
-               static_cast<uLong>(compressed_data.size() -
-                                  sizeof(uncompressed_payload_length))),
-           Z_OK);
+  // The joining thread takes part in decompression, so that the job finishes
+  // even when no worker thread becomes available.
+  if (FLAG_parallel_snapshot_decompression && chunks.chunk_count() > 1) {
+    V8::GetCurrentPlatform()
+        ->PostJob(TaskPriority::kUserBlocking,
+                  std::make_unique<DecompressionJob>(&chunks))
+        ->Join();
+  } else {
+    for (uint32_t i = 0; i < chunks.chunk_count(); i++) {
+      chunks.Decompress(i);
+    }
+  }
 
   if (FLAG_profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
-    PrintF("[Decompressing %d bytes took %0.3f ms]\n",
-           uncompressed_payload_length, ms);
+    PrintF("[Decompressing %d bytes (%s, %u chunks) took %0.3f ms]\n",
+           uncompressed_payload_length, CodecName(chunks.codec()),
+           chunks.chunk_count(), ms);
   }
   return snapshot_data;
 }
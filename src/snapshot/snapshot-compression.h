@@ -11,6 +11,9 @@
 namespace v8 {
 namespace internal {
 
+// Compresses snapshot data in independent chunks, with either zlib or a faster
+// to decompress LZ codec (--snapshot-compression-lz). Decompression of the
+// chunks is spread over worker threads.
 class SnapshotCompression : public AllStatic {
  public:
   V8_EXPORT_PRIVATE static SnapshotData Compress(
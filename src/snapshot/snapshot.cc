@@ -6,6 +6,9 @@
 
 #include "src/snapshot/snapshot.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "src/base/platform/platform.h"
 #include "src/common/assert-scope.h"
 #include "src/execution/isolate-inl.h"
@@ -202,16 +205,29 @@ MaybeHandle<Context> Snapshot::NewContextFromSnapshot(
 
 // static
 void Snapshot::ClearReconstructableDataForSerialization(
-    Isolate* isolate, bool clear_recompilable_data) {
+    Isolate* isolate,
+    v8::SnapshotCreator::FunctionCodeHandling function_code_handling) {
+  using FunctionCodeHandling = v8::SnapshotCreator::FunctionCodeHandling;
+  const bool clear_recompilable_data =
+      function_code_handling != FunctionCodeHandling::kKeep;
+  const bool keep_warm_functions =
+      function_code_handling == FunctionCodeHandling::kClearCold;
+
   // Clear SFIs and JSRegExps.
 
   if (clear_recompilable_data) {
     HandleScope scope(isolate);
     std::vector<i::Handle<i::SharedFunctionInfo>> sfis_to_clear;
     {  // Heap allocation is disallowed within this scope.
+      // SFIs of functions that ran long enough to allocate a feedback vector.
+      // Their bytecode is likely needed again, so keep it with kClearCold.
+      std::unordered_set<Address> warm_sfis;
       i::HeapObjectIterator it(isolate->heap());
       for (i::HeapObject o = it.Next(); !o.is_null(); o = it.Next()) {
-        if (o.IsSharedFunctionInfo()) {
+        if (keep_warm_functions && o.IsJSFunction()) {
+          i::JSFunction fun = i::JSFunction::cast(o);
+          if (fun.has_feedback_vector()) warm_sfis.insert(fun.shared().ptr());
+        } else if (o.IsSharedFunctionInfo()) {
           i::SharedFunctionInfo shared = i::SharedFunctionInfo::cast(o);
           if (shared.script().IsScript() &&
               Script::cast(shared.script()).type() == Script::TYPE_EXTENSION) {
@@ -227,6 +243,14 @@ void Snapshot::ClearReconstructableDataForSerialization(
           }
         }
       }
+      if (!warm_sfis.empty()) {
+        sfis_to_clear.erase(
+            std::remove_if(sfis_to_clear.begin(), sfis_to_clear.end(),
+                           [&](i::Handle<i::SharedFunctionInfo> shared) {
+                             return warm_sfis.count(shared->ptr()) != 0;
+                           }),
+            sfis_to_clear.end());
+      }
     }
 
     // Must happen after heap iteration since SFI::DiscardCompiled may allocate.
@@ -259,7 +283,7 @@ void Snapshot::ClearReconstructableDataForSerialization(
           i::ReadOnlyRoots(isolate).undefined_value());
     }
 #ifdef DEBUG
-    if (clear_recompilable_data) {
+    if (function_code_handling == FunctionCodeHandling::kClear) {
 #if V8_ENABLE_WEBASSEMBLY
       DCHECK(fun.shared().HasWasmExportedFunctionData() ||
              fun.shared().HasBuiltinId() || fun.shared().IsApiFunction() ||
@@ -522,6 +546,10 @@ uint32_t SnapshotImpl::ExtractNumContexts(const v8::StartupData* data) {
   return num_contexts;
 }
 
+uint32_t Snapshot::GetExpectedChecksum(const v8::StartupData* data) {
+  return SnapshotImpl::GetHeaderValue(data, SnapshotImpl::kChecksumOffset);
+}
+
 bool Snapshot::VerifyChecksum(const v8::StartupData* data) {
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
@@ -43,10 +43,13 @@ class Snapshot : public AllStatic {
 
   // In preparation for serialization, clear data from the given isolate's heap
   // that 1. can be reconstructed and 2. is not suitable for serialization. The
-  // `clear_recompilable_data` flag controls whether compiled objects are
-  // cleared from shared function infos and regexp objects.
+  // `function_code_handling` argument controls whether compiled objects are
+  // cleared from shared function infos and regexp objects. With kClearCold,
+  // shared function infos of functions that have a feedback vector keep their
+  // bytecode; all others are recompiled lazily after deserialization.
   V8_EXPORT_PRIVATE static void ClearReconstructableDataForSerialization(
-      Isolate* isolate, bool clear_recompilable_data);
+      Isolate* isolate,
+      v8::SnapshotCreator::FunctionCodeHandling function_code_handling);
 
   // Serializes the given isolate and contexts. Each context may have an
   // associated callback to serialize internal fields. The default context must
@@ -90,6 +93,9 @@ class Snapshot : public AllStatic {
   static bool HasContextSnapshot(Isolate* isolate, size_t index);
   static bool EmbedsScript(Isolate* isolate);
   V8_EXPORT_PRIVATE static bool VerifyChecksum(const v8::StartupData* data);
+  // Returns the checksum stored in the header of |data| without recomputing
+  // it.
+  static uint32_t GetExpectedChecksum(const v8::StartupData* data);
   static bool ExtractRehashability(const v8::StartupData* data);
   static bool VersionIsValid(const v8::StartupData* data);
 
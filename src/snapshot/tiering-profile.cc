@@ -0,0 +1,166 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/tiering-profile.h"
+
+#include <map>
+#include <vector>
+
+#include "src/base/memory.h"
+#include "src/codegen/compiler.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/objects/shared-function-info-inl.h"
+#include "src/snapshot/code-serializer.h"
+#include "src/utils/version.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+using SourceRange = std::pair<int, int>;
+
+uint32_t SourceHashOf(Isolate* isolate, Handle<Script> script) {
+  Handle<String> source(String::cast(script->source()), isolate);
+  return SerializedCodeData::SourceHash(source, script->origin_options());
+}
+
+uint32_t ReadWord(const byte* data, int index) {
+  return base::ReadUnalignedValue<uint32_t>(
+      reinterpret_cast<Address>(data) + index * kUInt32Size);
+}
+
+// Returns the function whose source range is exactly {range}, compiling
+// enclosing functions as needed to create it. Compiling a function creates
+// the SharedFunctionInfos of the function literals directly inside it.
+MaybeHandle<SharedFunctionInfo> FindOrCreateFunction(Isolate* isolate,
+                                                     Handle<Script> script,
+                                                     SourceRange range) {
+  while (true) {
+    SharedFunctionInfo innermost;
+    {
+      DisallowGarbageCollection no_gc;
+      SharedFunctionInfo::ScriptIterator it(isolate, *script);
+      for (SharedFunctionInfo info = it.Next(); !info.is_null();
+           info = it.Next()) {
+        int start = info.StartPosition();
+        int end = info.EndPosition();
+        if (start == range.first && end == range.second) {
+          return handle(info, isolate);
+        }
+        if (start > range.first || end < range.second) continue;
+        if (innermost.is_null() || start > innermost.StartPosition() ||
+            (start == innermost.StartPosition() &&
+             end < innermost.EndPosition())) {
+          innermost = info;
+        }
+      }
+    }
+    // If the innermost enclosing function is already compiled and the
+    // function still does not exist, the profile does not match the script.
+    if (innermost.is_null() || innermost.is_compiled()) return {};
+    Handle<SharedFunctionInfo> enclosing(innermost, isolate);
+    IsCompiledScope is_compiled_scope;
+    if (!Compiler::Compile(isolate, enclosing, Compiler::CLEAR_EXCEPTION,
+                           &is_compiled_scope)) {
+      return {};
+    }
+  }
+}
+
+}  // namespace
+
+// static
+ScriptCompiler::CachedData* TieringProfile::Create(
+    Isolate* isolate, Handle<SharedFunctionInfo> toplevel) {
+  DCHECK(toplevel->is_toplevel());
+  Handle<Script> script(Script::cast(toplevel->script()), isolate);
+  uint32_t source_hash = SourceHashOf(isolate, script);
+
+  std::map<SourceRange, uint32_t> entries;
+  {
+    DisallowGarbageCollection no_gc;
+    SharedFunctionInfo::ScriptIterator it(isolate, *script);
+    for (SharedFunctionInfo info = it.Next(); !info.is_null();
+         info = it.Next()) {
+      if (info.is_toplevel() || !info.has_been_called()) continue;
+      uint32_t flags = kRan;
+      if (info.has_been_marked_for_optimization() &&
+          !info.optimization_disabled()) {
+        flags |= kOptimized;
+      }
+      entries[{info.StartPosition(), info.EndPosition()}] = flags;
+    }
+  }
+
+  std::vector<uint32_t> words(kHeaderSize);
+  words[kMagicNumberIndex] = kMagicNumber;
+  words[kVersionHashIndex] = Version::Hash();
+  words[kFlagHashIndex] = FlagList::Hash();
+  words[kSourceHashIndex] = source_hash;
+  words[kEntryCountIndex] = static_cast<uint32_t>(entries.size());
+  for (const auto& entry : entries) {
+    words.push_back(static_cast<uint32_t>(entry.first.first));
+    words.push_back(static_cast<uint32_t>(entry.first.second));
+    words.push_back(entry.second);
+  }
+
+  int length = static_cast<int>(words.size() * kUInt32Size);
+  byte* data = NewArray<byte>(length);
+  CopyBytes(data, reinterpret_cast<const byte*>(words.data()), length);
+  return new ScriptCompiler::CachedData(
+      data, length, ScriptCompiler::CachedData::BufferOwned);
+}
+
+// static
+bool TieringProfile::Apply(Isolate* isolate,
+                           Handle<SharedFunctionInfo> toplevel,
+                           const byte* data, int length) {
+  DCHECK(toplevel->is_toplevel());
+  HandleScope scope(isolate);
+  Handle<Script> script(Script::cast(toplevel->script()), isolate);
+
+  if (length < kHeaderSize * kUInt32Size) return false;
+  if (ReadWord(data, kMagicNumberIndex) != kMagicNumber ||
+      ReadWord(data, kVersionHashIndex) != Version::Hash() ||
+      ReadWord(data, kFlagHashIndex) != FlagList::Hash() ||
+      ReadWord(data, kSourceHashIndex) != SourceHashOf(isolate, script)) {
+    return false;
+  }
+  uint32_t count = ReadWord(data, kEntryCountIndex);
+  if (static_cast<uint64_t>(length) !=
+      (kHeaderSize + uint64_t{count} * kEntrySize) * kUInt32Size) {
+    return false;
+  }
+
+  // Entries are sorted by position, so enclosing functions are compiled
+  // before the functions nested inside them.
+  for (uint32_t i = 0; i < count; i++) {
+    int index = kHeaderSize + i * kEntrySize;
+    SourceRange range(
+        static_cast<int>(ReadWord(data, index + kStartPositionIndex)),
+        static_cast<int>(ReadWord(data, index + kEndPositionIndex)));
+    uint32_t flags = ReadWord(data, index + kFlagsIndex);
+    HandleScope entry_scope(isolate);
+    Handle<SharedFunctionInfo> shared;
+    if (!FindOrCreateFunction(isolate, script, range).ToHandle(&shared)) {
+      continue;
+    }
+    if (!shared->is_compiled()) {
+      IsCompiledScope is_compiled_scope;
+      if (!Compiler::Compile(isolate, shared, Compiler::CLEAR_EXCEPTION,
+                             &is_compiled_scope)) {
+        continue;
+      }
+    }
+    if ((flags & kOptimized) && !shared->optimization_disabled()) {
+      shared->set_hot_in_tiering_profile(true);
+    }
+  }
+  return true;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,61 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SNAPSHOT_TIERING_PROFILE_H_
+#define V8_SNAPSHOT_TIERING_PROFILE_H_
+
+#include "include/v8.h"
+#include "src/handles/handles.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class SharedFunctionInfo;
+
+// A tiering profile records which functions of a script have been called and
+// which of them have been marked for optimization, so that a later process
+// running the same script can compile them eagerly and optimize them after the
+// first profiler tick instead of waiting for them to become hot again. The
+// invocation data is read from the script's SharedFunctionInfos, which only
+// record it while --record-called-functions is set. Type feedback itself is
+// not part of the profile: maps and call targets have no identity across
+// isolates.
+//
+// The profile is a sequence of uint32_t words:
+//   magic number, version hash, flag hash, source hash, entry count,
+//   followed by (start position, end position, flags) for each entry.
+class TieringProfile : public AllStatic {
+ public:
+  V8_EXPORT_PRIVATE static ScriptCompiler::CachedData* Create(
+      Isolate* isolate, Handle<SharedFunctionInfo> toplevel);
+  V8_EXPORT_PRIVATE static bool Apply(Isolate* isolate,
+                                      Handle<SharedFunctionInfo> toplevel,
+                                      const byte* data, int length);
+
+ private:
+  static const uint32_t kMagicNumber = 0x54495052;  // "TIPR"
+
+  static const int kMagicNumberIndex = 0;
+  static const int kVersionHashIndex = 1;
+  static const int kFlagHashIndex = 2;
+  static const int kSourceHashIndex = 3;
+  static const int kEntryCountIndex = 4;
+  static const int kHeaderSize = 5;
+
+  static const int kStartPositionIndex = 0;
+  static const int kEndPositionIndex = 1;
+  static const int kFlagsIndex = 2;
+  static const int kEntrySize = 3;
+
+  enum EntryFlag : uint32_t {
+    kRan = 1 << 0,
+    kOptimized = 1 << 1,
+  };
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_SNAPSHOT_TIERING_PROFILE_H_
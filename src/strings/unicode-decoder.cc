@@ -4,12 +4,80 @@
 
 #include "src/strings/unicode-decoder.h"
 
+#include "src/base/bits.h"
 #include "src/strings/unicode-inl.h"
 #include "src/utils/memcopy.h"
 
+#if (V8_HOST_ARCH_X64 || V8_HOST_ARCH_IA32) && \
+    (defined(__SSE2__) || defined(_M_X64) ||    \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define V8_UNICODE_DECODER_USE_SSE2 1
+#include <emmintrin.h>
+#elif V8_HOST_ARCH_ARM64 && defined(__ARM_NEON)
+#define V8_UNICODE_DECODER_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace v8 {
 namespace internal {
 
+int NonAsciiStartVectorized(const uint8_t* chars, int length) {
+  const uint8_t* cursor = chars;
+  const uint8_t* limit = chars + length;
+
+#if V8_UNICODE_DECODER_USE_SSE2
+  static constexpr int kBlockSize = sizeof(__m128i);
+  // Check four blocks per iteration; a set sign bit marks a non-ASCII byte.
+  while (limit - cursor >= 4 * kBlockSize) {
+    const __m128i* blocks = reinterpret_cast<const __m128i*>(cursor);
+    __m128i any = _mm_or_si128(
+        _mm_or_si128(_mm_loadu_si128(blocks), _mm_loadu_si128(blocks + 1)),
+        _mm_or_si128(_mm_loadu_si128(blocks + 2),
+                     _mm_loadu_si128(blocks + 3)));
+    if (_mm_movemask_epi8(any) != 0) break;
+    cursor += 4 * kBlockSize;
+  }
+  while (limit - cursor >= kBlockSize) {
+    int mask = _mm_movemask_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor)));
+    if (mask != 0) {
+      return static_cast<int>(cursor - chars) +
+             base::bits::CountTrailingZeros(static_cast<uint32_t>(mask));
+    }
+    cursor += kBlockSize;
+  }
+#elif V8_UNICODE_DECODER_USE_NEON
+  static constexpr int kBlockSize = sizeof(uint8x16_t);
+  while (limit - cursor >= 4 * kBlockSize) {
+    uint8x16_t any = vorrq_u8(
+        vorrq_u8(vld1q_u8(cursor), vld1q_u8(cursor + kBlockSize)),
+        vorrq_u8(vld1q_u8(cursor + 2 * kBlockSize),
+                 vld1q_u8(cursor + 3 * kBlockSize)));
+    if (vmaxvq_u8(any) > unibrow::Utf8::kMaxOneByteChar) break;
+    cursor += 4 * kBlockSize;
+  }
+  while (limit - cursor >= kBlockSize) {
+    if (vmaxvq_u8(vld1q_u8(cursor)) > unibrow::Utf8::kMaxOneByteChar) break;
+    cursor += kBlockSize;
+  }
+#else
+  static constexpr int kBlockSize = sizeof(uintptr_t);
+  const uintptr_t non_one_byte_mask = kUintptrAllBitsSet / 0xFF * 0x80;
+  while (limit - cursor >= 4 * kBlockSize) {
+    uintptr_t words[4];
+    memcpy(words, cursor, sizeof(words));
+    if ((words[0] | words[1] | words[2] | words[3]) & non_one_byte_mask) break;
+    cursor += 4 * kBlockSize;
+  }
+#endif
+
+  // Find the exact position in the remaining bytes.
+  while (cursor < limit && *cursor <= unibrow::Utf8::kMaxOneByteChar) {
+    ++cursor;
+  }
+  return static_cast<int>(cursor - chars);
+}
+
 Utf8Decoder::Utf8Decoder(const Vector<const uint8_t>& chars)
     : encoding_(Encoding::kAscii),
       non_ascii_start_(NonAsciiStart(chars.begin(), chars.length())),
@@ -30,6 +98,16 @@ Utf8Decoder::Utf8Decoder(const Vector<const uint8_t>& chars)
       is_one_byte = is_one_byte && t <= unibrow::Latin1::kMaxChar;
       utf16_length_++;
       if (t > unibrow::Utf16::kMaxNonSurrogateCharCode) utf16_length_++;
+
+      // Skip over the ASCII run that may follow. Mostly non-ASCII input
+      // does not pay for the scan.
+      DCHECK_EQ(state, unibrow::Utf8::State::kAccept);
+      if (cursor < end && *cursor <= unibrow::Utf8::kMaxOneByteChar) {
+        int ascii_length =
+            NonAsciiStart(cursor, static_cast<int>(end - cursor));
+        cursor += ascii_length;
+        utf16_length_ += ascii_length;
+      }
     }
   }
 
@@ -64,6 +142,16 @@ void Utf8Decoder::Decode(Char* out, const Vector<const uint8_t>& data) {
         *(out++) = unibrow::Utf16::LeadSurrogate(t);
         *(out++) = unibrow::Utf16::TrailSurrogate(t);
       }
+
+      // Copy the ASCII run that may follow.
+      DCHECK_EQ(state, unibrow::Utf8::State::kAccept);
+      if (cursor < end && *cursor <= unibrow::Utf8::kMaxOneByteChar) {
+        int ascii_length =
+            NonAsciiStart(cursor, static_cast<int>(end - cursor));
+        CopyChars(out, cursor, ascii_length);
+        cursor += ascii_length;
+        out += ascii_length;
+      }
     }
   }
 
@@ -11,11 +11,24 @@
 namespace v8 {
 namespace internal {
 
+// Inputs of at least this many bytes are scanned by NonAsciiStartVectorized.
+static constexpr int kNonAsciiStartVectorizedMinLength = 64;
+
+// Returns the offset of the first non-one-byte character in |chars|, or
+// |length| if there is none. Scans 16-byte blocks with SIMD instructions where
+// the host supports them and falls back to word-at-a-time scanning otherwise.
+V8_EXPORT_PRIVATE int NonAsciiStartVectorized(const uint8_t* chars,
+                                              int length);
+
 // The return value may point to the first aligned word containing the first
 // non-one-byte character, rather than directly to the non-one-byte character.
 // If the return value is >= the passed length, the entire string was
 // one-byte.
 inline int NonAsciiStart(const uint8_t* chars, int length) {
+  if (length >= kNonAsciiStartVectorizedMinLength) {
+    return NonAsciiStartVectorized(chars, length);
+  }
+
   const uint8_t* start = chars;
   const uint8_t* limit = chars + length;
 
@@ -698,6 +698,41 @@ void LiftoffAssembler::MaterializeMergedConstants(uint32_t arity) {
   }
 }
 
+void LiftoffAssembler::PrepareLoopLocals() {
+  // Each register can only hold a single value at the loop header, otherwise
+  // back-edges would have to move different values into the same register.
+  // References are always spilled, and register pairs are not worth the
+  // trouble.
+  for (uint32_t i = 0; i < num_locals_; ++i) {
+    VarState& slot = cache_state_.stack_state[i];
+    if (!slot.is_reg()) {
+      // Constants would have to stay the same across all back-edges.
+      Spill(&slot);
+      continue;
+    }
+    if (is_reference(slot.kind()) || slot.reg().is_pair() ||
+        cache_state_.get_use_count(slot.reg()) > 1) {
+      Spill(&slot);
+    }
+  }
+
+  // Leave at least half of the cache registers of each class free for the
+  // loop body; values kept in registers would be spilled there otherwise.
+  // Locals with lower indices (e.g. parameters) are kept preferably.
+  for (RegClass rc : {kGpReg, kFpReg}) {
+    LiftoffRegList cache_regs = GetCacheRegList(rc);
+    const unsigned max_used_regs = cache_regs.GetNumRegsSet() / 2;
+    for (uint32_t i = num_locals_; i > 0; --i) {
+      if ((cache_state_.used_registers & cache_regs).GetNumRegsSet() <=
+          max_used_regs) {
+        break;
+      }
+      VarState& slot = cache_state_.stack_state[i - 1];
+      if (slot.is_reg() && slot.reg_class() == rc) Spill(&slot);
+    }
+  }
+}
+
 void LiftoffAssembler::MergeFullStackWith(CacheState& target,
                                           const CacheState& source) {
   DCHECK_EQ(source.stack_height(), target.stack_height());
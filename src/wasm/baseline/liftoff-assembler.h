@@ -430,6 +430,11 @@ class LiftoffAssembler : public TurboAssembler {
   // stack, so that we can merge different values on the back-edge.
   void PrepareLoopArgs(int num);
 
+  // Spill the locals that cannot stay in registers across the back-edges of a
+  // loop starting here. Back-edges move the values of all other locals back
+  // into their registers.
+  void PrepareLoopLocals();
+
   int NextSpillOffset(ValueKind kind) {
     int offset = TopSpillOffset() + SlotSizeForType(kind);
     if (NeedsAlignment(kind)) {
@@ -7,6 +7,7 @@
 #include "src/base/enum-set.h"
 #include "src/base/optional.h"
 #include "src/base/platform/wrappers.h"
+#include "src/base/small-vector.h"
 #include "src/codegen/assembler-inl.h"
 // TODO(clemensb): Remove dependences on compiler stuff.
 #include "src/codegen/external-reference.h"
@@ -94,6 +95,15 @@ constexpr ValueKind kTaggedKind = LiftoffAssembler::kTaggedKind;
 // Used to construct fixed-size signatures: MakeSig::Returns(...).Params(...);
 using MakeSig = FixedSizeSignature<ValueKind>;
 
+// Small memory.copy and memory.fill operations of a constant size are emitted
+// inline on platforms where unaligned accesses of all sizes are allowed.
+#if V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_ARM64
+constexpr bool kSupportsInlineBulkMemory = true;
+#else
+constexpr bool kSupportsInlineBulkMemory = false;
+#endif
+constexpr int kMaxInlineBulkMemoryChunks = 4;
+
 #if V8_TARGET_ARCH_ARM64
 // On ARM64, the Assembler keeps track of pointers to Labels to resolve
 // branches to distant targets. Moving labels would confuse the Assembler,
@@ -1043,12 +1053,15 @@ class LiftoffCompiler {
   void Block(FullDecoder* decoder, Control* block) { PushControl(block); }
 
   void Loop(FullDecoder* decoder, Control* loop) {
-    // Before entering a loop, spill all locals to the stack, in order to free
-    // the cache registers, and to avoid unnecessarily reloading stack values
-    // into registers at branches.
-    // TODO(clemensb): Come up with a better strategy here, involving
-    // pre-analysis of the function.
-    __ SpillLocals();
+    // Before entering a loop, spill the locals that cannot stay in registers
+    // across its back-edges. Others stay in registers for the whole loop,
+    // instead of being reloaded in every iteration. Code for debugging keeps
+    // all locals on the stack.
+    if (V8_UNLIKELY(for_debugging_)) {
+      __ SpillLocals();
+    } else {
+      __ PrepareLoopLocals();
+    }
 
     __ PrepareLoopArgs(loop->start_merge.arity);
 
@@ -4632,9 +4645,154 @@ class LiftoffCompiler {
              pinned);
   }
 
+  // Splits a memory.copy or memory.fill of the constant size on top of the
+  // value stack into at most {kMaxInlineBulkMemoryChunks} accesses of
+  // {chunk_sizes} bytes, largest first. Returns the number of chunks, or 0 if
+  // the operation should call into C instead.
+  int GetInlineBulkMemoryChunks(int* chunk_sizes) {
+    if (!kSupportsInlineBulkMemory || env_->module->is_memory64) return 0;
+    LiftoffAssembler::VarState& size_slot =
+        __ cache_state()->stack_state.back();
+    if (!size_slot.is_const()) return 0;
+    uint32_t size = static_cast<uint32_t>(size_slot.i32_const());
+    if (size == 0 || size > FLAG_wasm_inline_bulk_memory_max_size) return 0;
+    int num_chunks = 0;
+    for (int chunk_size : {16, 8, 4, 2, 1}) {
+      if (chunk_size == 16 && !CpuFeatures::SupportsWasmSimd128()) continue;
+      for (; size >= static_cast<uint32_t>(chunk_size); size -= chunk_size) {
+        if (num_chunks == kMaxInlineBulkMemoryChunks) return 0;
+        chunk_sizes[num_chunks++] = chunk_size;
+      }
+    }
+    return num_chunks;
+  }
+
+  static LoadType BulkMemoryLoadType(int chunk_size) {
+    switch (chunk_size) {
+      case 16:
+        return LoadType::kS128Load;
+      case 8:
+        return LoadType::kI64Load;
+      case 4:
+        return LoadType::kI32Load;
+      case 2:
+        return LoadType::kI32Load16U;
+      case 1:
+        return LoadType::kI32Load8U;
+    }
+    UNREACHABLE();
+  }
+
+  static StoreType BulkMemoryStoreType(int chunk_size) {
+    switch (chunk_size) {
+      case 16:
+        return StoreType::kS128Store;
+      case 8:
+        return StoreType::kI64Store;
+      case 4:
+        return StoreType::kI32Store;
+      case 2:
+        return StoreType::kI32Store16;
+      case 1:
+        return StoreType::kI32Store8;
+    }
+    UNREACHABLE();
+  }
+
+  // Both ranges are bounds checked before anything is written, and all chunks
+  // are loaded before the first one is stored, so that overlapping ranges are
+  // copied like with {memmove}.
+  void InlineMemoryCopy(FullDecoder* decoder, uint32_t size,
+                        const int* chunk_sizes, int num_chunks) {
+    LiftoffRegList pinned;
+    LiftoffRegister src = pinned.set(__ PopToRegister());
+    LiftoffRegister dst = pinned.set(__ PopToRegister(pinned));
+    Register src_index =
+        BoundsCheckMem(decoder, size, 0, src, pinned, kDoForceCheck);
+    if (src_index == no_reg) return;
+    Register dst_index =
+        BoundsCheckMem(decoder, size, 0, dst, pinned, kDoForceCheck);
+    if (dst_index == no_reg) return;
+
+    uintptr_t src_offset = 0;
+    uintptr_t dst_offset = 0;
+    pinned.set(src_index);
+    pinned.set(dst_index);
+    src_index = AddMemoryMasking(src_index, &src_offset, &pinned);
+    dst_index = AddMemoryMasking(dst_index, &dst_offset, &pinned);
+    DEBUG_CODE_COMMENT("inlined memory.copy");
+    Register mem_start = pinned.set(__ GetUnusedRegister(kGpReg, pinned)).gp();
+    LOAD_INSTANCE_FIELD(mem_start, MemoryStart, kSystemPointerSize, pinned);
+    base::SmallVector<LiftoffRegister, kMaxInlineBulkMemoryChunks> values;
+    for (int i = 0, offset = 0; i < num_chunks; offset += chunk_sizes[i++]) {
+      LoadType type = BulkMemoryLoadType(chunk_sizes[i]);
+      RegClass rc = reg_class_for(type.value_type().kind());
+      values.push_back(pinned.set(__ GetUnusedRegister(rc, pinned)));
+      __ Load(values[i], mem_start, src_index, src_offset + offset, type,
+              pinned);
+    }
+    for (int i = 0, offset = 0; i < num_chunks; offset += chunk_sizes[i++]) {
+      __ Store(mem_start, dst_index, dst_offset + offset, values[i],
+               BulkMemoryStoreType(chunk_sizes[i]), pinned);
+    }
+  }
+
+  void InlineMemoryFill(FullDecoder* decoder, uint32_t size,
+                        const int* chunk_sizes, int num_chunks) {
+    LiftoffRegList pinned;
+    LiftoffRegister value = pinned.set(__ PopToRegister());
+    LiftoffRegister dst = pinned.set(__ PopToRegister(pinned));
+    Register dst_index =
+        BoundsCheckMem(decoder, size, 0, dst, pinned, kDoForceCheck);
+    if (dst_index == no_reg) return;
+
+    uintptr_t dst_offset = 0;
+    pinned.set(dst_index);
+    dst_index = AddMemoryMasking(dst_index, &dst_offset, &pinned);
+    DEBUG_CODE_COMMENT("inlined memory.fill");
+    Register mem_start = pinned.set(__ GetUnusedRegister(kGpReg, pinned)).gp();
+    LOAD_INSTANCE_FIELD(mem_start, MemoryStart, kSystemPointerSize, pinned);
+
+    // Replicate the low byte of {value} into every byte of the stored values.
+    LiftoffRegister pattern32 =
+        pinned.set(__ GetUnusedRegister(kGpReg, pinned));
+    LiftoffRegister tmp = pinned.set(__ GetUnusedRegister(kGpReg, pinned));
+    __ emit_i32_andi(pattern32.gp(), value.gp(), 0xFF);
+    __ LoadConstant(tmp, WasmValue(int32_t{0x01010101}));
+    __ emit_i32_mul(pattern32.gp(), pattern32.gp(), tmp.gp());
+    base::Optional<LiftoffRegister> pattern64;
+    base::Optional<LiftoffRegister> pattern128;
+    for (int i = 0; i < num_chunks; ++i) {
+      if (chunk_sizes[i] == 8 && !pattern64) {
+        pattern64 = pinned.set(__ GetUnusedRegister(kGpReg, pinned));
+        __ emit_type_conversion(kExprI64UConvertI32, *pattern64, pattern32);
+        __ emit_i64_shli(tmp, *pattern64, 32);
+        __ emit_i64_or(*pattern64, *pattern64, tmp);
+      } else if (chunk_sizes[i] == 16 && !pattern128) {
+        pattern128 = pinned.set(__ GetUnusedRegister(kFpReg, pinned));
+        __ emit_i8x16_splat(*pattern128, value);
+      }
+    }
+    for (int i = 0, offset = 0; i < num_chunks; offset += chunk_sizes[i++]) {
+      LiftoffRegister chunk_value = chunk_sizes[i] == 16  ? *pattern128
+                                    : chunk_sizes[i] == 8 ? *pattern64
+                                                          : pattern32;
+      __ Store(mem_start, dst_index, dst_offset + offset, chunk_value,
+               BulkMemoryStoreType(chunk_sizes[i]), pinned);
+    }
+  }
+
   void MemoryCopy(FullDecoder* decoder,
                   const MemoryCopyImmediate<validate>& imm, const Value&,
                   const Value&, const Value&) {
+    int chunk_sizes[kMaxInlineBulkMemoryChunks];
+    if (int num_chunks = GetInlineBulkMemoryChunks(chunk_sizes)) {
+      uint32_t size = static_cast<uint32_t>(
+          __ cache_state()->stack_state.back().i32_const());
+      __ cache_state()->stack_state.pop_back();
+      InlineMemoryCopy(decoder, size, chunk_sizes, num_chunks);
+      return;
+    }
     LiftoffRegList pinned;
     LiftoffRegister size = pinned.set(__ PopToRegister());
     LiftoffRegister src = pinned.set(__ PopToRegister(pinned));
@@ -4656,6 +4814,14 @@ class LiftoffCompiler {
   void MemoryFill(FullDecoder* decoder,
                   const MemoryIndexImmediate<validate>& imm, const Value&,
                   const Value&, const Value&) {
+    int chunk_sizes[kMaxInlineBulkMemoryChunks];
+    if (int num_chunks = GetInlineBulkMemoryChunks(chunk_sizes)) {
+      uint32_t size = static_cast<uint32_t>(
+          __ cache_state()->stack_state.back().i32_const());
+      __ cache_state()->stack_state.pop_back();
+      InlineMemoryFill(decoder, size, chunk_sizes, num_chunks);
+      return;
+    }
     LiftoffRegList pinned;
     LiftoffRegister size = pinned.set(__ PopToRegister());
     LiftoffRegister value = pinned.set(__ PopToRegister(pinned));
@@ -36,7 +36,7 @@
 #include "src/wasm/wasm-arguments.h"
 #include "src/wasm/wasm-constants.h"
 #include "src/wasm/wasm-engine.h"
-#include "src/wasm/wasm-objects.h"
+#include "src/wasm/wasm-objects-inl.h"
 #include "src/wasm/wasm-result.h"
 #include "src/wasm/wasm-serialization.h"
 #include "third_party/wasm-api/wasm.h"
@@ -1191,19 +1191,40 @@ struct FuncData {
   };
   void (*finalizer)(void*);
   void* env;
+  // Reads the arguments from {argv}, calls the callback and writes the results
+  // back to {argv}. Selected by signature, see {SelectTrampoline}.
+  using Trampoline = i::Address (*)(FuncData*, i::Isolate*, i::Address argv);
+  Trampoline trampoline;
 
   FuncData(Store* store, const FuncType* type, Kind kind)
       : store(store),
         type(type->copy()),
         kind(kind),
         finalizer(nullptr),
-        env(nullptr) {}
+        env(nullptr),
+        trampoline(SelectTrampoline(type)) {}
 
   ~FuncData() {
     if (finalizer) (*finalizer)(env);
   }
 
+  own<Trap> Invoke(const Val params[], Val results[]) {
+    if (kind == kCallbackWithEnv) {
+      return callback_with_env(env, params, results);
+    }
+    return callback(params, results);
+  }
+
   static i::Address v8_callback(i::Address host_data_foreign, i::Address argv);
+
+  // Handles all signatures.
+  static i::Address GenericTrampoline(FuncData* self, i::Isolate* isolate,
+                                      i::Address argv);
+
+  // Throws {trap} and returns the exception for the wasm-to-C wrapper.
+  static i::Address ThrowTrap(i::Isolate* isolate, own<Trap> trap);
+
+  static Trampoline SelectTrampoline(const FuncType* type);
 };
 
 namespace {
@@ -1486,6 +1507,26 @@ own<Trap> CallWasmCapiFunction(i::WasmCapiFunctionData data, const Val args[],
   return (func_data->callback_with_env)(func_data->env, args, results);
 }
 
+// Storage for the parameters or results of a call to a host function. Small
+// signatures use inline storage, so that calls do not allocate.
+class CallbackValues {
+ public:
+  explicit CallbackValues(size_t size) {
+    if (size > kInlineSize) heap_values_.reset(new Val[size]);
+  }
+  CallbackValues(const CallbackValues&) = delete;
+  CallbackValues& operator=(const CallbackValues&) = delete;
+
+  Val* get() { return heap_values_ ? heap_values_.get() : inline_values_; }
+  Val& operator[](size_t index) { return get()[index]; }
+
+ private:
+  static constexpr size_t kInlineSize = 8;
+
+  Val inline_values_[kInlineSize];
+  std::unique_ptr<Val[]> heap_values_;
+};
+
 i::Handle<i::JSReceiver> GetProperException(
     i::Isolate* isolate, i::Handle<i::Object> maybe_exception) {
   if (maybe_exception->IsJSReceiver()) {
@@ -1526,9 +1567,7 @@ auto Func::call(const Val args[], Val results[]) const -> own<Trap> {
       i::WasmExportedFunctionData::cast(raw_function_data), isolate);
   i::Handle<i::WasmInstanceObject> instance(function_data->instance(), isolate);
   int function_index = function_data->function_index();
-  // Caching {sig} would give a ~10% reduction in overhead.
-  const i::wasm::FunctionSig* sig =
-      instance->module()->functions[function_index].sig;
+  const i::wasm::FunctionSig* sig = function_data->sig();
   PrepareFunctionData(isolate, function_data, sig, instance->module());
   i::Handle<i::Code> wrapper_code = i::Handle<i::Code>(
       i::Code::cast(function_data->c_wrapper_code()), isolate);
@@ -1582,15 +1621,27 @@ i::Address FuncData::v8_callback(i::Address host_data_foreign,
   StoreImpl* store = impl(self->store);
   i::Isolate* isolate = store->i_isolate();
   i::HandleScope scope(isolate);
+  return self->trampoline(self, isolate, argv);
+}
+
+i::Address FuncData::ThrowTrap(i::Isolate* isolate, own<Trap> trap) {
+  isolate->Throw(*impl(trap.get())->v8_object());
+  i::Object ex = isolate->pending_exception();
+  isolate->clear_pending_exception();
+  return ex.ptr();
+}
 
+i::Address FuncData::GenericTrampoline(FuncData* self, i::Isolate* isolate,
+                                       i::Address argv) {
+  StoreImpl* store = impl(self->store);
   const ownvec<ValType>& param_types = self->type->params();
   const ownvec<ValType>& result_types = self->type->results();
 
   int num_param_types = static_cast<int>(param_types.size());
   int num_result_types = static_cast<int>(result_types.size());
 
-  std::unique_ptr<Val[]> params(new Val[num_param_types]);
-  std::unique_ptr<Val[]> results(new Val[num_result_types]);
+  CallbackValues params(num_param_types);
+  CallbackValues results(num_result_types);
   i::Address p = argv;
   for (int i = 0; i < num_param_types; ++i) {
     switch (param_types[i]->kind()) {
@@ -1621,19 +1672,8 @@ i::Address FuncData::v8_callback(i::Address host_data_foreign,
     }
   }
 
-  own<Trap> trap;
-  if (self->kind == kCallbackWithEnv) {
-    trap = self->callback_with_env(self->env, params.get(), results.get());
-  } else {
-    trap = self->callback(params.get(), results.get());
-  }
-
-  if (trap) {
-    isolate->Throw(*impl(trap.get())->v8_object());
-    i::Object ex = isolate->pending_exception();
-    isolate->clear_pending_exception();
-    return ex.ptr();
-  }
+  own<Trap> trap = self->Invoke(params.get(), results.get());
+  if (trap) return ThrowTrap(isolate, std::move(trap));
 
   p = argv;
   for (int i = 0; i < num_result_types; ++i) {
@@ -1666,6 +1706,86 @@ i::Address FuncData::v8_callback(i::Address host_data_foreign,
   return i::kNullAddress;
 }
 
+namespace {
+
+// Trampoline specialized for signatures whose parameters and results all have
+// the numeric type {T}, which covers most small host functions. The values are
+// read from and written to {argv} directly, without looking at the signature.
+template <typename T, size_t kNumParams, size_t kNumResults>
+i::Address TypedTrampoline(FuncData* self, i::Isolate* isolate,
+                           i::Address argv) {
+  // Arrays cannot be empty.
+  Val params[kNumParams + 1];
+  Val results[kNumResults + 1];
+  for (size_t i = 0; i < kNumParams; ++i) {
+    params[i] =
+        Val::make(v8::base::ReadUnalignedValue<T>(argv + i * sizeof(T)));
+  }
+  own<Trap> trap = self->Invoke(params, results);
+  if (trap) return FuncData::ThrowTrap(isolate, std::move(trap));
+  for (size_t i = 0; i < kNumResults; ++i) {
+    v8::base::WriteUnalignedValue(argv + i * sizeof(T),
+                                  results[i].template get<T>());
+  }
+  return i::kNullAddress;
+}
+
+template <typename T>
+FuncData::Trampoline SelectTypedTrampoline(size_t num_params,
+                                           size_t num_results) {
+  static constexpr FuncData::Trampoline kTrampolines[][2] = {
+      {TypedTrampoline<T, 0, 0>, TypedTrampoline<T, 0, 1>},
+      {TypedTrampoline<T, 1, 0>, TypedTrampoline<T, 1, 1>},
+      {TypedTrampoline<T, 2, 0>, TypedTrampoline<T, 2, 1>},
+      {TypedTrampoline<T, 3, 0>, TypedTrampoline<T, 3, 1>},
+      {TypedTrampoline<T, 4, 0>, TypedTrampoline<T, 4, 1>}};
+  if (num_params >= arraysize(kTrampolines) ||
+      num_results >= arraysize(kTrampolines[0])) {
+    return nullptr;
+  }
+  return kTrampolines[num_params][num_results];
+}
+
+}  // namespace
+
+// static
+FuncData::Trampoline FuncData::SelectTrampoline(const FuncType* type) {
+  const ownvec<ValType>& params = type->params();
+  const ownvec<ValType>& results = type->results();
+  // Functions without parameters and results can use any of the trampolines.
+  if (params.size() == 0 && results.size() == 0) {
+    return TypedTrampoline<int32_t, 0, 0>;
+  }
+  ValKind kind = params.size() > 0 ? params[0]->kind() : results[0]->kind();
+  size_t num_params = params.size();
+  size_t num_results = results.size();
+  for (size_t i = 0; i < num_params; ++i) {
+    if (params[i]->kind() != kind) return GenericTrampoline;
+  }
+  for (size_t i = 0; i < num_results; ++i) {
+    if (results[i]->kind() != kind) return GenericTrampoline;
+  }
+  Trampoline trampoline = nullptr;
+  switch (kind) {
+    case I32:
+      trampoline = SelectTypedTrampoline<int32_t>(num_params, num_results);
+      break;
+    case I64:
+      trampoline = SelectTypedTrampoline<int64_t>(num_params, num_results);
+      break;
+    case F32:
+      trampoline = SelectTypedTrampoline<float32_t>(num_params, num_results);
+      break;
+    case F64:
+      trampoline = SelectTypedTrampoline<float64_t>(num_params, num_results);
+      break;
+    case ANYREF:
+    case FUNCREF:
+      break;
+  }
+  return trampoline ? trampoline : GenericTrampoline;
+}
+
 // Global Instances
 
 template <>
@@ -105,12 +105,15 @@ class WireBytesStorage {
 // Callbacks will receive either {kFailedCompilation} or both
 // {kFinishedBaselineCompilation} and {kFinishedTopTierCompilation}, in that
 // order. If tier up is off, both events are delivered right after each other.
+// With dynamic tiering, {kFinishedCompilationChunk} is delivered afterwards
+// whenever another --wasm-caching-threshold bytes of code were tiered up.
 enum class CompilationEvent : uint8_t {
   kFinishedBaselineCompilation,
   kFinishedExportWrappers,
   kFinishedTopTierCompilation,
   kFailedCompilation,
-  kFinishedRecompilation
+  kFinishedRecompilation,
+  kFinishedCompilationChunk
 };
 
 // The implementation of {CompilationState} lives in module-compiler.cc.
@@ -133,7 +136,11 @@ class V8_EXPORT_PRIVATE CompilationState {
 
   void AddCallback(callback_t);
 
-  void InitializeAfterDeserialization();
+  // Initializes the compilation progress after deserialization. Functions in
+  // {lazy_functions} have no code yet; those in {tier_up_functions} are also
+  // compiled with TurboFan in the background.
+  void InitializeAfterDeserialization(Vector<const int> lazy_functions,
+                                      Vector<const int> tier_up_functions);
 
   // Wait until top tier compilation finished, or compilation failed.
   void WaitForTopTierFinished();
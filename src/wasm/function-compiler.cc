@@ -206,7 +206,8 @@ WasmCompilationResult WasmCompilationUnit::ExecuteFunctionCompilation(
 
     case ExecutionTier::kTurbofan:
       result = compiler::ExecuteTurbofanWasmCompilation(
-          wasm_engine, env, func_body, func_index_, counters, detected);
+          wasm_engine, env, wire_bytes_storage.get(), func_body, func_index_,
+          counters, detected);
       result.for_debugging = for_debugging_;
       break;
   }
@@ -552,7 +552,8 @@ class CompilationStateImpl {
 
   // Initialize the compilation progress after deserialization. This is needed
   // for recompilation (e.g. for tier down) to work later.
-  void InitializeCompilationProgressAfterDeserialization();
+  void InitializeCompilationProgressAfterDeserialization(
+      Vector<const int> lazy_functions, Vector<const int> tier_up_functions);
 
   // Initialize recompilation of the whole module: Setup compilation progress
   // for recompilation and add the respective compilation units. The callback is
@@ -576,6 +577,10 @@ class CompilationStateImpl {
   void AddTopTierCompilationUnit(WasmCompilationUnit);
   void AddTopTierPriorityCompilationUnit(WasmCompilationUnit, size_t);
 
+  // Moves the collected tier-up units to the compilation unit queues. Returns
+  // whether there were any.
+  bool FlushTierUpBatch();
+
   CompilationUnitQueues::Queue* GetQueueForCompileTask(int task_id);
 
   base::Optional<WasmCompilationUnit> GetNextCompilationUnit(
@@ -731,6 +736,10 @@ class CompilationStateImpl {
   int outstanding_recompilation_functions_ = 0;
   TieringState tiering_state_ = kTieredUp;
 
+  // Size of the code tiered up by dynamic tiering since the last
+  // {kFinishedCompilationChunk} event.
+  size_t bytes_since_last_chunk_ = 0;
+
   // End of fields protected by {callbacks_mutex_}.
   //////////////////////////////////////////////////////////////////////////////
 
@@ -739,6 +748,12 @@ class CompilationStateImpl {
   std::vector<std::unique_ptr<WasmCode>> publish_queue_;
   bool publisher_running_ = false;
 
+  // {tier_up_batch_mutex_} protects {tier_up_batch_}, which collects the units
+  // and priorities added by dynamic tiering until they are handed over to the
+  // compile job.
+  mutable base::Mutex tier_up_batch_mutex_;
+  std::vector<std::pair<WasmCompilationUnit, size_t>> tier_up_batch_;
+
   // Encoding of fields in the {compilation_progress_} vector.
   using RequiredBaselineTierField = base::BitField8<ExecutionTier, 0, 2>;
   using RequiredTopTierField = base::BitField8<ExecutionTier, 2, 2>;
@@ -816,8 +831,10 @@ void CompilationState::WaitForTopTierFinished() {
 
 void CompilationState::SetHighPriority() { Impl(this)->SetHighPriority(); }
 
-void CompilationState::InitializeAfterDeserialization() {
-  Impl(this)->InitializeCompilationProgressAfterDeserialization();
+void CompilationState::InitializeAfterDeserialization(
+    Vector<const int> lazy_functions, Vector<const int> tier_up_functions) {
+  Impl(this)->InitializeCompilationProgressAfterDeserialization(
+      lazy_functions, tier_up_functions);
 }
 
 bool CompilationState::failed() const { return Impl(this)->failed(); }
@@ -916,8 +933,10 @@ ExecutionTierPair GetRequestedExecutionTiers(
 
     case CompileMode::kTiering:
 
-      // Default tiering behaviour.
-      result.top_tier = ExecutionTier::kTurbofan;
+      // Default tiering behaviour. With dynamic tiering, functions are only
+      // tiered up once they get hot, see {TriggerTierUp}.
+      result.top_tier = FLAG_wasm_dynamic_tiering ? result.baseline_tier
+                                                  : ExecutionTier::kTurbofan;
 
       // Check if compilation hints override default tiering behaviour.
       if (enabled_features.has_compilation_hints()) {
@@ -1062,34 +1081,131 @@ enum OnlyLazyFunctions : bool {
   kOnlyLazyFunctions = true,
 };
 
-void ValidateSequentially(
-    const WasmModule* module, NativeModule* native_module, Counters* counters,
-    AccountingAllocator* allocator, ErrorThrower* thrower, bool lazy_module,
-    OnlyLazyFunctions only_lazy_functions = kAllFunctions) {
-  DCHECK(!thrower->error());
-  uint32_t start = module->num_imported_functions;
-  uint32_t end = start + module->num_declared_functions;
-  auto enabled_features = native_module->enabled_features();
-  for (uint32_t func_index = start; func_index < end; func_index++) {
+// Validates the declared functions of a module on worker threads, with the
+// calling thread contributing. Functions are picked in increasing index order,
+// so the reported error is always the one of the first invalid function.
+class ValidateFunctionsJob final : public JobTask {
+ public:
+  ValidateFunctionsJob(const WasmModule* module, ModuleWireBytes wire_bytes,
+                       const WasmFeatures& enabled_features, bool lazy_module,
+                       OnlyLazyFunctions only_lazy_functions,
+                       Counters* counters, AccountingAllocator* allocator)
+      : module_(module),
+        wire_bytes_(wire_bytes),
+        enabled_features_(enabled_features),
+        lazy_module_(lazy_module),
+        only_lazy_functions_(only_lazy_functions),
+        counters_(counters),
+        allocator_(allocator),
+        end_(module->num_imported_functions + module->num_declared_functions),
+        next_function_(module->num_imported_functions) {}
+
+  void Run(JobDelegate* delegate) override {
+    do {
+      int func_index = next_function_.fetch_add(1, std::memory_order_relaxed);
+      if (func_index >= end()) return;
+      ValidateFunction(func_index);
+    } while (delegate == nullptr || !delegate->ShouldYield());
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    int remaining = end() - next_function_.load(std::memory_order_relaxed);
+    if (remaining <= 0) return 0;
+    return std::min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
+                    worker_count + static_cast<size_t>(remaining));
+  }
+
+  // Returns the index of the first invalid function and sets {error}, or
+  // returns -1 if all functions are valid.
+  int GetError(WasmError* error) {
+    int func_index = error_func_index_.load(std::memory_order_relaxed);
+    if (func_index == kMaxInt) return -1;
+    base::MutexGuard guard(&error_mutex_);
+    *error = error_;
+    return func_index;
+  }
+
+ private:
+  // Functions after an invalid one do not need to be validated.
+  int end() const {
+    return std::min(end_, error_func_index_.load(std::memory_order_relaxed));
+  }
+
+  void ValidateFunction(int func_index) {
     // Skip non-lazy functions if requested.
-    if (only_lazy_functions) {
-      CompileStrategy strategy =
-          GetCompileStrategy(module, enabled_features, func_index, lazy_module);
+    if (only_lazy_functions_) {
+      CompileStrategy strategy = GetCompileStrategy(
+          module_, enabled_features_, func_index, lazy_module_);
       if (strategy != CompileStrategy::kLazy &&
           strategy != CompileStrategy::kLazyBaselineEagerTopTier) {
-        continue;
+        return;
       }
     }
 
-    ModuleWireBytes wire_bytes{native_module->wire_bytes()};
-    const WasmFunction* func = &module->functions[func_index];
-    Vector<const uint8_t> code = wire_bytes.GetFunctionBytes(func);
-    DecodeResult result = ValidateSingleFunction(
-        module, func_index, code, counters, allocator, enabled_features);
-    if (result.failed()) {
-      SetCompileError(thrower, wire_bytes, func, module, result.error());
-    }
+    const WasmFunction* func = &module_->functions[func_index];
+    Vector<const uint8_t> code = wire_bytes_.GetFunctionBytes(func);
+    DecodeResult result =
+        ValidateSingleFunction(module_, func_index, code, counters_,
+                               allocator_, enabled_features_);
+    if (result.ok()) return;
+    base::MutexGuard guard(&error_mutex_);
+    if (func_index > error_func_index_.load(std::memory_order_relaxed)) return;
+    error_func_index_.store(func_index, std::memory_order_relaxed);
+    error_ = result.error();
+  }
+
+  const WasmModule* const module_;
+  const ModuleWireBytes wire_bytes_;
+  const WasmFeatures enabled_features_;
+  const bool lazy_module_;
+  const OnlyLazyFunctions only_lazy_functions_;
+  Counters* const counters_;
+  AccountingAllocator* const allocator_;
+  const int end_;
+  std::atomic<int> next_function_;
+  std::atomic<int> error_func_index_{kMaxInt};
+  base::Mutex error_mutex_;
+  WasmError error_;
+};
+
+// Validates the functions of {module} and returns the index of the first
+// invalid one (setting {error}), or -1 if all of them are valid.
+int ValidateFunctions(const WasmModule* module, ModuleWireBytes wire_bytes,
+                      const WasmFeatures& enabled_features, bool lazy_module,
+                      OnlyLazyFunctions only_lazy_functions, Counters* counters,
+                      AccountingAllocator* allocator, WasmError* error) {
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("v8.wasm.detailed"),
+               "wasm.ValidateFunctions", "num_functions",
+               module->num_declared_functions);
+  auto job = std::make_unique<ValidateFunctionsJob>(
+      module, wire_bytes, enabled_features, lazy_module, only_lazy_functions,
+      counters, allocator);
+  if (FLAG_wasm_parallel_validation && FLAG_wasm_num_compilation_tasks > 0) {
+    ValidateFunctionsJob* validate_job = job.get();
+    auto job_handle = V8::GetCurrentPlatform()->PostJob(
+        TaskPriority::kUserBlocking, std::move(job));
+    // Wait for completion, while contributing to the work. The handle keeps
+    // the job alive.
+    job_handle->Join();
+    return validate_job->GetError(error);
   }
+  job->Run(nullptr);
+  return job->GetError(error);
+}
+
+void ValidateFunctions(
+    const WasmModule* module, NativeModule* native_module, Counters* counters,
+    AccountingAllocator* allocator, ErrorThrower* thrower, bool lazy_module,
+    OnlyLazyFunctions only_lazy_functions = kAllFunctions) {
+  DCHECK(!thrower->error());
+  ModuleWireBytes wire_bytes{native_module->wire_bytes()};
+  WasmError error;
+  int func_index = ValidateFunctions(
+      module, wire_bytes, native_module->enabled_features(), lazy_module,
+      only_lazy_functions, counters, allocator, &error);
+  if (func_index < 0) return;
+  SetCompileError(thrower, wire_bytes, &module->functions[func_index], module,
+                  error);
 }
 
 bool IsLazyModule(const WasmModule* module) {
@@ -1172,19 +1288,36 @@ bool CompileLazy(Isolate* isolate, Handle<WasmModuleObject> module_object,
   return true;
 }
 
+namespace {
+
+size_t GetLiftoffCallCount(const NativeModule* native_module, int func_index) {
+  uint32_t* call_array = native_module->num_liftoff_function_calls_array();
+  int offset =
+      wasm::declared_function_index(native_module->module(), func_index);
+  return base::Relaxed_Load(reinterpret_cast<int*>(&call_array[offset]));
+}
+
+}  // namespace
+
+bool IsHotFunction(const NativeModule* native_module, int func_index) {
+  return GetLiftoffCallCount(native_module, func_index) >=
+         static_cast<size_t>(FLAG_wasm_tiering_budget);
+}
+
 void TriggerTierUp(Isolate* isolate, NativeModule* native_module,
                    int func_index) {
+  // Liftoff code calls into the runtime whenever the call count reaches a power
+  // of two. Below the budget, these calls are ignored; above it, they increase
+  // the priority of the tier-up unit.
+  if (!IsHotFunction(native_module, func_index)) return;
+  if (native_module->HasCodeWithTier(func_index, ExecutionTier::kTurbofan)) {
+    return;
+  }
   CompilationStateImpl* compilation_state =
       Impl(native_module->compilation_state());
   WasmCompilationUnit tiering_unit{func_index, ExecutionTier::kTurbofan,
                                    kNoDebugging};
-
-  uint32_t* call_array = native_module->num_liftoff_function_calls_array();
-  int offset =
-      wasm::declared_function_index(native_module->module(), func_index);
-
-  size_t priority =
-      base::Relaxed_Load(reinterpret_cast<int*>(&call_array[offset]));
+  size_t priority = GetLiftoffCallCount(native_module, func_index);
   compilation_state->AddTopTierPriorityCompilationUnit(tiering_unit, priority);
 }
 
@@ -1549,9 +1682,9 @@ void CompileNativeModule(Isolate* isolate,
     // Validate wasm modules for lazy compilation if requested. Never validate
     // asm.js modules as these are valid by construction (additionally a CHECK
     // will catch this during lazy compilation).
-    ValidateSequentially(wasm_module, native_module.get(), isolate->counters(),
-                         isolate->allocator(), thrower, lazy_module,
-                         kOnlyLazyFunctions);
+    ValidateFunctions(wasm_module, native_module.get(), isolate->counters(),
+                      isolate->allocator(), thrower, lazy_module,
+                      kOnlyLazyFunctions);
     // On error: Return and leave the module in an unexecutable state.
     if (thrower->error()) return;
   }
@@ -1574,8 +1707,8 @@ void CompileNativeModule(Isolate* isolate,
 
   if (compilation_state->failed()) {
     DCHECK_IMPLIES(lazy_module, !FLAG_wasm_lazy_validation);
-    ValidateSequentially(wasm_module, native_module.get(), isolate->counters(),
-                         isolate->allocator(), thrower, lazy_module);
+    ValidateFunctions(wasm_module, native_module.get(), isolate->counters(),
+                      isolate->allocator(), thrower, lazy_module);
     CHECK(thrower->error());
     return;
   }
@@ -1594,8 +1727,8 @@ void CompileNativeModule(Isolate* isolate,
 
   if (compilation_state->failed()) {
     DCHECK_IMPLIES(lazy_module, !FLAG_wasm_lazy_validation);
-    ValidateSequentially(wasm_module, native_module.get(), isolate->counters(),
-                         isolate->allocator(), thrower, lazy_module);
+    ValidateFunctions(wasm_module, native_module.get(), isolate->counters(),
+                      isolate->allocator(), thrower, lazy_module);
     CHECK(thrower->error());
   } else if (FLAG_predictable) {
     compilation_state->FinalizeJSToWasmWrappers(
@@ -1691,6 +1824,10 @@ std::shared_ptr<NativeModule> CompileToNativeModule(
     return native_module;
   }
 
+  if (WasmCodeCache* code_cache = isolate->wasm_engine()->code_cache()) {
+    code_cache->StoreAfterTopTier(isolate->wasm_engine(), native_module);
+  }
+
   // Ensure that the code objects are logged before returning.
   isolate->wasm_engine()->LogOutstandingCodesForIsolate(isolate);
 
@@ -1802,6 +1939,10 @@ class AsyncStreamingProcessor final : public StreamingProcessor {
 
   void CommitCompilationUnits();
 
+  // Finishes the AsyncCompileJob with the module from the persistent code
+  // cache instead of the streamed one, if the entry matches the wire bytes.
+  bool FinishFromCodeCache();
+
   ModuleDecoder decoder_;
   AsyncCompileJob* job_;
   WasmEngine* wasm_engine_;
@@ -1816,6 +1957,10 @@ class AsyncStreamingProcessor final : public StreamingProcessor {
   // code section itself. Used by the {NativeModuleCache} to detect potential
   // duplicate modules.
   size_t prefix_hash_;
+
+  // Entry of the persistent code cache with the same prefix hash, loaded in
+  // the background while the module is streamed and compiled.
+  std::shared_ptr<WasmCodeCache::PendingEntry> code_cache_entry_;
 };
 
 std::shared_ptr<StreamingDecoder> AsyncCompileJob::CreateStreamingDecoder() {
@@ -1868,6 +2013,16 @@ void AsyncCompileJob::CreateNativeModule(
 
 bool AsyncCompileJob::GetOrCreateNativeModule(
     std::shared_ptr<const WasmModule> module, size_t code_size_estimate) {
+  WasmCodeCache* code_cache = isolate_->wasm_engine()->code_cache();
+  if (code_cache && !code_cache_entry_.empty()) {
+    DCHECK_EQ(kWasmOrigin, module->origin);
+    // This has to happen before {MaybeGetNativeModule} claims the cache entry
+    // that deserialization would wait for.
+    WasmCodeCache::Entry entry = std::move(code_cache_entry_);
+    native_module_ = code_cache->DeserializeNativeModule(
+        isolate_, entry, wire_bytes_.module_bytes());
+    if (native_module_) return true;
+  }
   native_module_ = isolate_->wasm_engine()->MaybeGetNativeModule(
       module->origin, wire_bytes_.module_bytes(), isolate_);
   if (native_module_ == nullptr) {
@@ -1988,9 +2143,9 @@ void AsyncCompileJob::AsyncCompileFailed() {
   ErrorThrower thrower(isolate_, api_method_name_);
   DCHECK_EQ(native_module_->module()->origin, kWasmOrigin);
   const bool lazy_module = wasm_lazy_compilation_;
-  ValidateSequentially(native_module_->module(), native_module_.get(),
-                       isolate_->counters(), isolate_->allocator(), &thrower,
-                       lazy_module);
+  ValidateFunctions(native_module_->module(), native_module_.get(),
+                    isolate_->counters(), isolate_->allocator(), &thrower,
+                    lazy_module);
   DCHECK(thrower.error());
   // {job} keeps the {this} pointer alive.
   std::shared_ptr<AsyncCompileJob> job =
@@ -2058,6 +2213,10 @@ class AsyncCompileJob::CompilationStateCallback {
         // {kFinishedTopTierCompilation}, hence don't remember this in
         // {last_event_}.
         return;
+      case CompilationEvent::kFinishedCompilationChunk:
+        // Delivered after {kFinishedTopTierCompilation}, when the job is
+        // already gone.
+        return;
     }
 #ifdef DEBUG
     last_event_ = event;
@@ -2225,32 +2384,22 @@ class AsyncCompileJob::DecodeModule : public AsyncCompileJob::CompileStep {
         const bool lazy_module = job->wasm_lazy_compilation_;
         if (MayCompriseLazyFunctions(module, enabled_features, lazy_module)) {
           auto allocator = job->isolate()->wasm_engine()->allocator();
-          int start = module->num_imported_functions;
-          int end = start + module->num_declared_functions;
-
-          for (int func_index = start; func_index < end; func_index++) {
-            const WasmFunction* func = &module->functions[func_index];
-            Vector<const uint8_t> code =
-                job->wire_bytes_.GetFunctionBytes(func);
-
-            CompileStrategy strategy = GetCompileStrategy(
-                module, enabled_features, func_index, lazy_module);
-            bool validate_lazily_compiled_function =
-                strategy == CompileStrategy::kLazy ||
-                strategy == CompileStrategy::kLazyBaselineEagerTopTier;
-            if (validate_lazily_compiled_function) {
-              DecodeResult function_result =
-                  ValidateSingleFunction(module, func_index, code, counters_,
-                                         allocator, enabled_features);
-              if (function_result.failed()) {
-                result = ModuleResult(function_result.error());
-                break;
-              }
-            }
+          WasmError error;
+          if (ValidateFunctions(module, job->wire_bytes_, enabled_features,
+                                lazy_module, kOnlyLazyFunctions, counters_,
+                                allocator, &error) >= 0) {
+            result = ModuleResult(std::move(error));
           }
         }
       }
     }
+    WasmCodeCache* code_cache = job->isolate()->wasm_engine()->code_cache();
+    if (code_cache && result.ok()) {
+      // Load the entry of the persistent code cache while still in the
+      // background; it is deserialized in {PrepareAndStartCompile}.
+      job->code_cache_entry_ =
+          code_cache->Load(job->wire_bytes_.module_bytes());
+    }
     if (result.failed()) {
       // Decoding failure; reject the promise and clean up.
       job->DoSync<DecodeFail>(std::move(result).error());
@@ -2324,6 +2473,10 @@ class AsyncCompileJob::PrepareAndStartCompile : public CompileStep {
     CompilationStateImpl* compilation_state =
         Impl(job->native_module_->compilation_state());
     compilation_state->AddCallback(CompilationStateCallback{job});
+    WasmEngine* engine = job->isolate_->wasm_engine();
+    if (WasmCodeCache* code_cache = engine->code_cache()) {
+      code_cache->StoreAfterTopTier(engine, job->native_module_);
+    }
     if (base::TimeTicks::IsHighResolution()) {
       auto compile_mode = job->stream_ == nullptr
                               ? CompilationTimeCallback::kAsync
@@ -2556,6 +2709,13 @@ bool AsyncStreamingProcessor::ProcessCodeSectionHeader(
     return true;
   }
 
+  // An entry in the persistent code cache might be stale, so keep streaming
+  // and check it against the full wire bytes at the end.
+  if (WasmCodeCache* code_cache = wasm_engine_->code_cache()) {
+    code_cache_entry_ =
+        code_cache->LoadInBackground(wasm_engine_, prefix_hash_);
+  }
+
   // Execute the PrepareAndStartCompile step immediately and not in a separate
   // task.
   int num_imported_functions =
@@ -2711,6 +2871,8 @@ void AsyncStreamingProcessor::OnFinishedStream(OwnedVector<uint8_t> bytes) {
     constexpr size_t kCodeSizeEstimate = 0;
     cache_hit = job_->GetOrCreateNativeModule(std::move(result).value(),
                                               kCodeSizeEstimate);
+  } else if (FinishFromCodeCache()) {
+    return;
   } else {
     job_->native_module_->SetWireBytes(
         {std::move(job_->bytes_copy_), job_->wire_bytes_.length()});
@@ -2731,6 +2893,28 @@ void AsyncStreamingProcessor::OnFinishedStream(OwnedVector<uint8_t> bytes) {
   }
 }
 
+bool AsyncStreamingProcessor::FinishFromCodeCache() {
+  if (!code_cache_entry_) return false;
+  WasmCodeCache* code_cache = wasm_engine_->code_cache();
+  // Do not wait if the entry is still being loaded.
+  WasmCodeCache::Entry entry = WasmCodeCache::Match(
+      code_cache_entry_->TryTake(), job_->wire_bytes_.module_bytes());
+  code_cache_entry_.reset();
+  if (code_cache == nullptr || entry.empty()) return false;
+  std::shared_ptr<NativeModule> native_module =
+      code_cache->DeserializeNativeModule(job_->isolate_, entry,
+                                          job_->wire_bytes_.module_bytes());
+  if (!native_module) return false;
+
+  // Stop compiling the streamed module. This also removes the callback that
+  // would finish the job, so no other finisher remains.
+  Impl(job_->native_module_->compilation_state())->CancelCompilation();
+  wasm_engine_->StreamingCompilationFailed(prefix_hash_);
+  job_->native_module_ = std::move(native_module);
+  job_->FinishCompile(true);
+  return true;
+}
+
 // Report an error detected in the StreamingDecoder.
 void AsyncStreamingProcessor::OnError(const WasmError& error) {
   TRACE_STREAMING("Stream error...\n");
@@ -2863,19 +3047,41 @@ void CompilationStateImpl::InitializeCompilationProgress(
   TriggerCallbacks();
 }
 
-void CompilationStateImpl::InitializeCompilationProgressAfterDeserialization() {
+void CompilationStateImpl::InitializeCompilationProgressAfterDeserialization(
+    Vector<const int> lazy_functions, Vector<const int> tier_up_functions) {
   auto* module = native_module_->module();
-  base::MutexGuard guard(&callbacks_mutex_);
-  DCHECK(compilation_progress_.empty());
-  constexpr uint8_t kProgressAfterDeserialization =
-      RequiredBaselineTierField::encode(ExecutionTier::kTurbofan) |
-      RequiredTopTierField::encode(ExecutionTier::kTurbofan) |
-      ReachedTierField::encode(ExecutionTier::kTurbofan);
-  finished_events_.Add(CompilationEvent::kFinishedExportWrappers);
-  finished_events_.Add(CompilationEvent::kFinishedBaselineCompilation);
-  finished_events_.Add(CompilationEvent::kFinishedTopTierCompilation);
-  compilation_progress_.assign(module->num_declared_functions,
-                               kProgressAfterDeserialization);
+  {
+    base::MutexGuard guard(&callbacks_mutex_);
+    DCHECK(compilation_progress_.empty());
+    constexpr uint8_t kProgressAfterDeserialization =
+        RequiredBaselineTierField::encode(ExecutionTier::kTurbofan) |
+        RequiredTopTierField::encode(ExecutionTier::kTurbofan) |
+        ReachedTierField::encode(ExecutionTier::kTurbofan);
+    finished_events_.Add(CompilationEvent::kFinishedExportWrappers);
+    finished_events_.Add(CompilationEvent::kFinishedBaselineCompilation);
+    finished_events_.Add(CompilationEvent::kFinishedTopTierCompilation);
+    compilation_progress_.assign(module->num_declared_functions,
+                                 kProgressAfterDeserialization);
+    constexpr uint8_t kProgressForLazyFunctions =
+        RequiredBaselineTierField::encode(ExecutionTier::kNone) |
+        RequiredTopTierField::encode(ExecutionTier::kNone) |
+        ReachedTierField::encode(ExecutionTier::kNone);
+    for (int func_index : lazy_functions) {
+      compilation_progress_[declared_function_index(module, func_index)] =
+          kProgressForLazyFunctions;
+    }
+  }
+
+  // Functions that were hot when the module was serialized are tiered up in
+  // the background right away, instead of waiting until they get hot again.
+  if (tier_up_functions.empty()) return;
+  std::vector<WasmCompilationUnit> tier_up_units;
+  tier_up_units.reserve(tier_up_functions.size());
+  for (int func_index : tier_up_functions) {
+    tier_up_units.emplace_back(func_index, ExecutionTier::kTurbofan,
+                               kNoDebugging);
+  }
+  AddCompilationUnits({}, VectorOf(tier_up_units), {});
 }
 
 void CompilationStateImpl::InitializeRecompilation(
@@ -2973,7 +3179,9 @@ void CompilationStateImpl::AddCallback(CompilationState::callback_t callback) {
   constexpr base::EnumSet<CompilationEvent> kFinalEvents{
       CompilationEvent::kFinishedTopTierCompilation,
       CompilationEvent::kFailedCompilation};
-  if (!finished_events_.contains_any(kFinalEvents)) {
+  if (!finished_events_.contains_any(kFinalEvents) ||
+      (FLAG_wasm_dynamic_tiering &&
+       !finished_events_.contains(CompilationEvent::kFailedCompilation))) {
     callbacks_.emplace_back(std::move(callback));
   }
 }
@@ -3007,8 +3215,29 @@ void CompilationStateImpl::AddTopTierCompilationUnit(WasmCompilationUnit unit) {
 
 void CompilationStateImpl::AddTopTierPriorityCompilationUnit(
     WasmCompilationUnit unit, size_t priority) {
-  compilation_unit_queues_.AddTopTierPriorityUnit(unit, priority);
-  compile_job_->NotifyConcurrencyIncrease();
+  {
+    base::MutexGuard guard(&tier_up_batch_mutex_);
+    tier_up_batch_.emplace_back(unit, priority);
+    // While there are units left to compile, collect tier-up units and hand
+    // them over in batches. Compile tasks pick up an incomplete batch once they
+    // run out of units, see {GetNextCompilationUnit}.
+    if (tier_up_batch_.size() <
+            static_cast<size_t>(FLAG_wasm_tiering_batch_size) &&
+        compilation_unit_queues_.GetTotalSize() > 0) {
+      return;
+    }
+  }
+  if (FlushTierUpBatch()) compile_job_->NotifyConcurrencyIncrease();
+}
+
+bool CompilationStateImpl::FlushTierUpBatch() {
+  base::MutexGuard guard(&tier_up_batch_mutex_);
+  if (tier_up_batch_.empty()) return false;
+  for (auto& entry : tier_up_batch_) {
+    compilation_unit_queues_.AddTopTierPriorityUnit(entry.first, entry.second);
+  }
+  tier_up_batch_.clear();
+  return true;
 }
 
 std::shared_ptr<JSToWasmWrapperCompilationUnit>
@@ -3056,7 +3285,12 @@ CompilationUnitQueues::Queue* CompilationStateImpl::GetQueueForCompileTask(
 base::Optional<WasmCompilationUnit>
 CompilationStateImpl::GetNextCompilationUnit(
     CompilationUnitQueues::Queue* queue, CompileBaselineOnly baseline_only) {
-  return compilation_unit_queues_.GetNextUnit(queue, baseline_only);
+  base::Optional<WasmCompilationUnit> unit =
+      compilation_unit_queues_.GetNextUnit(queue, baseline_only);
+  if (!unit && !baseline_only && FlushTierUpBatch()) {
+    unit = compilation_unit_queues_.GetNextUnit(queue, baseline_only);
+  }
+  return unit;
 }
 
 void CompilationStateImpl::OnFinishedUnits(Vector<WasmCode*> code_vector) {
@@ -3065,6 +3299,24 @@ void CompilationStateImpl::OnFinishedUnits(Vector<WasmCode*> code_vector) {
 
   base::MutexGuard guard(&callbacks_mutex_);
 
+  // With dynamic tiering, code keeps getting tiered up after the top tier
+  // compilation finished. Let embedders cache the module again once enough
+  // new code is available.
+  if (FLAG_wasm_dynamic_tiering &&
+      finished_events_.contains(
+          CompilationEvent::kFinishedTopTierCompilation)) {
+    for (WasmCode* code : code_vector) {
+      if (code->tier() != ExecutionTier::kTurbofan) continue;
+      bytes_since_last_chunk_ += code->instructions().size();
+    }
+    if (bytes_since_last_chunk_ >=
+        static_cast<size_t>(FLAG_wasm_caching_threshold)) {
+      bytes_since_last_chunk_ = 0;
+      TriggerCallbacks(base::EnumSet<CompilationEvent>(
+          {CompilationEvent::kFinishedCompilationChunk}));
+    }
+  }
+
   // In case of no outstanding compilation units we can return early.
   // This is especially important for lazy modules that were deserialized.
   // Compilation progress was not set up in these cases.
@@ -3186,9 +3438,11 @@ void CompilationStateImpl::TriggerCallbacks(
 
   // Don't trigger past events again.
   triggered_events -= finished_events_;
-  // Recompilation can happen multiple times, thus do not store this.
-  finished_events_ |=
-      triggered_events - CompilationEvent::kFinishedRecompilation;
+  // Recompilation and compilation chunks can happen multiple times, thus do
+  // not store them.
+  finished_events_ |= triggered_events -
+                      CompilationEvent::kFinishedRecompilation -
+                      CompilationEvent::kFinishedCompilationChunk;
 
   for (auto event :
        {std::make_pair(CompilationEvent::kFailedCompilation,
@@ -3200,7 +3454,9 @@ void CompilationStateImpl::TriggerCallbacks(
         std::make_pair(CompilationEvent::kFinishedTopTierCompilation,
                        "wasm.TopTierFinished"),
         std::make_pair(CompilationEvent::kFinishedRecompilation,
-                       "wasm.RecompilationFinished")}) {
+                       "wasm.RecompilationFinished"),
+        std::make_pair(CompilationEvent::kFinishedCompilationChunk,
+                       "wasm.CompilationChunkFinished")}) {
     if (!triggered_events.contains(event.first)) continue;
     DCHECK_NE(compilation_id_, kInvalidCompilationID);
     TRACE_EVENT1("v8.wasm", event.second, "id", compilation_id_);
@@ -3209,10 +3465,12 @@ void CompilationStateImpl::TriggerCallbacks(
     }
   }
 
+  // Clear the callbacks because no more events will be delivered. With
+  // dynamic tiering, compilation chunks keep finishing.
   if (outstanding_baseline_units_ == 0 && outstanding_export_wrappers_ == 0 &&
       outstanding_top_tier_functions_ == 0 &&
-      outstanding_recompilation_functions_ == 0) {
-    // Clear the callbacks because no more events will be delivered.
+      outstanding_recompilation_functions_ == 0 &&
+      !FLAG_wasm_dynamic_tiering) {
     callbacks_.clear();
   }
 }
@@ -3303,7 +3561,13 @@ size_t CompilationStateImpl::NumOutstandingCompilations() const {
   size_t outstanding_wrappers =
       outstanding_js_to_wasm_wrappers_.load(std::memory_order_relaxed);
   size_t outstanding_functions = compilation_unit_queues_.GetTotalSize();
-  return outstanding_wrappers + outstanding_functions;
+  size_t outstanding_tier_up_units;
+  {
+    base::MutexGuard guard(&tier_up_batch_mutex_);
+    outstanding_tier_up_units = tier_up_batch_.size();
+  }
+  return outstanding_wrappers + outstanding_functions +
+         outstanding_tier_up_units;
 }
 
 void CompilationStateImpl::SetError() {
@@ -18,6 +18,7 @@
 #include "src/logging/metrics.h"
 #include "src/tasks/cancelable-task.h"
 #include "src/wasm/compilation-environment.h"
+#include "src/wasm/wasm-code-cache.h"
 #include "src/wasm/wasm-features.h"
 #include "src/wasm/wasm-import-wrapper-cache.h"
 #include "src/wasm/wasm-module.h"
@@ -72,6 +73,10 @@ bool CompileLazy(Isolate*, Handle<WasmModuleObject>, int func_index);
 
 void TriggerTierUp(Isolate*, NativeModule*, int func_index);
 
+// Returns whether the Liftoff code of {func_index} was called often enough to
+// be tiered up by dynamic tiering (see --wasm-tiering-budget).
+V8_EXPORT_PRIVATE bool IsHotFunction(const NativeModule*, int func_index);
+
 template <typename Key, typename Hash>
 class WrapperQueue {
  public:
@@ -214,6 +219,9 @@ class AsyncCompileJob {
   // Reference to the wire bytes (held in {bytes_copy_} or as part of
   // {native_module_}).
   ModuleWireBytes wire_bytes_;
+  // Entry of the persistent code cache for {wire_bytes_}, loaded while
+  // decoding the module.
+  WasmCodeCache::Entry code_cache_entry_;
   Handle<NativeContext> native_context_;
   Handle<Context> incumbent_context_;
   v8::metrics::Recorder::ContextId context_id_;
@@ -23,6 +23,9 @@ base::Optional<wasm::ValueKind> WasmReturnTypeFromSignature(
       case kF32:
       case kF64:
         return {return_type.kind()};
+      case kOptRef:
+        DCHECK_EQ(return_type.heap_representation(), HeapType::kExtern);
+        return {return_type.kind()};
       default:
         UNREACHABLE();
     }
@@ -0,0 +1,241 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/wasm-code-cache.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "include/v8-platform.h"
+#include "src/base/memory.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/wrappers.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/init/v8.h"
+#include "src/tasks/operations-barrier.h"
+#include "src/wasm/compilation-environment.h"
+#include "src/wasm/wasm-code-manager.h"
+#include "src/wasm/wasm-engine.h"
+#include "src/wasm/wasm-module.h"
+#include "src/wasm/wasm-serialization.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+namespace {
+
+uint32_t ReadWord(const uint8_t* data, int index) {
+  return base::ReadUnalignedValue<uint32_t>(
+      reinterpret_cast<Address>(data) + index * kUInt32Size);
+}
+
+void WriteWord(uint8_t* data, int index, uint32_t value) {
+  base::WriteUnalignedValue<uint32_t>(
+      reinterpret_cast<Address>(data) + index * kUInt32Size, value);
+}
+
+}  // namespace
+
+std::string DirectoryCodeCacheStorage::FileName(size_t key) const {
+  char name[32];
+  snprintf(name, sizeof(name), "/%016" PRIx64 ".wasm-cache",
+           static_cast<uint64_t>(key));
+  return directory_ + name;
+}
+
+OwnedVector<uint8_t> DirectoryCodeCacheStorage::Load(size_t key) {
+  FILE* file = base::OS::FOpen(FileName(key).c_str(), "rb");
+  if (file == nullptr) return {};
+  OwnedVector<uint8_t> data;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    long size = ftell(file);  // NOLINT(runtime/int)
+    if (size > 0 && fseek(file, 0, SEEK_SET) == 0) {
+      data = OwnedVector<uint8_t>::NewForOverwrite(static_cast<size_t>(size));
+      if (fread(data.start(), 1, data.size(), file) != data.size()) {
+        data = {};
+      }
+    }
+  }
+  base::Fclose(file);
+  return data;
+}
+
+void DirectoryCodeCacheStorage::Store(size_t key, Vector<const uint8_t> data) {
+  std::string file_name = FileName(key);
+  std::string temp_name =
+      file_name + ".tmp" + std::to_string(base::OS::GetCurrentProcessId()) +
+      "-" + std::to_string(next_temp_id_.fetch_add(1));
+  FILE* file = base::OS::FOpen(temp_name.c_str(), "wb");
+  if (file == nullptr) return;
+  bool success = fwrite(data.begin(), 1, data.size(), file) == data.size();
+  success = base::Fclose(file) == 0 && success;
+  if (!success || std::rename(temp_name.c_str(), file_name.c_str()) != 0) {
+    base::OS::Remove(temp_name.c_str());
+  }
+}
+
+class WasmCodeCache::LoadTask final : public v8::Task {
+ public:
+  LoadTask(WasmCodeCache* cache, size_t prefix_hash,
+           std::shared_ptr<PendingEntry> pending,
+           std::shared_ptr<OperationsBarrier> engine_barrier)
+      : cache_(cache),
+        prefix_hash_(prefix_hash),
+        pending_(std::move(pending)),
+        engine_barrier_(std::move(engine_barrier)) {}
+
+  void Run() override {
+    OperationsBarrier::Token engine_scope = engine_barrier_->TryLock();
+    if (!engine_scope) return;
+    // Nobody waits for the entry any more.
+    if (pending_.use_count() == 1) return;
+    OwnedVector<uint8_t> data = cache_->storage_->Load(prefix_hash_);
+    base::MutexGuard guard(&pending_->mutex_);
+    pending_->data_ = std::move(data);
+  }
+
+ private:
+  WasmCodeCache* const cache_;
+  const size_t prefix_hash_;
+  const std::shared_ptr<PendingEntry> pending_;
+  const std::shared_ptr<OperationsBarrier> engine_barrier_;
+};
+
+class WasmCodeCache::StoreTask final : public v8::Task {
+ public:
+  StoreTask(WasmCodeCache* cache, std::weak_ptr<NativeModule> native_module,
+            std::shared_ptr<OperationsBarrier> engine_barrier)
+      : cache_(cache),
+        native_module_(std::move(native_module)),
+        engine_barrier_(std::move(engine_barrier)) {}
+
+  void Run() override {
+    // The barrier keeps the engine, and with it the cache, alive.
+    OperationsBarrier::Token engine_scope = engine_barrier_->TryLock();
+    if (!engine_scope) return;
+    std::shared_ptr<NativeModule> native_module = native_module_.lock();
+    if (!native_module) return;
+    cache_->Store(native_module.get());
+  }
+
+ private:
+  WasmCodeCache* const cache_;
+  const std::weak_ptr<NativeModule> native_module_;
+  const std::shared_ptr<OperationsBarrier> engine_barrier_;
+};
+
+WasmCodeCache::Entry WasmCodeCache::Load(Vector<const uint8_t> wire_bytes) {
+  return Match(storage_->Load(NativeModuleCache::PrefixHash(wire_bytes)),
+               wire_bytes);
+}
+
+std::shared_ptr<WasmCodeCache::PendingEntry> WasmCodeCache::LoadInBackground(
+    WasmEngine* engine, size_t prefix_hash) {
+  auto pending = std::make_shared<PendingEntry>();
+  V8::GetCurrentPlatform()->CallOnWorkerThread(std::make_unique<LoadTask>(
+      this, prefix_hash, pending, engine->GetBarrierForBackgroundCompile()));
+  return pending;
+}
+
+// static
+WasmCodeCache::Entry WasmCodeCache::Match(OwnedVector<uint8_t> data,
+                                          Vector<const uint8_t> wire_bytes) {
+  constexpr size_t kHeaderBytes = kHeaderSize * kUInt32Size;
+  if (data.size() < kHeaderBytes) return {};
+  const uint8_t* start = data.start();
+  if (ReadWord(start, kMagicNumberIndex) != kMagicNumber ||
+      ReadWord(start, kWireBytesLengthIndex) != wire_bytes.size()) {
+    return {};
+  }
+  size_t serialized_length = ReadWord(start, kSerializedLengthIndex);
+  if (data.size() != kHeaderBytes + wire_bytes.size() + serialized_length ||
+      memcmp(start + kHeaderBytes, wire_bytes.begin(), wire_bytes.size()) !=
+          0) {
+    return {};
+  }
+  Vector<const uint8_t> serialized_module(
+      start + kHeaderBytes + wire_bytes.size(), serialized_length);
+  return {std::move(data), serialized_module};
+}
+
+std::shared_ptr<NativeModule> WasmCodeCache::DeserializeNativeModule(
+    Isolate* isolate, const Entry& entry, Vector<const uint8_t> wire_bytes) {
+  DCHECK(!entry.empty());
+  std::shared_ptr<NativeModule> native_module = GetOrDeserializeNativeModule(
+      isolate, entry.serialized_module, wire_bytes);
+  if (native_module) {
+    StoreAfterTieringChunks(isolate->wasm_engine(), native_module);
+  }
+  return native_module;
+}
+
+void WasmCodeCache::StoreAfterTopTier(
+    WasmEngine* engine, const std::shared_ptr<NativeModule>& native_module) {
+  StoreAfterEvents(engine, native_module,
+                   base::EnumSet<CompilationEvent>(
+                       {CompilationEvent::kFinishedTopTierCompilation,
+                        CompilationEvent::kFinishedCompilationChunk}));
+}
+
+void WasmCodeCache::StoreAfterTieringChunks(
+    WasmEngine* engine, const std::shared_ptr<NativeModule>& native_module) {
+  // The deserialized code is already in the cache, but with dynamic tiering,
+  // more functions get hot over time.
+  if (!FLAG_wasm_dynamic_tiering) return;
+  StoreAfterEvents(engine, native_module,
+                   base::EnumSet<CompilationEvent>(
+                       {CompilationEvent::kFinishedCompilationChunk}));
+}
+
+void WasmCodeCache::StoreAfterEvents(
+    WasmEngine* engine, const std::shared_ptr<NativeModule>& native_module,
+    base::EnumSet<CompilationEvent> events) {
+  // Lazily compiled modules reach the top tier without any code.
+  if (FLAG_wasm_lazy_compilation) return;
+  if (native_module->module()->origin != kWasmOrigin) return;
+  std::weak_ptr<NativeModule> weak_module = native_module;
+  std::shared_ptr<OperationsBarrier> engine_barrier =
+      engine->GetBarrierForBackgroundCompile();
+  // Compilation callbacks run on background threads and hold a lock, so
+  // serialization is left to a separate task.
+  native_module->compilation_state()->AddCallback(
+      [this, weak_module, engine_barrier, events](CompilationEvent event) {
+        if (!events.contains(event)) return;
+        V8::GetCurrentPlatform()->CallOnWorkerThread(
+            std::make_unique<StoreTask>(this, weak_module, engine_barrier));
+      });
+}
+
+void WasmCodeCache::Store(NativeModule* native_module) {
+  // Code compiled for debugging is not worth keeping.
+  if (native_module->IsTieredDown()) return;
+  Vector<const uint8_t> wire_bytes = native_module->wire_bytes();
+  WasmSerializer serializer(native_module);
+  size_t serialized_length = serializer.GetSerializedNativeModuleSize();
+  if (wire_bytes.size() > kMaxUInt32 || serialized_length > kMaxUInt32) return;
+
+  constexpr size_t kHeaderBytes = kHeaderSize * kUInt32Size;
+  OwnedVector<uint8_t> entry = OwnedVector<uint8_t>::NewForOverwrite(
+      kHeaderBytes + wire_bytes.size() + serialized_length);
+  uint8_t* data = entry.start();
+  WriteWord(data, kMagicNumberIndex, kMagicNumber);
+  WriteWord(data, kWireBytesLengthIndex,
+            static_cast<uint32_t>(wire_bytes.size()));
+  WriteWord(data, kSerializedLengthIndex,
+            static_cast<uint32_t>(serialized_length));
+  memcpy(data + kHeaderBytes, wire_bytes.begin(), wire_bytes.size());
+  if (!serializer.SerializeNativeModule(entry.as_vector().SubVector(
+          kHeaderBytes + wire_bytes.size(), entry.size()))) {
+    return;
+  }
+  storage_->Store(NativeModuleCache::PrefixHash(wire_bytes),
+                  entry.as_vector());
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,166 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !V8_ENABLE_WEBASSEMBLY
+#error This header should only be included if WebAssembly is enabled.
+#endif  // !V8_ENABLE_WEBASSEMBLY
+
+#ifndef V8_WASM_WASM_CODE_CACHE_H_
+#define V8_WASM_WASM_CODE_CACHE_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "src/base/enum-set.h"
+#include "src/base/platform/mutex.h"
+#include "src/utils/vector.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+
+namespace wasm {
+
+class NativeModule;
+class WasmEngine;
+enum class CompilationEvent : uint8_t;
+
+// Backing store of the {WasmCodeCache}. Entries are opaque byte sequences
+// keyed by a hash; the cache validates them when they are loaded.
+// Implementations must be thread-safe: entries are loaded and stored from
+// background threads, and may do blocking IO.
+class V8_EXPORT_PRIVATE WasmCodeCacheStorage {
+ public:
+  virtual ~WasmCodeCacheStorage() = default;
+
+  // Returns the entry stored for {key}, or an empty vector.
+  virtual OwnedVector<uint8_t> Load(size_t key) = 0;
+
+  // Stores {data} for {key}, replacing any previous entry.
+  virtual void Store(size_t key, Vector<const uint8_t> data) = 0;
+};
+
+// Stores each entry in its own file in a directory. Files are written under a
+// temporary name and then renamed, so that readers in other processes never
+// see partially written entries.
+class V8_EXPORT_PRIVATE DirectoryCodeCacheStorage final
+    : public WasmCodeCacheStorage {
+ public:
+  explicit DirectoryCodeCacheStorage(const char* directory)
+      : directory_(directory) {}
+
+  OwnedVector<uint8_t> Load(size_t key) override;
+  void Store(size_t key, Vector<const uint8_t> data) override;
+
+ private:
+  std::string FileName(size_t key) const;
+
+  const std::string directory_;
+  std::atomic<int> next_temp_id_{0};
+};
+
+// The engine-wide persistent code cache. Once the top tier compilation of a
+// module finished, its code is serialized and stored; compiling the same wire
+// bytes later, e.g. in another process, deserializes the module instead of
+// compiling it again.
+//
+// Asynchronous compilation loads the entry while decoding the module in the
+// background. Streaming compilation starts loading it at the code section
+// header and keeps compiling; if the entry matches once the stream finished,
+// the deserialized module replaces the streamed one. Synchronous compilation
+// does not use the cache, it must not wait for IO.
+//
+// Entries are keyed by {NativeModuleCache::PrefixHash}, which streaming
+// compilation knows before the function bodies arrive. Since modules with
+// the same prefix share a key, every entry also contains the wire bytes it was
+// compiled from, and is only used if they match exactly:
+//   uint32_t magic number, wire bytes length, serialized module length,
+//   followed by the wire bytes and the serialized module (see
+//   {WasmSerializer}), which checks version, flags and CPU features itself.
+class V8_EXPORT_PRIVATE WasmCodeCache {
+ public:
+  // An entry that matches the wire bytes it was loaded for, or an empty entry.
+  struct Entry {
+    bool empty() const { return data.empty(); }
+
+    OwnedVector<uint8_t> data;
+    // The serialized module within {data}.
+    Vector<const uint8_t> serialized_module;
+  };
+
+  // The raw entry for a prefix hash, loaded by a background task.
+  class PendingEntry {
+   public:
+    // Returns the entry if it has been loaded, without waiting for it.
+    OwnedVector<uint8_t> TryTake() {
+      base::MutexGuard guard(&mutex_);
+      return std::move(data_);
+    }
+
+   private:
+    friend class WasmCodeCache;
+
+    base::Mutex mutex_;
+    OwnedVector<uint8_t> data_;
+  };
+
+  explicit WasmCodeCache(std::unique_ptr<WasmCodeCacheStorage> storage)
+      : storage_(std::move(storage)) {}
+
+  // Loads the entry for {wire_bytes}. This blocks on the storage, so it must
+  // be called on a background thread.
+  Entry Load(Vector<const uint8_t> wire_bytes);
+
+  // Starts loading the entry for {prefix_hash} in a background task. Once the
+  // full wire bytes are known, the result is checked by {Match}.
+  std::shared_ptr<PendingEntry> LoadInBackground(WasmEngine* engine,
+                                                 size_t prefix_hash);
+
+  // Returns {data} as an entry if it was stored for exactly {wire_bytes}.
+  static Entry Match(OwnedVector<uint8_t> data,
+                     Vector<const uint8_t> wire_bytes);
+
+  // Deserializes the {NativeModule} of a loaded {entry}, or returns nullptr.
+  std::shared_ptr<NativeModule> DeserializeNativeModule(
+      Isolate* isolate, const Entry& entry, Vector<const uint8_t> wire_bytes);
+
+  // Stores the code of {native_module} in a background task once its top tier
+  // compilation finished. With dynamic tiering, the module is stored again
+  // whenever another chunk of code was tiered up.
+  void StoreAfterTopTier(WasmEngine* engine,
+                         const std::shared_ptr<NativeModule>& native_module);
+
+  // Serializes and stores {native_module} right away.
+  void Store(NativeModule* native_module);
+
+ private:
+  class LoadTask;
+  class StoreTask;
+
+  static constexpr uint32_t kMagicNumber = 0x43434157;  // "WACC"
+
+  static constexpr int kMagicNumberIndex = 0;
+  static constexpr int kWireBytesLengthIndex = 1;
+  static constexpr int kSerializedLengthIndex = 2;
+  static constexpr int kHeaderSize = 3;
+
+  // With dynamic tiering, stores a deserialized {native_module} again whenever
+  // another chunk of code was tiered up.
+  void StoreAfterTieringChunks(
+      WasmEngine* engine, const std::shared_ptr<NativeModule>& native_module);
+
+  void StoreAfterEvents(WasmEngine* engine,
+                        const std::shared_ptr<NativeModule>& native_module,
+                        base::EnumSet<CompilationEvent> events);
+
+  const std::unique_ptr<WasmCodeCacheStorage> storage_;
+};
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_WASM_WASM_CODE_CACHE_H_
@@ -641,8 +641,17 @@ Vector<byte> WasmCodeAllocator::AllocateForCodeInRegion(
   DCHECK_LT(0, size);
   v8::PageAllocator* page_allocator = GetPlatformPageAllocator();
   size = RoundUp<kCodeAlignment>(size);
-  base::AddressRegion code_space =
-      free_code_space_.AllocateInRegion(size, region);
+  // Prefer code space freed by the wasm code GC (e.g. Liftoff code replaced by
+  // TurboFan code) over growing into unused code space.
+  base::AddressRegion code_space = AllocateInFreedCodeSpace(size, region);
+  if (!code_space.is_empty()) {
+    generated_code_size_.fetch_add(code_space.size(),
+                                   std::memory_order_relaxed);
+    TRACE_HEAP("Code alloc (reused) for %p: 0x%" PRIxPTR ",+%zu\n", this,
+               code_space.begin(), size);
+    return {reinterpret_cast<byte*>(code_space.begin()), code_space.size()};
+  }
+  code_space = free_code_space_.AllocateInRegion(size, region);
   if (V8_UNLIKELY(code_space.is_empty())) {
     // Only allocations without a specific region are allowed to fail. Otherwise
     // the region must have been allocated big enough to hold all initial
@@ -703,6 +712,58 @@ Vector<byte> WasmCodeAllocator::AllocateForCodeInRegion(
   return {reinterpret_cast<byte*>(code_space.begin()), code_space.size()};
 }
 
+base::AddressRegion WasmCodeAllocator::AllocateInFreedCodeSpace(
+    size_t size, base::AddressRegion region) {
+  if (V8_UNLIKELY(!ReusesFreedCodeSpace())) return {};
+  if (freed_code_space_.IsEmpty()) return {};
+  // Never allocate across the boundary of two reservations, even if they are
+  // adjacent, so that the code can reach the jump tables of its code space.
+  base::AddressRegion code_space;
+  for (auto& vmem : owned_code_space_) {
+    base::AddressRegion overlap = vmem.region().GetOverlap(region);
+    if (overlap.size() < size) continue;
+    code_space = freed_code_space_.AllocateInRegion(size, overlap);
+    if (!code_space.is_empty()) break;
+  }
+  if (code_space.is_empty()) return {};
+
+  // {FreeCode} decommitted all full pages of the freed region that contained
+  // {code_space}. Find the remaining parts of that region to recommit the
+  // decommitted pages which overlap {code_space}.
+  Address freed_begin = code_space.begin();
+  Address freed_end = code_space.end();
+  const auto& freed_regions = freed_code_space_.regions();
+  auto above = freed_regions.lower_bound(code_space);
+  if (above != freed_regions.end() && above->begin() == code_space.end()) {
+    freed_end = above->end();
+  }
+  if (above != freed_regions.begin()) {
+    auto below = std::prev(above);
+    if (below->end() == code_space.begin()) freed_begin = below->begin();
+  }
+  size_t commit_page_size = GetPlatformPageAllocator()->CommitPageSize();
+  Address commit_start =
+      std::max(RoundUp(freed_begin, commit_page_size),
+               RoundDown(code_space.begin(), commit_page_size));
+  Address commit_end = std::min(RoundDown(freed_end, commit_page_size),
+                                RoundUp(code_space.end(), commit_page_size));
+  if (commit_start < commit_end) {
+    for (base::AddressRegion split_range : SplitRangeByReservationsIfNeeded(
+             {commit_start, commit_end - commit_start}, owned_code_space_)) {
+      code_manager_->Commit(split_range);
+    }
+    committed_code_space_.fetch_add(commit_end - commit_start);
+  }
+  // {code_space} is still part of {allocated_code_space_}.
+  return code_space;
+}
+
+// static
+bool WasmCodeAllocator::ReusesFreedCodeSpace() {
+  return !FLAG_perf_prof && !FLAG_perf_basic_prof && !FLAG_prof &&
+         !FLAG_log_code && !FLAG_gdbjit;
+}
+
 bool WasmCodeAllocator::SetExecutable(bool executable) {
   base::MutexGuard lock(&mutex_);
   if (is_executable_ == executable) return true;
@@ -747,18 +808,14 @@ bool WasmCodeAllocator::SetExecutable(bool executable) {
   return true;
 }
 
-void WasmCodeAllocator::FreeCode(Vector<WasmCode* const> codes) {
-  // Zap code area and collect freed code regions.
-  DisjointAllocationPool freed_regions;
+void WasmCodeAllocator::FreeCode(const DisjointAllocationPool& freed_regions) {
+  // Zap the freed code regions.
   size_t code_size = 0;
   CODE_SPACE_WRITE_SCOPE
-  for (WasmCode* code : codes) {
-    ZapCode(code->instruction_start(), code->instructions().size());
-    FlushInstructionCache(code->instruction_start(),
-                          code->instructions().size());
-    code_size += code->instructions().size();
-    freed_regions.Merge(base::AddressRegion{code->instruction_start(),
-                                            code->instructions().size()});
+  for (auto region : freed_regions.regions()) {
+    ZapCode(region.begin(), region.size());
+    FlushInstructionCache(region.begin(), region.size());
+    code_size += region.size();
   }
   freed_code_size_.fetch_add(code_size);
 
@@ -768,19 +825,20 @@ void WasmCodeAllocator::FreeCode(Vector<WasmCode* const> codes) {
   DisjointAllocationPool regions_to_decommit;
   PageAllocator* allocator = GetPlatformPageAllocator();
   size_t commit_page_size = allocator->CommitPageSize();
-  {
-    base::MutexGuard guard(&mutex_);
-    for (auto region : freed_regions.regions()) {
-      auto merged_region = freed_code_space_.Merge(region);
-      Address discard_start =
-          std::max(RoundUp(merged_region.begin(), commit_page_size),
-                   RoundDown(region.begin(), commit_page_size));
-      Address discard_end =
-          std::min(RoundDown(merged_region.end(), commit_page_size),
-                   RoundUp(region.end(), commit_page_size));
-      if (discard_start >= discard_end) continue;
-      regions_to_decommit.Merge({discard_start, discard_end - discard_start});
-    }
+  // Decommit while still holding the lock: once the regions are in
+  // {freed_code_space_}, {AllocateInFreedCodeSpace} may hand them out again,
+  // and a late decommit would discard the new code.
+  base::MutexGuard guard(&mutex_);
+  for (auto region : freed_regions.regions()) {
+    auto merged_region = freed_code_space_.Merge(region);
+    Address discard_start =
+        std::max(RoundUp(merged_region.begin(), commit_page_size),
+                 RoundDown(region.begin(), commit_page_size));
+    Address discard_end =
+        std::min(RoundDown(merged_region.end(), commit_page_size),
+                 RoundUp(region.end(), commit_page_size));
+    if (discard_start >= discard_end) continue;
+    regions_to_decommit.Merge({discard_start, discard_end - discard_start});
   }
 
   for (auto region : regions_to_decommit.regions()) {
@@ -2110,8 +2168,13 @@ std::vector<int> NativeModule::FindFunctionsToRecompile(
 }
 
 void NativeModule::FreeCode(Vector<WasmCode* const> codes) {
-  // Free the code space.
-  code_allocator_.FreeCode(codes);
+  // Collect the code regions (including alignment padding) to free.
+  DisjointAllocationPool freed_regions;
+  for (WasmCode* code : codes) {
+    freed_regions.Merge(
+        {code->instruction_start(),
+         RoundUp<kCodeAlignment>(code->instructions().size())});
+  }
 
   DebugInfo* debug_info = nullptr;
   {
@@ -2124,6 +2187,11 @@ void NativeModule::FreeCode(Vector<WasmCode* const> codes) {
       owned_code_.erase(code->instruction_start());
     }
   }
+
+  // Free the code space only now, because it can be reused for new code (at
+  // the same addresses) right away.
+  code_allocator_.FreeCode(freed_regions);
+
   // Remove debug side tables for all removed code objects, after releasing our
   // lock. This is to avoid lock order inversion.
   if (debug_info) debug_info->RemoveDebugSideTables(codes);
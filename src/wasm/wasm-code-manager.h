@@ -446,8 +446,14 @@ class WasmCodeAllocator {
   // {executable} is false). Returns true on success.
   V8_EXPORT_PRIVATE bool SetExecutable(bool executable);
 
-  // Free memory pages of all given code objects. Used for wasm code GC.
-  void FreeCode(Vector<WasmCode* const>);
+  // Free the given code regions. Full pages are decommitted, and the regions
+  // can be reused by later allocations. Used for wasm code GC.
+  void FreeCode(const DisjointAllocationPool& freed_regions);
+
+  // Whether freed code space is reused. Profilers and debuggers that record
+  // code addresses (perf, --prof, GDB JIT) are not told about freed code, so
+  // they would attribute new code to the function freed at the same address.
+  V8_EXPORT_PRIVATE static bool ReusesFreedCodeSpace();
 
   // Retrieve the number of separately reserved code spaces.
   size_t GetNumCodeSpaces() const;
@@ -458,6 +464,12 @@ class WasmCodeAllocator {
   static constexpr base::AddressRegion kUnrestrictedRegion{
       kNullAddress, std::numeric_limits<size_t>::max()};
 
+  // Allocate code space within {region} from {freed_code_space_}, and commit
+  // the pages that were decommitted when the code space was freed. Returns an
+  // empty region on failure. Requires {mutex_} to be held.
+  base::AddressRegion AllocateInFreedCodeSpace(size_t size,
+                                               base::AddressRegion region);
+
   // The engine-wide wasm code manager.
   WasmCodeManager* const code_manager_;
 
@@ -472,7 +484,8 @@ class WasmCodeAllocator {
   // Code space that was allocated for code (subset of {owned_code_space_}).
   DisjointAllocationPool allocated_code_space_;
   // Code space that was allocated before but is dead now. Full pages within
-  // this region are discarded. It's still a subset of {owned_code_space_}.
+  // this region are discarded. It's still a subset of {owned_code_space_} and
+  // of {allocated_code_space_}, and is reused for new allocations.
   DisjointAllocationPool freed_code_space_;
   std::vector<VirtualMemory> owned_code_space_;
 
@@ -628,6 +641,11 @@ class V8_EXPORT_PRIVATE NativeModule final {
   size_t generated_code_size() const {
     return code_allocator_.generated_code_size();
   }
+  size_t freed_code_size() const { return code_allocator_.freed_code_size(); }
+  // Size of the code that was generated and not freed by the wasm code GC yet.
+  size_t live_code_size() const {
+    return generated_code_size() - freed_code_size();
+  }
   size_t liftoff_bailout_count() const { return liftoff_bailout_count_.load(); }
   size_t liftoff_code_size() const { return liftoff_code_size_.load(); }
   size_t turbofan_code_size() const { return turbofan_code_size_.load(); }
@@ -695,7 +713,7 @@ class V8_EXPORT_PRIVATE NativeModule final {
   // Get or create the debug info for this NativeModule.
   DebugInfo* GetDebugInfo();
 
-  uint32_t* num_liftoff_function_calls_array() {
+  uint32_t* num_liftoff_function_calls_array() const {
     return num_liftoff_function_calls_.get();
   }
 
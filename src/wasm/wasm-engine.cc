@@ -425,7 +425,12 @@ struct WasmEngine::NativeModuleInfo {
   int8_t num_code_gcs_triggered = 0;
 };
 
-WasmEngine::WasmEngine() : code_manager_(FLAG_wasm_max_code_space * MB) {}
+WasmEngine::WasmEngine() : code_manager_(FLAG_wasm_max_code_space * MB) {
+  if (FLAG_wasm_code_cache_dir != nullptr) {
+    SetCodeCacheStorage(
+        std::make_unique<DirectoryCodeCacheStorage>(FLAG_wasm_code_cache_dir));
+  }
+}
 
 WasmEngine::~WasmEngine() {
 #ifdef V8_ENABLE_WASM_GDB_REMOTE_DEBUGGING
@@ -445,6 +450,12 @@ WasmEngine::~WasmEngine() {
   DCHECK(native_module_cache_.empty());
 }
 
+void WasmEngine::SetCodeCacheStorage(
+    std::unique_ptr<WasmCodeCacheStorage> storage) {
+  code_cache_ = storage ? std::make_unique<WasmCodeCache>(std::move(storage))
+                        : nullptr;
+}
+
 bool WasmEngine::SyncValidate(Isolate* isolate, const WasmFeatures& enabled,
                               const ModuleWireBytes& bytes) {
   TRACE_EVENT0("v8.wasm", "wasm.SyncValidate");
@@ -1246,6 +1257,18 @@ class SampleTopTierCodeSizeTask : public CancelableTask {
 };
 }  // namespace
 
+void WasmEngine::GetCodeStatistics(Isolate* isolate, size_t* code_size,
+                                   size_t* committed_code_size) {
+  *code_size = 0;
+  *committed_code_size = 0;
+  base::MutexGuard lock(&mutex_);
+  DCHECK_EQ(1, isolates_.count(isolate));
+  for (NativeModule* native_module : isolates_[isolate]->native_modules) {
+    *code_size += native_module->live_code_size();
+    *committed_code_size += native_module->committed_code_space();
+  }
+}
+
 void WasmEngine::SampleTopTierCodeSizeInAllIsolates(
     const std::shared_ptr<NativeModule>& native_module) {
   base::MutexGuard lock(&mutex_);
@@ -1347,6 +1370,9 @@ void WasmEngine::FreeDeadCodeLocked(const DeadCodeMap& dead_code) {
       info->dead_code.erase(code);
     }
     native_module->FreeCode(VectorOf(code_vec));
+    TRACE_CODE_GC("Module %p: %zu bytes of live code, %zu bytes committed.\n",
+                  native_module, native_module->live_code_size(),
+                  native_module->committed_code_space());
   }
 }
 
@@ -19,6 +19,7 @@
 #include "src/base/platform/mutex.h"
 #include "src/tasks/cancelable-task.h"
 #include "src/tasks/operations-barrier.h"
+#include "src/wasm/wasm-code-cache.h"
 #include "src/wasm/wasm-code-manager.h"
 #include "src/wasm/wasm-tier.h"
 #include "src/zone/accounting-allocator.h"
@@ -218,6 +219,12 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   WasmCodeManager* code_manager() { return &code_manager_; }
 
+  // The persistent code cache, or nullptr if there is none. It is created from
+  // --wasm-code-cache-dir, or by {SetCodeCacheStorage}, which must be called
+  // before any module is compiled.
+  WasmCodeCache* code_cache() { return code_cache_.get(); }
+  void SetCodeCacheStorage(std::unique_ptr<WasmCodeCacheStorage> storage);
+
   AccountingAllocator* allocator() { return &allocator_; }
 
   // Compilation statistics for TurboFan compilations.
@@ -312,6 +319,11 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   void FreeNativeModule(NativeModule*);
 
+  // Sum up the live code size and the committed code space of all
+  // NativeModules used by the given Isolate.
+  void GetCodeStatistics(Isolate*, size_t* code_size,
+                         size_t* committed_code_size);
+
   // Sample the code size of the given {NativeModule} in all isolates that have
   // access to it. Call this after top-tier compilation finished.
   // This will spawn foreground tasks that do *not* keep the NativeModule alive.
@@ -380,6 +392,7 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   WasmCodeManager code_manager_;
   AccountingAllocator allocator_;
+  std::unique_ptr<WasmCodeCache> code_cache_;
 
 #ifdef V8_ENABLE_WASM_GDB_REMOTE_DEBUGGING
   // Implements a GDB-remote stub for WebAssembly debugging.
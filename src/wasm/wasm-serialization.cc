@@ -189,7 +189,14 @@ uint32_t GetWasmCalleeTag(RelocInfo* rinfo) {
 
 constexpr size_t kHeaderSize = sizeof(size_t);  // total code size
 
-constexpr size_t kCodeHeaderSize = sizeof(bool) +  // whether code is present
+// Precedes every function in the serialized module.
+enum class SerializedCodeStatus : uint8_t {
+  kLazy,     // No code; the function is compiled lazily.
+  kTierUp,   // No code; the function was hot and is tiered up eagerly.
+  kHasCode,  // TurboFan code follows.
+};
+
+constexpr size_t kCodeHeaderSize = sizeof(SerializedCodeStatus) +
                                    sizeof(int) +   // offset of constant pool
                                    sizeof(int) +   // offset of safepoint table
                                    sizeof(int) +   // offset of handler table
@@ -302,10 +309,11 @@ NativeModuleSerializer::NativeModuleSerializer(
 }
 
 size_t NativeModuleSerializer::MeasureCode(const WasmCode* code) const {
-  if (code == nullptr) return sizeof(bool);
+  if (code == nullptr) return sizeof(SerializedCodeStatus);
   DCHECK_EQ(WasmCode::kFunction, code->kind());
-  if (FLAG_wasm_lazy_compilation && code->tier() != ExecutionTier::kTurbofan) {
-    return sizeof(bool);
+  if ((FLAG_wasm_lazy_compilation || FLAG_wasm_dynamic_tiering) &&
+      code->tier() != ExecutionTier::kTurbofan) {
+    return sizeof(SerializedCodeStatus);
   }
   return kCodeHeaderSize + code->instructions().size() +
          code->reloc_info().size() + code->source_positions().size() +
@@ -331,20 +339,29 @@ void NativeModuleSerializer::WriteHeader(Writer* writer,
 bool NativeModuleSerializer::WriteCode(const WasmCode* code, Writer* writer) {
   DCHECK_IMPLIES(!FLAG_wasm_lazy_compilation, code != nullptr);
   if (code == nullptr) {
-    writer->Write(false);
+    writer->Write(SerializedCodeStatus::kLazy);
     return true;
   }
   DCHECK_EQ(WasmCode::kFunction, code->kind());
   // Only serialize TurboFan code, as Liftoff code can contain breakpoints or
   // non-relocatable constants.
   if (code->tier() != ExecutionTier::kTurbofan) {
+    // With dynamic tiering, remember which functions were hot, so that they
+    // are tiered up right away after deserialization. All others start out in
+    // Liftoff again.
+    if (FLAG_wasm_dynamic_tiering) {
+      writer->Write(IsHotFunction(native_module_, code->index())
+                        ? SerializedCodeStatus::kTierUp
+                        : SerializedCodeStatus::kLazy);
+      return true;
+    }
     if (FLAG_wasm_lazy_compilation) {
-      writer->Write(false);
+      writer->Write(SerializedCodeStatus::kLazy);
       return true;
     }
     return false;
   }
-  writer->Write(true);
+  writer->Write(SerializedCodeStatus::kHasCode);
   // Write the size of the entire code section, followed by the code header.
   writer->Write(code->constant_pool_offset());
   writer->Write(code->safepoint_table_offset());
@@ -534,6 +551,11 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
 
   bool Read(Reader* reader);
 
+  Vector<const int> lazy_functions() const { return VectorOf(lazy_functions_); }
+  Vector<const int> tier_up_functions() const {
+    return VectorOf(tier_up_functions_);
+  }
+
  private:
   friend class CopyAndRelocTask;
   friend class PublishTask;
@@ -552,6 +574,8 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   size_t remaining_code_size_ = 0;
   Vector<byte> current_code_space_;
   NativeModule::JumpTablesRef current_jump_tables_;
+  std::vector<int> lazy_functions_;
+  std::vector<int> tier_up_functions_;
 };
 
 class CopyAndRelocTask : public JobTask {
@@ -683,11 +707,15 @@ void NativeModuleDeserializer::ReadHeader(Reader* reader) {
 
 DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
                                                        Reader* reader) {
-  bool has_code = reader->Read<bool>();
-  if (!has_code) {
-    DCHECK(FLAG_wasm_lazy_compilation ||
+  SerializedCodeStatus status = reader->Read<SerializedCodeStatus>();
+  if (status != SerializedCodeStatus::kHasCode) {
+    DCHECK(FLAG_wasm_lazy_compilation || FLAG_wasm_dynamic_tiering ||
            native_module_->enabled_features().has_compilation_hints());
     native_module_->UseLazyStub(fn_index);
+    lazy_functions_.push_back(fn_index);
+    if (status == SerializedCodeStatus::kTierUp) {
+      tier_up_functions_.push_back(fn_index);
+    }
     return {};
   }
   int constant_pool_offset = reader->Read<int>();
@@ -818,10 +846,9 @@ bool IsSupportedVersion(Vector<const byte> header) {
          0;
 }
 
-MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+std::shared_ptr<NativeModule> GetOrDeserializeNativeModule(
     Isolate* isolate, Vector<const byte> data,
-    Vector<const byte> wire_bytes_vec, Vector<const char> source_url) {
-  if (!IsWasmCodegenAllowed(isolate, isolate->native_context())) return {};
+    Vector<const byte> wire_bytes_vec) {
   if (!IsSupportedVersion(data)) return {};
 
   // Make the copy of the wire bytes early, so we use the same memory for
@@ -860,11 +887,24 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
     NativeModuleDeserializer deserializer(shared_native_module.get());
     Reader reader(data + WasmSerializer::kHeaderSize);
     bool error = !deserializer.Read(&reader);
-    shared_native_module->compilation_state()->InitializeAfterDeserialization();
+    shared_native_module->compilation_state()->InitializeAfterDeserialization(
+        deserializer.lazy_functions(),
+        error ? Vector<const int>{} : deserializer.tier_up_functions());
     wasm_engine->UpdateNativeModuleCache(error, &shared_native_module, isolate);
     if (error) return {};
   }
+  return shared_native_module;
+}
+
+MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+    Isolate* isolate, Vector<const byte> data,
+    Vector<const byte> wire_bytes_vec, Vector<const char> source_url) {
+  if (!IsWasmCodegenAllowed(isolate, isolate->native_context())) return {};
+  std::shared_ptr<NativeModule> shared_native_module =
+      GetOrDeserializeNativeModule(isolate, data, wire_bytes_vec);
+  if (!shared_native_module) return {};
 
+  WasmEngine* wasm_engine = isolate->wasm_engine();
   Handle<FixedArray> export_wrappers;
   CompileJsToWasmWrappers(isolate, shared_native_module->module(),
                           &export_wrappers);
@@ -56,6 +56,11 @@ class V8_EXPORT_PRIVATE WasmSerializer {
 // Checks the version header of the data against the current version.
 bool IsSupportedVersion(Vector<const byte> data);
 
+// Returns the {NativeModule} for {wire_bytes} from the native module cache, or
+// deserializes it from {data}. Returns nullptr if deserialization failed.
+V8_EXPORT_PRIVATE std::shared_ptr<NativeModule> GetOrDeserializeNativeModule(
+    Isolate*, Vector<const byte> data, Vector<const byte> wire_bytes);
+
 // Deserializes the given data to create a Wasm module object.
 V8_EXPORT_PRIVATE MaybeHandle<WasmModuleObject> DeserializeNativeModule(
     Isolate*, Vector<const byte> data, Vector<const byte> wire_bytes,
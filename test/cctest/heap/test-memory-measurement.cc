@@ -241,7 +241,7 @@ TEST(PartiallyInitializedJSFunction) {
   isolate->RegisterDeserializerStarted();
   // 2. Set the context field to the uninitialized sentintel.
   TaggedField<Object, JSFunction::kContextOffset>::store(
-      *js_function, Deserializer::uninitialized_field_value());
+      *js_function, Deserializer<Isolate>::uninitialized_field_value());
   // 3. Request memory meaurement and run all tasks. GC that runs as part
   // of the measurement should not crash.
   CcTest::isolate()->MeasureMemory(
@@ -271,7 +271,7 @@ TEST(PartiallyInitializedContext) {
   isolate->RegisterDeserializerStarted();
   // 2. Set the native context field to the uninitialized sentintel.
   TaggedField<Object, Map::kConstructorOrBackPointerOrNativeContextOffset>::
-      store(*map, Deserializer::uninitialized_field_value());
+      store(*map, Deserializer<Isolate>::uninitialized_field_value());
   // 3. Request memory meaurement and run all tasks. GC that runs as part
   // of the measurement should not crash.
   CcTest::isolate()->MeasureMemory(
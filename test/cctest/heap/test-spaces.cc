@@ -36,6 +36,7 @@
 #include "src/heap/large-spaces.h"
 #include "src/heap/memory-allocator.h"
 #include "src/heap/memory-chunk.h"
+#include "src/heap/read-only-heap.h"
 #include "src/heap/spaces-inl.h"
 #include "src/heap/spaces.h"
 #include "src/objects/free-space.h"
@@ -44,6 +45,7 @@
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/heap-tester.h"
 #include "test/cctest/heap/heap-utils.h"
+#include "test/common/flag-utils.h"
 
 namespace v8 {
 namespace internal {
@@ -977,6 +979,92 @@ TEST(ReadOnlySpaceMetrics_TwoPages) {
   CHECK_EQ(faked_space->Capacity(), 2 * capacity_per_page);
 }
 
+namespace {
+
+void RunInNewIsolate() {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    CHECK_EQ(6, CompileRun("'abc'.length + [1, 2, 3].length")
+                    ->Int32Value(context)
+                    .FromJust());
+    CcTest::CollectAllAvailableGarbage(reinterpret_cast<Isolate*>(isolate));
+  }
+  isolate->Dispose();
+}
+
+size_t FileSize(const char* file_name) {
+  FILE* file = base::OS::FOpen(file_name, "rb");
+  if (file == nullptr) return 0;
+  CHECK_EQ(0, fseek(file, 0, SEEK_END));
+  size_t size = static_cast<size_t>(ftell(file));
+  fclose(file);
+  return size;
+}
+
+}  // namespace
+
+UNINITIALIZED_TEST(ReadOnlySpaceFile) {
+  if (!ReadOnlyHeap::IsReadOnlySpaceShared() || !COMPRESS_POINTERS_BOOL) {
+    return;
+  }
+  std::string file_name = "read-only-space-test-" +
+                          std::to_string(base::OS::GetCurrentProcessId());
+  FlagScope<const char*> file_scope(&FLAG_read_only_space_file,
+                                    file_name.c_str());
+
+  // Without a fixed hash seed, the file is neither used nor written.
+  {
+    FlagScope<uint64_t> hash_seed_scope(&FLAG_hash_seed, 0);
+    RunInNewIsolate();
+    CHECK_EQ(0, FileSize(file_name.c_str()));
+  }
+  FlagScope<uint64_t> hash_seed_scope(&FLAG_hash_seed, 1337);
+
+  // The first Isolate deserializes the read-only space and writes the file.
+  RunInNewIsolate();
+  size_t size = FileSize(file_name.c_str());
+  CHECK_GT(size, 0);
+
+  // Once no Isolate remains, the next one maps the read-only space from the
+  // file.
+  RunInNewIsolate();
+  CHECK_EQ(size, FileSize(file_name.c_str()));
+
+  // A corrupt file is ignored and replaced.
+  FILE* file = base::OS::FOpen(file_name.c_str(), "wb");
+  CHECK_NOT_NULL(file);
+  CHECK_EQ(4, fwrite("junk", 1, 4, file));
+  fclose(file);
+  RunInNewIsolate();
+  CHECK_EQ(size, FileSize(file_name.c_str()));
+  RunInNewIsolate();
+
+  // So is a file whose first page would overlap the Isolate at the start of
+  // the cage.
+  const long kFirstPageOffsetPosition = 7 * kUInt32Size;  // NOLINT
+  uint32_t page_offset = 0;
+  file = base::OS::FOpen(file_name.c_str(), "r+b");
+  CHECK_NOT_NULL(file);
+  CHECK_EQ(0, fseek(file, kFirstPageOffsetPosition, SEEK_SET));
+  CHECK_EQ(1, fwrite(&page_offset, kUInt32Size, 1, file));
+  fclose(file);
+  RunInNewIsolate();
+  file = base::OS::FOpen(file_name.c_str(), "rb");
+  CHECK_NOT_NULL(file);
+  CHECK_EQ(0, fseek(file, kFirstPageOffsetPosition, SEEK_SET));
+  CHECK_EQ(1, fread(&page_offset, kUInt32Size, 1, file));
+  fclose(file);
+  CHECK_NE(0, page_offset);
+
+  CHECK(base::OS::Remove(file_name.c_str()));
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
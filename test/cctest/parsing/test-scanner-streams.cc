@@ -409,6 +409,39 @@ TEST(Utf8SingleByteChunks) {
   }
 }
 
+TEST(Utf8SeekAcrossAsciiRuns) {
+  // Non-ASCII characters, including a supplementary one, followed by ASCII
+  // runs that are long enough for the vectorized scan.
+  std::string utf8 = "a\xf0\x9f\x98\x80";
+  std::vector<uint16_t> utf16 = {'a', 0xD83D, 0xDE00};
+  for (int i = 0; i < 80; i++) {
+    utf8 += 'b';
+    utf16.push_back('b');
+  }
+  utf8 += "\xc3\xbc";
+  utf16.push_back(0xFC);
+  for (int i = 0; i < 80; i++) {
+    utf8 += 'c';
+    utf16.push_back('c');
+  }
+
+  const char* chunks[] = {utf8.c_str(), ""};
+  for (size_t position = 0; position < utf16.size(); position++) {
+    // Seeking into the middle of a surrogate pair is not supported.
+    if (position == 2) continue;
+    ChunkSource chunk_source(chunks);
+    std::unique_ptr<v8::internal::Utf16CharacterStream> stream(
+        v8::internal::ScannerStream::For(
+            &chunk_source, v8::ScriptCompiler::StreamedSource::UTF8));
+    stream->Seek(position);
+    for (size_t i = position; i < utf16.size(); i++) {
+      CHECK_EQ(utf16[i], stream->Advance());
+    }
+    CHECK_EQ(v8::internal::Utf16CharacterStream::kEndOfInput,
+             stream->Advance());
+  }
+}
+
 #define CHECK_EQU(v1, v2) CHECK_EQ(static_cast<int>(v1), static_cast<int>(v2))
 
 void TestCharacterStream(const char* reference, i::Utf16CharacterStream* stream,
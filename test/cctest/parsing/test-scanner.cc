@@ -105,5 +105,40 @@ TEST(AllThePushbacks) {
   }
 }
 
+TEST(WhiteSpaceAndCommentRuns) {
+  // Whitespace and comment bodies are skipped a word of code units at a time,
+  // so check runs of every length around the word size, with and without a
+  // line terminator at each position.
+  const struct {
+    const char* prefix;
+    const char* suffix;
+    bool always_after_line_terminator;
+  } test_cases[] = {
+      {"", "", false},
+      {"//", "\n", true},
+      {"/*", "*/", false},
+      {"/* *", "**/", false},
+  };
+
+  for (const auto& test_case : test_cases) {
+    for (int length = 0; length < 20; length++) {
+      for (int newline = -1; newline < length; newline++) {
+        std::string run(length, ' ');
+        if (newline >= 0) run[newline] = '\n';
+        std::string src = std::string("someIdentifier ") + test_case.prefix +
+                          run + test_case.suffix + " x";
+        auto scanner = make_scanner(src.c_str());
+        CHECK_TOK(Token::IDENTIFIER, scanner->Next());
+        CHECK(scanner->CurrentLiteralEquals("someIdentifier"));
+        CHECK_EQ(test_case.always_after_line_terminator || newline >= 0,
+                 scanner->HasLineTerminatorBeforeNext());
+        CHECK_TOK(Token::IDENTIFIER, scanner->Next());
+        CHECK(scanner->CurrentLiteralEquals("x"));
+        CHECK_TOK(Token::EOS, scanner->Next());
+      }
+    }
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -23710,6 +23710,232 @@ TEST(StreamingBiggerScript) {
 }
 
 
+TEST(StreamingParallelEagerCompile) {
+  FlagScope<bool> parallel_flag(&i::FLAG_parallel_streaming_compile, true);
+  FlagScope<bool> finalize_flag(&i::FLAG_finalize_streaming_on_background,
+                                false);
+  // Nested PIFEs are compiled eagerly; siblings can be compiled in parallel.
+  const char* chunk1 =
+      "var a = (function() {\n"
+      "  var inner = (function() { return 4; })();\n"
+      "  return inner + (function() { return 1; })();\n"
+      "})();\n";
+  const char* chunk2 =
+      "var b = (function() {\n"
+      "  return (function() { return 8; })();\n"
+      "})();\n";
+  const char* chunks[] = {chunk1, chunk2, "globalThis.Result = a + b; ",
+                          nullptr};
+  RunStreamingTest(chunks);
+}
+
+TEST(StreamingEagerCompile) {
+  const char* chunks[] = {"function foo() { return bar(); }\n",
+                          "function bar() { return 13; }\n", "foo();",
+                          nullptr};
+  for (bool parallel : {false, true}) {
+    FlagScope<bool> parallel_flag(&i::FLAG_parallel_streaming_compile,
+                                  parallel);
+    FlagScope<bool> finalize_flag(&i::FLAG_finalize_streaming_on_background,
+                                  !parallel);
+    LocalContext env;
+    v8::Isolate* isolate = env->GetIsolate();
+    i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+    v8::HandleScope scope(isolate);
+
+    v8::ScriptCompiler::StreamedSource source(
+        std::make_unique<TestSourceStream>(chunks),
+        v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+    v8::ScriptCompiler::ScriptStreamingTask* task =
+        v8::ScriptCompiler::StartStreaming(isolate, &source,
+                                           v8::ScriptType::kClassic,
+                                           v8::ScriptCompiler::kEagerCompile);
+    task->Run();
+    delete task;
+
+    v8::ScriptOrigin origin(isolate, v8_str("http://foo.com"));
+    char* full_source = TestSourceStream::FullSourceString(chunks);
+    v8::Local<Script> script =
+        v8::ScriptCompiler::Compile(env.local(), &source, v8_str(full_source),
+                                    origin)
+            .ToLocalChecked();
+    delete[] full_source;
+
+    // All functions were compiled before the script ran.
+    i::Handle<i::JSFunction> toplevel = v8::Utils::OpenHandle(*script);
+    i::SharedFunctionInfo::ScriptIterator iterator(
+        i_isolate, i::Script::cast(toplevel->shared().script()));
+    int count = 0;
+    for (i::SharedFunctionInfo info = iterator.Next(); !info.is_null();
+         info = iterator.Next()) {
+      CHECK(info.is_compiled());
+      count++;
+    }
+    CHECK_EQ(3, count);
+
+    v8::Local<Value> result = script->Run(env.local()).ToLocalChecked();
+    CHECK_EQ(13, result->Int32Value(env.local()).FromJust());
+  }
+}
+
+namespace {
+
+int CountCompiledInnerFunctions(v8::Local<v8::UnboundScript> unbound) {
+  i::Handle<i::SharedFunctionInfo> toplevel =
+      i::Handle<i::SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*unbound));
+  i::SharedFunctionInfo::ScriptIterator iterator(
+      toplevel->GetIsolate(), i::Script::cast(toplevel->script()));
+  int count = 0;
+  for (i::SharedFunctionInfo info = iterator.Next(); !info.is_null();
+       info = iterator.Next()) {
+    if (!info.is_toplevel() && info.is_compiled()) count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(CompileHintsMagicComment) {
+  FlagScope<bool> compilation_cache(&i::FLAG_compilation_cache, false);
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  const char* functions =
+      "function f() { return 1; }\n"
+      "var g = () => 2;\n";
+
+  v8::ScriptCompiler::Source lazy_source(v8_str(functions));
+  v8::Local<v8::UnboundScript> lazy =
+      v8::ScriptCompiler::CompileUnboundScript(isolate, &lazy_source)
+          .ToLocalChecked();
+  CHECK_EQ(0, CountCompiledInnerFunctions(lazy));
+
+  i::ScopedVector<char> hinted_source_string(256);
+  i::SNPrintF(hinted_source_string, "//# allFunctionsCalledOnLoad\n%s",
+              functions);
+  v8::ScriptCompiler::Source hinted_source(
+      v8_str(hinted_source_string.begin()));
+  v8::Local<v8::UnboundScript> hinted =
+      v8::ScriptCompiler::CompileUnboundScript(isolate, &hinted_source)
+          .ToLocalChecked();
+  CHECK_EQ(2, CountCompiledInnerFunctions(hinted));
+}
+
+TEST(CompileHintsRoundTrip) {
+  FlagScope<bool> compilation_cache(&i::FLAG_compilation_cache, false);
+  FlagScope<bool> record_calls(&i::FLAG_record_called_functions, true);
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  const char* source =
+      "function f() { return 1; }\n"
+      "function g() { return 2; }\n"
+      "var h = () => 3;\n"
+      "f() + h();\n";
+
+  // Record the functions that ran.
+  v8::ScriptCompiler::Source first_source(v8_str(source));
+  v8::Local<v8::UnboundScript> first =
+      v8::ScriptCompiler::CompileUnboundScript(isolate, &first_source)
+          .ToLocalChecked();
+  CHECK_EQ(0, CountCompiledInnerFunctions(first));
+  v8::Local<Value> result =
+      first->BindToCurrentContext()->Run(env.local()).ToLocalChecked();
+  CHECK_EQ(4, result->Int32Value(env.local()).FromJust());
+  std::vector<int> hints = v8::ScriptCompiler::GetCompileHints(first);
+  CHECK_EQ(2, hints.size());
+
+  // A second compile with these hints compiles f and h, but not g, eagerly.
+  // The hints do not need to be sorted.
+  std::vector<int> reversed_hints(hints.rbegin(), hints.rend());
+  v8::ScriptCompiler::Source second_source(v8_str(source));
+  second_source.SetCompileHints(reversed_hints);
+  v8::Local<v8::UnboundScript> second =
+      v8::ScriptCompiler::CompileUnboundScript(isolate, &second_source)
+          .ToLocalChecked();
+  CHECK_EQ(2, CountCompiledInnerFunctions(second));
+  // Eagerly compiled functions are only reported once they have run.
+  CHECK(v8::ScriptCompiler::GetCompileHints(second).empty());
+  second->BindToCurrentContext()->Run(env.local()).ToLocalChecked();
+  CHECK(hints == v8::ScriptCompiler::GetCompileHints(second));
+
+  // Streaming compiles consume the same hints.
+  const char* chunks[] = {source, nullptr};
+  v8::ScriptCompiler::StreamedSource streamed_source(
+      std::make_unique<TestSourceStream>(chunks),
+      v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+  streamed_source.SetCompileHints(hints);
+  v8::ScriptCompiler::ScriptStreamingTask* task =
+      v8::ScriptCompiler::StartStreaming(isolate, &streamed_source);
+  task->Run();
+  delete task;
+  v8::ScriptOrigin origin(isolate, v8_str("http://foo.com"));
+  v8::Local<Script> streamed =
+      v8::ScriptCompiler::Compile(env.local(), &streamed_source, v8_str(source),
+                                  origin)
+          .ToLocalChecked();
+  CHECK_EQ(2, CountCompiledInnerFunctions(streamed->GetUnboundScript()));
+  streamed->Run(env.local()).ToLocalChecked();
+  CHECK(hints ==
+        v8::ScriptCompiler::GetCompileHints(streamed->GetUnboundScript()));
+}
+
+TEST(StreamingParallelCompileHoistedCallees) {
+  FlagScope<bool> parallel_flag(&i::FLAG_parallel_streaming_compile, true);
+  FlagScope<bool> finalize_flag(&i::FLAG_finalize_streaming_on_background,
+                                false);
+  // Top-level code that calls functions declared further down, including an
+  // asm.js module, has those compiled while streaming.
+  const char* chunks[] = {
+      "var m = AsmModule();\n"
+      "var result = main() + m.f();\n",
+      "function main() { return 3; }\n"
+      "function unused() { return 0; }\n",
+      "function AsmModule() {\n"
+      "  'use asm';\n"
+      "  function f() { return 4; }\n"
+      "  return {f: f};\n"
+      "}\n",
+      "result;", nullptr};
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  v8::HandleScope scope(isolate);
+
+  v8::ScriptCompiler::StreamedSource source(
+      std::make_unique<TestSourceStream>(chunks),
+      v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+  v8::ScriptCompiler::ScriptStreamingTask* task =
+      v8::ScriptCompiler::StartStreaming(isolate, &source);
+  task->Run();
+  delete task;
+
+  v8::ScriptOrigin origin(isolate, v8_str("http://foo.com"));
+  char* full_source = TestSourceStream::FullSourceString(chunks);
+  v8::Local<Script> script =
+      v8::ScriptCompiler::Compile(env.local(), &source, v8_str(full_source),
+                                  origin)
+          .ToLocalChecked();
+  delete[] full_source;
+
+  i::Handle<i::JSFunction> toplevel = v8::Utils::OpenHandle(*script);
+  i::SharedFunctionInfo::ScriptIterator iterator(
+      i_isolate, i::Script::cast(toplevel->shared().script()));
+  for (i::SharedFunctionInfo info = iterator.Next(); !info.is_null();
+       info = iterator.Next()) {
+    std::unique_ptr<char[]> name = info.DebugNameCStr();
+    if (strcmp(name.get(), "main") == 0 ||
+        strcmp(name.get(), "AsmModule") == 0) {
+      CHECK(info.is_compiled());
+    } else if (strcmp(name.get(), "unused") == 0) {
+      CHECK(!info.is_compiled());
+    }
+  }
+
+  v8::Local<Value> result = script->Run(env.local()).ToLocalChecked();
+  CHECK_EQ(7, result->Int32Value(env.local()).FromJust());
+}
+
 TEST(StreamingScriptWithParseError) {
   // Test that parse errors from streamed scripts are propagated correctly.
   {
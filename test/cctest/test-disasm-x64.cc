@@ -876,6 +876,25 @@ TEST(DisasmX64) {
     }
   }
 
+  // 256-bit AVX2 instructions.
+  {
+    if (CpuFeatures::IsSupported(AVX2)) {
+      CpuFeatureScope avx_scope(&assm, AVX);
+      CpuFeatureScope avx2_scope(&assm, AVX2);
+      YMMRegister ymm1 = YMMRegister::from_xmm(xmm1);
+      YMMRegister ymm2 = YMMRegister::from_xmm(xmm2);
+      YMMRegister ymm9 = YMMRegister::from_xmm(xmm9);
+      __ vmovdqu(ymm9, Operand(rbx, rcx, times_4, 10000));
+      __ vmovdqu(Operand(rbx, rcx, times_4, 10000), ymm1);
+      __ vinstr(0xFE, ymm1, ymm2, ymm9, Assembler::k66, Assembler::k0F,
+                Assembler::kW0);
+      __ vinstr(0x58, ymm9, ymm1, Operand(rbx, rcx, times_4, 10000),
+                Assembler::kNone, Assembler::k0F, Assembler::kW0);
+      __ vinserti128(ymm1, ymm2, xmm9, 1);
+      __ vzeroupper();
+    }
+  }
+
   // FMA3 instruction
   {
     if (CpuFeatures::IsSupported(FMA3)) {
@@ -36,6 +36,7 @@
 #include "src/common/assert-scope.h"
 #include "src/debug/debug.h"
 #include "src/heap/heap-inl.h"
+#include "src/heap/parked-scope.h"
 #include "src/heap/read-only-heap.h"
 #include "src/heap/safepoint.h"
 #include "src/heap/spaces.h"
@@ -394,11 +395,19 @@ UNINITIALIZED_TEST(SnapshotCompression) {
   Vector<const byte> context_blob;
   SerializeContext(&startup_blob, &read_only_blob, &context_blob);
   SnapshotData original_snapshot_data(context_blob);
-  SnapshotData compressed =
-      i::SnapshotCompression::Compress(&original_snapshot_data);
-  SnapshotData decompressed =
-      i::SnapshotCompression::Decompress(compressed.RawData());
-  CHECK_EQ(context_blob, decompressed.RawData());
+  for (bool lz : {false, true}) {
+    // A single chunk, and chunks small enough to be decompressed in parallel.
+    for (unsigned chunk_size : {0u, 1u, 16u}) {
+      FlagScope<bool> codec_scope(&FLAG_snapshot_compression_lz, lz);
+      FlagScope<unsigned> chunk_scope(&FLAG_snapshot_compression_chunk_size,
+                                      chunk_size);
+      SnapshotData compressed =
+          i::SnapshotCompression::Compress(&original_snapshot_data);
+      SnapshotData decompressed =
+          i::SnapshotCompression::Decompress(compressed.RawData());
+      CHECK_EQ(context_blob, decompressed.RawData());
+    }
+  }
 
   startup_blob.Dispose();
   read_only_blob.Dispose();
@@ -1467,6 +1476,44 @@ UNINITIALIZED_TEST(CustomSnapshotDataBlobWithWarmup) {
   FreeCurrentEmbeddedBlob();
 }
 
+UNINITIALIZED_TEST(CustomSnapshotDataBlobClearColdCode) {
+  DisableAlwaysOpt();
+  // Allocate feedback vectors on the first call, so that every function that
+  // ran counts as warm.
+  i::FLAG_lazy_feedback_allocation = false;
+  const char* source =
+      "function warm() { return 1; }\n"
+      "var cold = (function() { return 2; });\n"
+      "warm();";
+
+  DisableEmbeddedBlobRefcounting();
+  v8::StartupData data = CreateSnapshotDataBlobInternal(
+      v8::SnapshotCreator::FunctionCodeHandling::kClearCold, source);
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &data;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  // Test-appropriate equivalent of v8::Isolate::New.
+  v8::Isolate* isolate = TestSerializer::NewIsolate(params);
+  {
+    v8::Isolate::Scope i_scope(isolate);
+    v8::HandleScope h_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope c_scope(context);
+    // The eagerly compiled but never called function has no bytecode in the
+    // snapshot. It is recompiled from source on its first call.
+    CHECK(IsCompiled("warm"));
+    CHECK(!IsCompiled("cold"));
+    CHECK_EQ(2, CompileRun("cold()")->Int32Value(context).FromJust());
+    CHECK(IsCompiled("cold"));
+    CHECK_EQ(1, CompileRun("warm()")->Int32Value(context).FromJust());
+  }
+  isolate->Dispose();
+  delete[] data.data;
+  FreeCurrentEmbeddedBlob();
+}
+
 namespace {
 v8::StartupData CreateCustomSnapshotWithKeep() {
   v8::SnapshotCreator creator;
@@ -2389,6 +2436,235 @@ TEST(CodeSerializerIsolates) {
   isolate2->Dispose();
 }
 
+namespace {
+
+class ConsumeCodeCacheThread final : public v8::base::Thread {
+ public:
+  explicit ConsumeCodeCacheThread(
+      v8::ScriptCompiler::ConsumeCodeCacheTask* task)
+      : Thread(base::Thread::Options("ConsumeCodeCacheThread")), task_(task) {}
+
+  void Run() override { task_->Run(); }
+
+ private:
+  v8::ScriptCompiler::ConsumeCodeCacheTask* task_;
+};
+
+// Deserializes |cache| on a background thread and returns the finished task.
+v8::ScriptCompiler::ConsumeCodeCacheTask* ConsumeCodeCacheOffThread(
+    v8::Isolate* isolate, v8::ScriptCompiler::CachedData* cache) {
+  v8::ScriptCompiler::ConsumeCodeCacheTask* task =
+      v8::ScriptCompiler::StartConsumingCodeCache(
+          isolate, std::make_unique<v8::ScriptCompiler::CachedData>(
+                       cache->data, cache->length));
+  CHECK_NOT_NULL(task);
+  {
+    ConsumeCodeCacheThread thread(task);
+    CHECK(thread.Start());
+    ParkedScope parked(
+        reinterpret_cast<Isolate*>(isolate)->main_thread_local_isolate());
+    thread.Join();
+  }
+  return task;
+}
+
+}  // namespace
+
+TEST(CodeSerializerOffThreadDeserialize) {
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache = CompileRunAndProduceCache(source);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptCompiler::ConsumeCodeCacheTask* task =
+        ConsumeCodeCacheOffThread(isolate2, cache);
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(isolate2, v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache, task);
+    v8::Local<v8::UnboundScript> script;
+    {
+      DisallowCompilation no_compile(reinterpret_cast<Isolate*>(isolate2));
+      script = v8::ScriptCompiler::CompileUnboundScript(
+                   isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+                   .ToLocalChecked();
+    }
+    CHECK(!cache->rejected);
+
+    // The script got its source and is registered with the isolate like any
+    // other script.
+    Handle<Script> i_script(
+        Script::cast(v8::Utils::OpenHandle(*script)->script()),
+        reinterpret_cast<Isolate*>(isolate2));
+    CHECK(i_script->source() == *v8::Utils::OpenHandle(*source_str));
+    Script::Iterator iterator(reinterpret_cast<Isolate*>(isolate2));
+    bool found = false;
+    for (Script s = iterator.Next(); !s.is_null(); s = iterator.Next()) {
+      if (s == *i_script) found = true;
+    }
+    CHECK(found);
+
+    v8::Local<v8::Value> result = script->BindToCurrentContext()
+                                      ->Run(isolate2->GetCurrentContext())
+                                      .ToLocalChecked();
+    CHECK(result->ToString(isolate2->GetCurrentContext())
+              .ToLocalChecked()
+              ->Equals(isolate2->GetCurrentContext(), v8_str("abcdef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+}
+
+TEST(CodeSerializerOffThreadDeserializeSourceMismatch) {
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  const char* other_source = "function f() { return 'abcd'; }; f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache = CompileRunAndProduceCache(source);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    // The cache passes all checks off-thread, so it is only rejected by the
+    // source check on the main thread.
+    v8::ScriptCompiler::ConsumeCodeCacheTask* task =
+        ConsumeCodeCacheOffThread(isolate2, cache);
+    v8::ScriptOrigin origin(isolate2, v8_str("test"));
+    v8::ScriptCompiler::Source source(v8_str(other_source), origin, cache,
+                                      task);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(cache->rejected);
+
+    v8::Local<v8::Value> result = script->BindToCurrentContext()
+                                      ->Run(isolate2->GetCurrentContext())
+                                      .ToLocalChecked();
+    CHECK(result->ToString(isolate2->GetCurrentContext())
+              .ToLocalChecked()
+              ->Equals(isolate2->GetCurrentContext(), v8_str("abcddef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+}
+
+namespace {
+
+v8::Local<v8::String> BundleName(v8::Isolate* isolate,
+                                 const std::string& name) {
+  return v8::String::NewFromUtf8(isolate, name.data(),
+                                 v8::NewStringType::kNormal,
+                                 static_cast<int>(name.size()))
+      .ToLocalChecked();
+}
+
+}  // namespace
+
+TEST(CodeSerializerBundle) {
+  const char* sources[] = {"function f() { return 'abc'; }; f() + 'def'",
+                           "function g() { return 'ghi'; }; g() + 'jkl'",
+                           "'mno' + 'pqr'", "'stu' + 'vwx'"};
+  // Names are compared with their full length, including NUL characters.
+  const std::string names[] = {"b.js", "a.js", "c.js",
+                               std::string("c\0.js", 5)};
+  const char* results[] = {"abcdef", "ghijkl", "mnopqr", "stuvwx"};
+  const int kNumScripts = arraysize(sources);
+
+  v8::ScriptCompiler::CachedData* bundle;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    std::vector<v8::Local<v8::UnboundScript>> scripts;
+    for (int i = 0; i < kNumScripts; i++) {
+      v8::ScriptOrigin origin(isolate1, BundleName(isolate1, names[i]));
+      v8::ScriptCompiler::Source source(v8_str(sources[i]), origin);
+      v8::Local<v8::UnboundScript> script =
+          v8::ScriptCompiler::CompileUnboundScript(isolate1, &source)
+              .ToLocalChecked();
+      script->BindToCurrentContext()->Run(context).ToLocalChecked();
+      scripts.push_back(script);
+    }
+    // A script whose name occurred before is left out.
+    scripts.push_back(scripts[0]);
+    bundle = v8::ScriptCompiler::CreateCodeCacheBundle(isolate1, scripts);
+    CHECK_NOT_NULL(bundle);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    CHECK_NULL(
+        v8::ScriptCompiler::GetCodeCacheFromBundle(bundle, v8_str("d.js")));
+    CHECK_NULL(
+        v8::ScriptCompiler::GetCodeCacheFromBundle(bundle, v8_str("a.j")));
+    CHECK_NULL(
+        v8::ScriptCompiler::GetCodeCacheFromBundle(bundle, v8_str("c .js")));
+
+    for (int i = 0; i < kNumScripts; i++) {
+      v8::Local<v8::String> name = BundleName(isolate2, names[i]);
+      v8::ScriptCompiler::CachedData* cache =
+          v8::ScriptCompiler::GetCodeCacheFromBundle(bundle, name);
+      CHECK_NOT_NULL(cache);
+      // The cache is used in place.
+      CHECK_GE(cache->data, bundle->data);
+      CHECK_LE(cache->data + cache->length, bundle->data + bundle->length);
+
+      v8::ScriptOrigin origin(isolate2, name);
+      v8::ScriptCompiler::Source source(v8_str(sources[i]), origin, cache);
+      v8::Local<v8::UnboundScript> script;
+      {
+        DisallowCompilation no_compile(reinterpret_cast<Isolate*>(isolate2));
+        script = v8::ScriptCompiler::CompileUnboundScript(
+                     isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+                     .ToLocalChecked();
+      }
+      CHECK(!cache->rejected);
+      v8::Local<v8::Value> result =
+          script->BindToCurrentContext()->Run(context).ToLocalChecked();
+      CHECK(result->ToString(context)
+                .ToLocalChecked()
+                ->Equals(context, v8_str(results[i]))
+                .FromJust());
+    }
+  }
+  isolate2->Dispose();
+
+  // A flag change rejects the whole bundle.
+  FLAG_allow_natives_syntax = true;
+  FlagList::EnforceFlagImplications();
+  v8::Isolate* isolate3 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate3);
+    v8::HandleScope scope(isolate3);
+    CHECK_NULL(
+        v8::ScriptCompiler::GetCodeCacheFromBundle(bundle, v8_str("a.js")));
+  }
+  isolate3->Dispose();
+  delete bundle;
+}
+
 TEST(CodeSerializerIsolatesEager) {
   const char* source =
       "function f() {"
@@ -2435,6 +2711,262 @@ TEST(CodeSerializerIsolatesEager) {
   isolate2->Dispose();
 }
 
+namespace {
+
+Handle<SharedFunctionInfo> FindFunctionInScript(Isolate* isolate,
+                                                Handle<Script> script,
+                                                const char* name) {
+  SharedFunctionInfo::ScriptIterator it(isolate, *script);
+  for (SharedFunctionInfo info = it.Next(); !info.is_null();
+       info = it.Next()) {
+    if (info.Name().IsOneByteEqualTo(CStrVector(name))) {
+      return handle(info, isolate);
+    }
+  }
+  return Handle<SharedFunctionInfo>();
+}
+
+}  // namespace
+
+TEST(TieringProfileIsolates) {
+  if (!FLAG_opt || FLAG_always_opt) return;
+  FLAG_allow_natives_syntax = true;
+  FlagScope<bool> record_calls(&FLAG_record_called_functions, true);
+  const char* source =
+      "function outer() {"
+      "  function inner(x) { return x + 1; }"
+      "  return inner;"
+      "}"
+      "function f(x) { return outer()(x) * 2; }"
+      "var g = (function neverCalled() { return 1; });"
+      "%PrepareFunctionForOptimization(f);"
+      "f(1); f(2);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f(3);";
+
+  v8::ScriptCompiler::CachedData* profile;
+  {
+    v8::Isolate* isolate1 = CcTest::isolate();
+    v8::HandleScope scope(isolate1);
+    LocalContext env;
+    v8::ScriptCompiler::Source source1(v8_str(source));
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate1, &source1)
+            .ToLocalChecked();
+    script->BindToCurrentContext()->Run(env.local()).ToLocalChecked();
+    profile = v8::ScriptCompiler::CreateTieringProfile(script);
+
+    // neverCalled is compiled eagerly, but not recorded as having run.
+    Isolate* i_isolate = CcTest::i_isolate();
+    Handle<SharedFunctionInfo> toplevel =
+        Handle<SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*script));
+    Handle<Script> i_script(Script::cast(toplevel->script()), i_isolate);
+    Handle<SharedFunctionInfo> never_called =
+        FindFunctionInScript(i_isolate, i_script, "neverCalled");
+    CHECK(never_called->is_compiled());
+    CHECK(!never_called->has_been_called());
+    CHECK(FindFunctionInScript(i_isolate, i_script, "inner")
+              ->has_been_called());
+  }
+  CHECK_NOT_NULL(profile);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate2);
+
+    // A profile for different source is rejected.
+    v8::ScriptCompiler::Source other_source(v8_str("function f() {}"));
+    v8::Local<v8::UnboundScript> other =
+        v8::ScriptCompiler::CompileUnboundScript(isolate2, &other_source)
+            .ToLocalChecked();
+    CHECK(!v8::ScriptCompiler::ApplyTieringProfile(other, profile));
+
+    v8::ScriptCompiler::Source source2(v8_str(source));
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate2, &source2)
+            .ToLocalChecked();
+    CHECK(v8::ScriptCompiler::ApplyTieringProfile(script, profile));
+
+    Handle<SharedFunctionInfo> toplevel =
+        Handle<SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*script));
+    Handle<Script> i_script(Script::cast(toplevel->script()), i_isolate);
+    Handle<SharedFunctionInfo> f =
+        FindFunctionInScript(i_isolate, i_script, "f");
+    Handle<SharedFunctionInfo> outer =
+        FindFunctionInScript(i_isolate, i_script, "outer");
+    Handle<SharedFunctionInfo> inner =
+        FindFunctionInScript(i_isolate, i_script, "inner");
+    // Functions that ran are compiled eagerly, including nested ones.
+    CHECK(!f.is_null() && f->is_compiled());
+    CHECK(!outer.is_null() && outer->is_compiled());
+    CHECK(!inner.is_null() && inner->is_compiled());
+    // Eager compilation is not recorded as a call.
+    CHECK(!f->has_been_called());
+    // Only the optimized function carries the tiering hint.
+    CHECK(f->hot_in_tiering_profile());
+    CHECK(!outer->hot_in_tiering_profile());
+
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK_EQ(8, result->Int32Value(context).FromJust());
+    CHECK_EQ(10, CompileRun("f(4)")->Int32Value(context).FromJust());
+  }
+  isolate2->Dispose();
+  delete profile;
+}
+
+TEST(CodeSerializerNCICode) {
+  if (!FLAG_opt || FLAG_always_opt) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_turbo_nci = true;
+  FLAG_turbo_nci_code_cache = true;
+  const char* source =
+      "function f(s) { return s + 'def'; }"
+      "%PrepareFunctionForOptimization(f);"
+      "f('x'); f('y');"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f('abc')";
+  v8::ScriptCompiler::CachedData* cache =
+      CompileRunAndProduceCache(source, CodeCacheType::kAfterExecute);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate2);
+
+    v8::ScriptOrigin origin(isolate2, v8_str("test"));
+    v8::ScriptCompiler::Source source2(v8_str(source), origin, cache);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source2, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(!cache->rejected);
+
+    // The optimized code for f was deserialized into the compilation cache.
+    Handle<SharedFunctionInfo> toplevel =
+        Handle<SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*script));
+    Handle<Script> i_script(Script::cast(toplevel->script()), i_isolate);
+    Handle<SharedFunctionInfo> f =
+        FindFunctionInScript(i_isolate, i_script, "f");
+    CHECK(!f.is_null());
+    CHECK(f->may_have_cached_code());
+    Handle<Code> code;
+    CHECK(i_isolate->compilation_cache()->LookupCode(f).ToHandle(&code));
+    CHECK_EQ(CodeKind::NATIVE_CONTEXT_INDEPENDENT, code->kind());
+
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+    CHECK(CompileRun("f('ghi')")
+              ->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("ghidef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+}
+
+TEST(CodeSerializerNCICodeWithForeignInlinee) {
+  if (!FLAG_opt || FLAG_always_opt) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_turbo_nci = true;
+  FLAG_turbo_nci_code_cache = true;
+  // {g} lives in another script; code that inlines it must not be cached,
+  // since that would pull a duplicate of the other script into the cache.
+  const char* helper = "function g(s) { return s + 'def'; }";
+  const char* source =
+      "function f(s) { return g(s); }"
+      "%PrepareFunctionForOptimization(f);"
+      "f('x'); f('y');"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f('abc')";
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::ScriptCompiler::CachedData* cache;
+  bool inlined = false;
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate1);
+
+    CompileRun(helper);
+    v8::ScriptOrigin origin(isolate1, v8_str("test"));
+    v8::ScriptCompiler::Source source1(v8_str(source), origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate1, &source1)
+            .ToLocalChecked();
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+
+    Handle<SharedFunctionInfo> toplevel =
+        Handle<SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*script));
+    Handle<Script> i_script(Script::cast(toplevel->script()), i_isolate);
+    Handle<SharedFunctionInfo> f =
+        FindFunctionInScript(i_isolate, i_script, "f");
+    Handle<Code> code;
+    if (i_isolate->compilation_cache()->LookupCode(f).ToHandle(&code)) {
+      DeoptimizationData data =
+          DeoptimizationData::cast(code->deoptimization_data());
+      inlined = data.length() > 0 && data.InliningPositions().length() > 0;
+    }
+    cache = ScriptCompiler::CreateCodeCache(script);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate2);
+
+    CompileRun(helper);
+    v8::ScriptOrigin origin(isolate2, v8_str("test"));
+    v8::ScriptCompiler::Source source2(v8_str(source), origin, cache);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source2, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(!cache->rejected);
+
+    Handle<SharedFunctionInfo> toplevel =
+        Handle<SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*script));
+    Handle<Script> i_script(Script::cast(toplevel->script()), i_isolate);
+    Handle<SharedFunctionInfo> f =
+        FindFunctionInScript(i_isolate, i_script, "f");
+    CHECK(!f.is_null());
+    if (inlined) {
+      CHECK(i_isolate->compilation_cache()->LookupCode(f).is_null());
+    }
+
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+}
+
 TEST(CodeSerializerAfterExecute) {
   // We test that no compilations happen when running this code. Forcing
   // to always optimize breaks this test.
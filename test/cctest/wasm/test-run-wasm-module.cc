@@ -320,6 +320,92 @@ TEST(Run_WasmModule_CompilationHintsLazyBaselineEagerTopTier) {
   Cleanup();
 }
 
+TEST(Run_WasmModule_CodeGCReusesCodeSpace) {
+  if (!FLAG_liftoff || !FLAG_wasm_code_gc) return;
+  if (!WasmCodeAllocator::ReusesFreedCodeSpace()) return;
+  {
+    // Only compile Liftoff code initially, and trigger a code GC as soon as
+    // code becomes potentially dead.
+    FlagScope<bool> no_tier_up(&FLAG_wasm_tier_up, false);
+    FlagScope<bool> no_lazy(&FLAG_wasm_lazy_compilation, false);
+    FLAG_SCOPE(stress_wasm_code_gc);
+
+    TestSignatures sigs;
+    v8::internal::AccountingAllocator allocator;
+    Zone zone(&allocator, ZONE_NAME);
+    WasmModuleBuilder* builder = zone.New<WasmModuleBuilder>(&zone);
+    WasmFunctionBuilder* f = builder->AddFunction(sigs.i_ii());
+    ExportAsMain(f);
+    byte code[] = {WASM_I32_MUL(WASM_I32_ADD(WASM_LOCAL_GET(0), WASM_I32V_1(7)),
+                                WASM_LOCAL_GET(1))};
+    EMIT_CODE_WITH_END(f, code);
+
+    ZoneBuffer buffer(&zone);
+    builder->WriteTo(&buffer);
+    Isolate* isolate = CcTest::InitIsolateOnce();
+    HandleScope scope(isolate);
+    testing::SetupIsolateForWasmModule(isolate);
+    ErrorThrower thrower(isolate, "CompileAndRunWasmModule");
+    MaybeHandle<WasmModuleObject> module = testing::CompileForTesting(
+        isolate, &thrower, ModuleWireBytes(buffer.begin(), buffer.end()));
+    CHECK(!module.is_null());
+    NativeModule* native_module = module.ToHandleChecked()->native_module();
+    WasmEngine* engine = isolate->wasm_engine();
+
+    static const int kFuncIndex = 0;
+    Address liftoff_start;
+    {
+      WasmCodeRefScope code_ref_scope;
+      WasmCode* liftoff_code = native_module->GetCode(kFuncIndex);
+      CHECK_EQ(ExecutionTier::kLiftoff, liftoff_code->tier());
+      liftoff_start = liftoff_code->instruction_start();
+    }
+
+    v8::HeapCodeStatistics code_statistics;
+    CcTest::isolate()->GetHeapCodeAndMetadataStatistics(&code_statistics);
+    CHECK_LE(native_module->live_code_size(), code_statistics.wasm_code_size());
+    CHECK_LE(code_statistics.wasm_code_size(),
+             code_statistics.wasm_committed_code_size());
+    Handle<JSObject> module_object = module.ToHandleChecked();
+    CompiledWasmModule compiled_module =
+        v8::Local<v8::WasmModuleObject>::Cast(v8::Utils::ToLocal(module_object))
+            ->GetCompiledModule();
+    CHECK_EQ(native_module->live_code_size(), compiled_module.GetCodeSize());
+    CHECK_EQ(native_module->committed_code_space(),
+             compiled_module.GetCommittedCodeSize());
+
+    // Replacing the Liftoff code makes it potentially dead and triggers a code
+    // GC. The Liftoff code is not on the stack, so it is freed when this (only)
+    // isolate reports its live code.
+    engine->CompileFunction(isolate, native_module, kFuncIndex,
+                            ExecutionTier::kTurbofan);
+    size_t live_code_size = native_module->live_code_size();
+    engine->ReportLiveCodeFromStackForGC(isolate);
+    CHECK_LT(0, native_module->freed_code_size());
+    CHECK_GT(live_code_size, native_module->live_code_size());
+    {
+      WasmCodeRefScope code_ref_scope;
+      CHECK_NULL(native_module->Lookup(liftoff_start));
+    }
+
+    // Liftoff code for the same function fits exactly into the freed code
+    // space, so it gets allocated there (it is not published, because TurboFan
+    // code exists already).
+    engine->CompileFunction(isolate, native_module, kFuncIndex,
+                            ExecutionTier::kLiftoff);
+    {
+      WasmCodeRefScope code_ref_scope;
+      WasmCode* new_code = native_module->Lookup(liftoff_start);
+      CHECK_NOT_NULL(new_code);
+      CHECK_EQ(ExecutionTier::kLiftoff, new_code->tier());
+      CHECK_EQ(liftoff_start, new_code->instruction_start());
+      CHECK_EQ(ExecutionTier::kTurbofan,
+               native_module->GetCode(kFuncIndex)->tier());
+    }
+  }
+  Cleanup();
+}
+
 TEST(Run_WasmModule_CallAdd) {
   {
     v8::internal::AccountingAllocator allocator;
@@ -0,0 +1,94 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/codegen/reloc-info.h"
+#include "src/wasm/wasm-code-manager.h"
+#include "test/cctest/cctest.h"
+#include "test/cctest/wasm/wasm-run-utils.h"
+#include "test/common/flag-utils.h"
+#include "test/common/wasm/wasm-macro-gen.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+namespace test_wasm_inlining {
+
+namespace {
+
+// Returns the number of direct calls to other wasm functions in the code of
+// function {index}. Inlined calls leave no such call behind.
+int CountDirectCalls(TestingModuleBuilder* builder, uint32_t index) {
+  WasmCode* code = builder->GetFunctionCode(index);
+  int count = 0;
+  for (RelocIterator it(code->instructions(), code->reloc_info(),
+                        code->constant_pool(),
+                        RelocInfo::ModeMask(RelocInfo::WASM_CALL));
+       !it.done(); it.next()) {
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(InlineSmallCallee) {
+  FLAG_SCOPE(wasm_inlining);
+  WasmRunner<int32_t, int32_t, int32_t> r(TestExecutionTier::kTurbofan);
+  WasmFunctionCompiler& add = r.NewFunction<int32_t, int32_t, int32_t>();
+  BUILD(add, WASM_I32_ADD(WASM_LOCAL_GET(0), WASM_LOCAL_GET(1)));
+  BUILD(r, WASM_I32_MUL(WASM_CALL_FUNCTION(add.function_index(),
+                                           WASM_LOCAL_GET(0),
+                                           WASM_LOCAL_GET(1)),
+                        WASM_I32V_1(2)));
+
+  CHECK_EQ(0, CountDirectCalls(&r.builder(), r.function_index()));
+  CHECK_EQ(14, r.Call(3, 4));
+  CHECK_EQ(-2, r.Call(0x7fffffff, 0));
+}
+
+TEST(InlineCalleeWithTwoReturns) {
+  FLAG_SCOPE(wasm_inlining);
+  WasmRunner<int32_t, int32_t, int32_t> r(TestExecutionTier::kTurbofan);
+  WasmFunctionCompiler& max = r.NewFunction<int32_t, int32_t, int32_t>();
+  BUILD(max,
+        WASM_IF(WASM_I32_GTS(WASM_LOCAL_GET(0), WASM_LOCAL_GET(1)),
+                WASM_RETURN1(WASM_LOCAL_GET(0))),
+        WASM_LOCAL_GET(1));
+  BUILD(r, WASM_CALL_FUNCTION(max.function_index(), WASM_LOCAL_GET(0),
+                              WASM_LOCAL_GET(1)));
+
+  CHECK_EQ(0, CountDirectCalls(&r.builder(), r.function_index()));
+  CHECK_EQ(6, r.Call(5, 6));
+  CHECK_EQ(6, r.Call(6, 5));
+}
+
+TEST(NoInliningAboveMaxSize) {
+  FLAG_SCOPE(wasm_inlining);
+  FlagScope<int> max_size(&FLAG_wasm_inlining_max_size, 1);
+  WasmRunner<int32_t, int32_t, int32_t> r(TestExecutionTier::kTurbofan);
+  WasmFunctionCompiler& add = r.NewFunction<int32_t, int32_t, int32_t>();
+  BUILD(add, WASM_I32_ADD(WASM_LOCAL_GET(0), WASM_LOCAL_GET(1)));
+  BUILD(r, WASM_CALL_FUNCTION(add.function_index(), WASM_LOCAL_GET(0),
+                              WASM_LOCAL_GET(1)));
+
+  CHECK_EQ(1, CountDirectCalls(&r.builder(), r.function_index()));
+  CHECK_EQ(7, r.Call(3, 4));
+}
+
+TEST(NoInliningWithoutFlag) {
+  FlagScope<bool> no_inlining(&FLAG_wasm_inlining, false);
+  WasmRunner<int32_t, int32_t, int32_t> r(TestExecutionTier::kTurbofan);
+  WasmFunctionCompiler& add = r.NewFunction<int32_t, int32_t, int32_t>();
+  BUILD(add, WASM_I32_ADD(WASM_LOCAL_GET(0), WASM_LOCAL_GET(1)));
+  BUILD(r, WASM_CALL_FUNCTION(add.function_index(), WASM_LOCAL_GET(0),
+                              WASM_LOCAL_GET(1)));
+
+  CHECK_EQ(1, CountDirectCalls(&r.builder(), r.function_index()));
+  CHECK_EQ(7, r.Call(3, 4));
+}
+
+}  // namespace test_wasm_inlining
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
@@ -5,11 +5,18 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <map>
+#include <vector>
+
 #include "src/api/api-inl.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
 #include "src/objects/objects-inl.h"
 #include "src/snapshot/code-serializer.h"
 #include "src/utils/version.h"
 #include "src/wasm/module-decoder.h"
+#include "src/wasm/streaming-decoder.h"
+#include "src/wasm/wasm-code-cache.h"
 #include "src/wasm/wasm-engine.h"
 #include "src/wasm/wasm-module-builder.h"
 #include "src/wasm/wasm-module.h"
@@ -332,6 +339,262 @@ TEST(TierDownAfterDeserialization) {
   CHECK_EQ(ExecutionTier::kLiftoff, liftoff_code->tier());
 }
 
+UNINITIALIZED_TEST(TierUpHotFunctionsAfterDeserialization) {
+  // Calls are only counted in Liftoff code.
+  if (!FLAG_liftoff) return;
+  FlagScope<bool> dynamic_tiering(&FLAG_wasm_dynamic_tiering, true);
+  i::wasm::WasmEngine::InitializeOncePerProcess();
+  v8::internal::AccountingAllocator allocator;
+  Zone zone(&allocator, ZONE_NAME);
+  ZoneBuffer buffer(&zone);
+  {
+    WasmModuleBuilder* builder = zone.New<WasmModuleBuilder>(&zone);
+    TestSignatures sigs;
+    for (int i = 0; i < 2; ++i) {
+      WasmFunctionBuilder* f = builder->AddFunction(sigs.i_v());
+      byte code[] = {WASM_I32V_1(i), kExprEnd};
+      f->EmitCode(code, sizeof(code));
+    }
+    builder->WriteTo(&buffer);
+  }
+  constexpr int kHotFunction = 0;
+  constexpr int kColdFunction = 1;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* v8_isolate = v8::Isolate::New(create_params);
+  std::weak_ptr<NativeModule> weak_native_module;
+  std::vector<byte> serialized;
+  {
+    v8::HandleScope scope(v8_isolate);
+    LocalContext env(v8_isolate);
+    Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate);
+    testing::SetupIsolateForWasmModule(isolate);
+    ErrorThrower thrower(isolate, "TierUpHotFunctionsAfterDeserialization");
+    Handle<WasmModuleObject> module_object =
+        isolate->wasm_engine()
+            ->SyncCompile(isolate, WasmFeatures::FromIsolate(isolate),
+                          &thrower,
+                          ModuleWireBytes(buffer.begin(), buffer.end()))
+            .ToHandleChecked();
+    NativeModule* native_module = module_object->native_module();
+    weak_native_module = module_object->shared_native_module();
+    native_module->compilation_state()->WaitForTopTierFinished();
+    {
+      WasmCodeRefScope code_ref_scope;
+      // Dynamic tiering does not tier up eagerly.
+      CHECK_EQ(ExecutionTier::kLiftoff,
+               native_module->GetCode(kHotFunction)->tier());
+      CHECK_EQ(ExecutionTier::kLiftoff,
+               native_module->GetCode(kColdFunction)->tier());
+    }
+    // Pretend that the first function was called often enough to be tiered up,
+    // but was not compiled with TurboFan yet.
+    native_module->num_liftoff_function_calls_array()[kHotFunction] =
+        FLAG_wasm_tiering_budget;
+
+    WasmSerializer serializer(native_module);
+    serialized.resize(serializer.GetSerializedNativeModuleSize());
+    CHECK(serializer.SerializeNativeModule(VectorOf(serialized)));
+  }
+  v8_isolate->Dispose();
+  // Background threads might temporarily keep the native module alive.
+  while (weak_native_module.lock()) {
+  }
+
+  v8_isolate = v8::Isolate::New(create_params);
+  {
+    v8::HandleScope scope(v8_isolate);
+    LocalContext env(v8_isolate);
+    Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate);
+    Handle<WasmModuleObject> module_object =
+        DeserializeNativeModule(isolate, VectorOf(serialized),
+                                VectorOf(buffer.begin(), buffer.size()), {})
+            .ToHandleChecked();
+    NativeModule* native_module = module_object->native_module();
+    // The cold function is compiled lazily again, the hot one is tiered up in
+    // the background.
+    CHECK(!native_module->HasCode(kColdFunction));
+    while (!native_module->HasCodeWithTier(kHotFunction,
+                                           ExecutionTier::kTurbofan)) {
+    }
+  }
+  v8_isolate->Dispose();
+}
+
+namespace {
+
+// Keeps the entries of the persistent code cache in memory.
+class TestCodeCacheStorage final : public WasmCodeCacheStorage {
+ public:
+  OwnedVector<uint8_t> Load(size_t key) override {
+    base::MutexGuard guard(&mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return {};
+    return OwnedVector<uint8_t>::Of(it->second);
+  }
+
+  void Store(size_t key, Vector<const uint8_t> data) override {
+    {
+      base::MutexGuard guard(&mutex_);
+      entries_[key].assign(data.begin(), data.end());
+    }
+    stored_.Signal();
+  }
+
+  void WaitForStore() { stored_.Wait(); }
+
+  // Changes the copy of the wire bytes in every entry, so that no entry
+  // matches the module it was created from.
+  void CorruptWireBytes() {
+    base::MutexGuard guard(&mutex_);
+    constexpr size_t kFirstWireByte = 3 * kUInt32Size;
+    for (auto& entry : entries_) {
+      CHECK_LT(kFirstWireByte, entry.second.size());
+      entry.second[kFirstWireByte] ^= 0xFF;
+    }
+  }
+
+  size_t size() {
+    base::MutexGuard guard(&mutex_);
+    return entries_.size();
+  }
+
+ private:
+  base::Mutex mutex_;
+  std::map<size_t, std::vector<uint8_t>> entries_;
+  base::Semaphore stored_{0};
+};
+
+class TestCompileResolver : public CompilationResultResolver {
+ public:
+  void OnCompilationSucceeded(Handle<WasmModuleObject> module) override {
+    native_module_ = module->shared_native_module();
+  }
+
+  void OnCompilationFailed(Handle<Object> error_reason) override {
+    UNREACHABLE();
+  }
+
+  std::shared_ptr<NativeModule> native_module() const {
+    return native_module_;
+  }
+
+ private:
+  std::shared_ptr<NativeModule> native_module_;
+};
+
+// Compiles the module asynchronously or by streaming it, and runs it in a new
+// isolate. If it was not taken from the code cache, waits until it has been
+// stored. The isolate is disposed, and the native module is dead on return,
+// so that the next compilation cannot find it in the native module cache.
+// Returns whether the module came from the code cache.
+bool CompileAndRunInNewIsolate(ZoneBuffer* buffer,
+                               TestCodeCacheStorage* storage, bool streaming) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* v8_isolate = v8::Isolate::New(create_params);
+  Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate);
+  std::weak_ptr<NativeModule> weak_native_module;
+  bool deserialized;
+  {
+    v8::HandleScope scope(v8_isolate);
+    LocalContext env(v8_isolate);
+    testing::SetupIsolateForWasmModule(isolate);
+    auto resolver = std::make_shared<TestCompileResolver>();
+    WasmFeatures enabled_features = WasmFeatures::FromIsolate(isolate);
+    if (streaming) {
+      std::shared_ptr<StreamingDecoder> stream =
+          isolate->wasm_engine()->StartStreamingCompilation(
+              isolate, enabled_features, isolate->native_context(),
+              "CompileAndRunInNewIsolate", resolver);
+      stream->OnBytesReceived(VectorOf(buffer->begin(), buffer->size()));
+      stream->Finish();
+    } else {
+      isolate->wasm_engine()->AsyncCompile(
+          isolate, enabled_features, resolver,
+          ModuleWireBytes(buffer->begin(), buffer->end()), true,
+          "CompileAndRunInNewIsolate");
+    }
+    while (!resolver->native_module()) {
+      v8::platform::PumpMessageLoop(
+          i::V8::GetCurrentPlatform(), v8_isolate,
+          platform::MessageLoopBehavior::kWaitForWork);
+    }
+    std::shared_ptr<NativeModule> shared_native_module =
+        resolver->native_module();
+    NativeModule* native_module = shared_native_module.get();
+    weak_native_module = shared_native_module;
+    ErrorThrower thrower(isolate, "CompileAndRunInNewIsolate");
+    Handle<WasmModuleObject> module_object =
+        isolate->wasm_engine()->ImportNativeModule(
+            isolate, std::move(shared_native_module), {});
+    // Deserialized modules only contain TurboFan code.
+    deserialized = native_module->liftoff_code_size() == 0;
+
+    Handle<WasmInstanceObject> instance =
+        isolate->wasm_engine()
+            ->SyncInstantiate(isolate, &thrower, module_object,
+                              Handle<JSReceiver>::null(),
+                              MaybeHandle<JSArrayBuffer>())
+            .ToHandleChecked();
+    Handle<Object> params[1] = {Handle<Object>(Smi::FromInt(41), isolate)};
+    CHECK_EQ(42, testing::CallWasmFunctionForTesting(isolate, instance,
+                                                     "increment", 1, params));
+
+    if (!deserialized) {
+      native_module->compilation_state()->WaitForTopTierFinished();
+      storage->WaitForStore();
+    }
+  }
+  v8_isolate->Dispose();
+  // Background threads might temporarily keep the native module alive.
+  while (weak_native_module.lock()) {
+  }
+  return deserialized;
+}
+
+}  // namespace
+
+UNINITIALIZED_TEST(PersistentCodeCache) {
+  // Liftoff code shows that a module was compiled rather than deserialized.
+  if (!FLAG_liftoff) return;
+  i::wasm::WasmEngine::InitializeOncePerProcess();
+  v8::internal::AccountingAllocator allocator;
+  Zone zone(&allocator, ZONE_NAME);
+  ZoneBuffer buffer(&zone);
+  WasmSerializationTest::BuildWireBytes(&zone, &buffer);
+
+  WasmEngine* engine = WasmEngine::GetWasmEngine().get();
+  auto owned_storage = std::make_unique<TestCodeCacheStorage>();
+  TestCodeCacheStorage* storage = owned_storage.get();
+  engine->SetCodeCacheStorage(std::move(owned_storage));
+
+  // The first compilation stores the module.
+  CHECK(!CompileAndRunInNewIsolate(&buffer, storage, false));
+  CHECK_EQ(1, storage->size());
+
+  // An entry for different wire bytes is ignored, and replaced by the module
+  // compiled instead.
+  storage->CorruptWireBytes();
+  CHECK(!CompileAndRunInNewIsolate(&buffer, storage, false));
+  CHECK_EQ(1, storage->size());
+
+  // A matching entry is deserialized.
+  CHECK(CompileAndRunInNewIsolate(&buffer, storage, false));
+
+  // A stale entry with the same prefix does not stop streaming compilation.
+  storage->CorruptWireBytes();
+  CHECK(!CompileAndRunInNewIsolate(&buffer, storage, true));
+  CHECK_EQ(1, storage->size());
+
+  // Streaming compilation only uses a matching entry if it was loaded by the
+  // time the stream finished, so either way the module has to work.
+  CompileAndRunInNewIsolate(&buffer, storage, true);
+
+  engine->SetCodeCacheStorage(nullptr);
+}
+
 }  // namespace test_wasm_serialization
 }  // namespace wasm
 }  // namespace internal
@@ -0,0 +1,122 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Comparisons used as branch conditions, i.e. a Test bytecode directly
+// followed by JumpIfTrue or JumpIfFalse.
+
+function addBenchmark(name, test) {
+  new BenchmarkSuite(name, [1000],
+      [
+        new Benchmark(name, false, false, 0, test)
+      ]);
+}
+
+addBenchmark('Smi-StrictEquals-Branch', SmiStrictEqualsBranch);
+addBenchmark('Smi-LessThan-Branch', SmiLessThanBranch);
+addBenchmark('Object-Null-Branch', ObjectNullBranch);
+addBenchmark('Undefined-Branch', UndefinedBranch);
+addBenchmark('TypeOf-Branch', TypeOfBranch);
+
+var o = {};
+var n = 0;
+
+function strictEqualsBranch(a, b) {
+  for (var i = 0; i < 1000; ++i) {
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+    if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++; if (a === b) n++;
+  }
+}
+
+function lessThanBranch(a, b) {
+  for (var i = 0; i < 1000; ++i) {
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+    if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++; if (a < b) n++;
+  }
+}
+
+function nullBranch(a) {
+  for (var i = 0; i < 1000; ++i) {
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+    if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++; if (a == null) n++;
+  }
+}
+
+function undefinedBranch(a) {
+  for (var i = 0; i < 1000; ++i) {
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+    if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++; if (a === undefined) n++;
+  }
+}
+
+function typeOfBranch(a) {
+  for (var i = 0; i < 1000; ++i) {
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+    if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++; if (typeof a === 'number') n++;
+  }
+}
+
+function SmiStrictEqualsBranch() {
+  strictEqualsBranch(10, 20);
+  strictEqualsBranch(10, 10);
+}
+
+function SmiLessThanBranch() {
+  lessThanBranch(10, 20);
+  lessThanBranch(20, 10);
+}
+
+function ObjectNullBranch() {
+  nullBranch(o);
+  nullBranch(null);
+}
+
+function UndefinedBranch() {
+  undefinedBranch(o);
+  undefinedBranch(undefined);
+}
+
+function TypeOfBranch() {
+  typeOfBranch(o);
+  typeOfBranch(n);
+}
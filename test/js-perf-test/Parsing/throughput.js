@@ -0,0 +1,53 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures scanner throughput in MB/s of source text, for inputs that are
+// dominated by whitespace, comments or identifiers. The sources are compiled
+// with new Function, so that the function body is only pre-parsed.
+
+const kSourceSize = 1024 * 1024;
+const kMinDurationMs = 1000;
+
+function Repeat(chunk) {
+  let code = chunk.repeat(Math.ceil(kSourceSize / chunk.length));
+  %FlattenString(code);
+  return code;
+}
+
+function IndentationSource() {
+  return Repeat("\n" + " ".repeat(24) + "x;\n" + "\t\t\t\t\ty;\n");
+}
+
+function SingleLineCommentsSource() {
+  return Repeat("  // " + "This is a single line comment. ".repeat(3) + "\n");
+}
+
+function MultiLineCommentSource() {
+  return Repeat("/*\n" + (" * " + "This is a multi line comment. ".repeat(3) +
+                          "\n").repeat(20) + " */\n");
+}
+
+function IdentifiersSource() {
+  return Repeat("someRatherLongIdentifier = anotherIdentifierName + " +
+                "$yetAnother_identifier123;\n");
+}
+
+function Measure(name, source) {
+  const megabytes = source.length / (1024 * 1024);
+  let iterations = 0;
+  const start = performance.now();
+  let elapsed = 0;
+  do {
+    new Function(source);
+    iterations++;
+    elapsed = performance.now() - start;
+  } while (elapsed < kMinDurationMs);
+  print(name + "-Parsing(MB/s): " +
+        (megabytes * iterations / (elapsed / 1000)).toFixed(2));
+}
+
+Measure("Indentation", IndentationSource());
+Measure("SingleLineComments", SingleLineCommentsSource());
+Measure("MultiLineComment", MultiLineCommentSource());
+Measure("Identifiers", IdentifiersSource());
@@ -0,0 +1,44 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+const pieces = [
+  'abcde', '123456', 'aqwsde', 'nbvveqxu', 'f03ks-120-3;jfkm;ajp3f',
+  'sd-93u498thikefnow8y3-0rh1nalksfnwo8y3t19-3r8hoiefnw'
+];
+
+// Accumulate short pieces into one string.
+
+function StringConcatLoop() {
+  let s = '';
+  for (let i = 0; i < 100; ++i) {
+    s += pieces[i % pieces.length];
+  }
+  return s;
+}
+createSuiteWithWarmup('StringConcatLoop', 5, StringConcatLoop);
+
+// Accumulate and then consume the result, which flattens it.
+
+function StringConcatLoopFlatten() {
+  let s = '';
+  for (let i = 0; i < 100; ++i) {
+    s += pieces[i % pieces.length];
+  }
+  return s.charCodeAt(s.length >> 1);
+}
+createSuiteWithWarmup('StringConcatLoopFlatten', 5, StringConcatLoopFlatten);
+
+// Template literal chains.
+
+function StringConcatTemplateLiteral() {
+  let result;
+  for (let i = 0; i < pieces.length; ++i) {
+    const a = pieces[i];
+    const b = pieces[(i + 1) % pieces.length];
+    result = `<${a} class="${b}">${a}${b}</${a}>`;
+  }
+  return result;
+}
+createSuiteWithWarmup(
+    'StringConcatTemplateLiteral', 5, StringConcatTemplateLiteral);
@@ -0,0 +1,115 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures memory.copy and memory.fill with constant sizes from 1 byte to
+// 1 MiB. Small sizes are emitted inline by the wasm compilers, larger ones
+// call into C. Every benchmark moves about the same number of bytes.
+
+const kSizes = [1, 4, 16, 64, 256, 4096, 65536, 1048576];
+const kBytesPerRun = 1 << 20;
+const kMaxIterations = 10000;
+const kDestination = 1 << 20;
+
+function unsignedLeb(value) {
+  const bytes = [];
+  do {
+    let byte = value & 0x7f;
+    value >>>= 7;
+    if (value != 0) byte |= 0x80;
+    bytes.push(byte);
+  } while (value != 0);
+  return bytes;
+}
+
+function signedLeb(value) {
+  const bytes = [];
+  while (true) {
+    const byte = value & 0x7f;
+    value >>= 7;
+    if ((value == 0 && (byte & 0x40) == 0) ||
+        (value == -1 && (byte & 0x40) != 0)) {
+      bytes.push(byte);
+      return bytes;
+    }
+    bytes.push(byte | 0x80);
+  }
+}
+
+function section(id, entries) {
+  const content = [...unsignedLeb(entries.length), ...entries.flat()];
+  return [id, ...unsignedLeb(content.length), ...content];
+}
+
+function i32Const(value) {
+  return [0x41, ...signedLeb(value)];
+}
+
+// (func (param $n i32)
+//   (block (loop
+//     (br_if 1 (i32.eqz (local.get $n)))
+//     <operation>
+//     (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+//     (br 0))))
+function loopBody(operation) {
+  const code = [
+    0x00,                                // no locals
+    0x02, 0x40, 0x03, 0x40,              // block, loop
+    0x20, 0x00, 0x45, 0x0d, 0x01,        // br_if 1 (i32.eqz $n)
+    ...operation,
+    0x20, 0x00, 0x41, 0x01, 0x6b,        // $n - 1
+    0x21, 0x00, 0x0c, 0x00,              // local.set $n, br 0
+    0x0b, 0x0b, 0x0b,                    // end loop, block, function
+  ];
+  return [...unsignedLeb(code.length), ...code];
+}
+
+function name(string) {
+  return [string.length, ...Array.from(string, c => c.charCodeAt(0))];
+}
+
+function buildModule() {
+  const functions = [];
+  const exports = [];
+  const bodies = [];
+  for (const size of kSizes) {
+    // memory.copy $dst $src $size
+    bodies.push(loopBody([...i32Const(kDestination), ...i32Const(0),
+                          ...i32Const(size), 0xfc, 0x0a, 0x00, 0x00]));
+    // memory.fill $dst $value $size
+    bodies.push(loopBody([...i32Const(kDestination), ...i32Const(0x5a),
+                          ...i32Const(size), 0xfc, 0x0b, 0x00]));
+    for (const op of ['copy', 'fill']) {
+      exports.push([...name(op + size), 0x00,
+                    ...unsignedLeb(functions.length)]);
+      functions.push([0x00]);
+    }
+  }
+  const bytes = [
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    ...section(1, [[0x60, 0x01, 0x7f, 0x00]]),  // (i32) -> ()
+    ...section(3, functions),
+    ...section(5, [[0x00, 0x21]]),  // 33 pages
+    ...section(7, exports),
+    ...section(10, bodies),
+  ];
+  return new WebAssembly.Instance(
+      new WebAssembly.Module(new Uint8Array(bytes))).exports;
+}
+
+const instance = buildModule();
+
+for (const size of kSizes) {
+  const iterations =
+      Math.max(1, Math.min(kMaxIterations, kBytesPerRun / size));
+  const label = size >= 1 << 20 ? `${size >> 20}MB`
+              : size >= 1 << 10 ? `${size >> 10}KB`
+                                : `${size}B`;
+  for (const op of ['copy', 'fill']) {
+    const fn = instance[op + size];
+    const suiteName = `Memory${op == 'copy' ? 'Copy' : 'Fill'}-${label}`;
+    new BenchmarkSuite(suiteName, [1000], [
+      new Benchmark(suiteName, false, false, 0, () => fn(iterations)),
+    ]);
+  }
+}
@@ -0,0 +1,91 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the overhead of calling small exported wasm functions from a hot
+// JavaScript loop. With --turbo-inline-js-wasm-calls optimized JavaScript code
+// calls the wasm code directly, without going through the JS-to-wasm wrapper.
+
+const kCalls = 10000;
+
+function name(string) {
+  return [string.length, ...Array.from(string, c => c.charCodeAt(0))];
+}
+
+function section(id, entries) {
+  const content = [entries.length, ...entries.flat()];
+  return [id, content.length, ...content];
+}
+
+function body(code) {
+  return [code.length + 2, 0x00, ...code, 0x0b];  // No locals, end.
+}
+
+function buildModule() {
+  const kI32 = 0x7f;
+  const kF64 = 0x7c;
+  const types = [
+    [0x60, 0x00, 0x00],                    // () -> ()
+    [0x60, 0x02, kI32, kI32, 0x01, kI32],  // (i32, i32) -> i32
+    [0x60, 0x02, kF64, kF64, 0x01, kF64],  // (f64, f64) -> f64
+    [0x60, 0x01, kI32, 0x01, kI32],        // (i32) -> i32
+  ];
+  const functions = [
+    // nop
+    [0x00, body([])],
+    // add: local.get 0, local.get 1, i32.add
+    [0x01, body([0x20, 0x00, 0x20, 0x01, 0x6a])],
+    // mul: local.get 0, local.get 1, f64.mul
+    [0x02, body([0x20, 0x00, 0x20, 0x01, 0xa2])],
+    // hash: (x ^ (x >>> 16)) * 0x45d9f3b
+    [0x03, body([
+      0x20, 0x00, 0x20, 0x00, 0x41, 0x10, 0x76, 0x73,
+      0x41, 0xbb, 0xbe, 0xf6, 0x22, 0x6c,
+    ])],
+  ];
+  const exports = ['nop', 'add', 'mul', 'hash'].map(
+      (string, index) => [...name(string), 0x00, index]);
+  const bytes = [
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    ...section(1, types),
+    ...section(3, functions.map(([type]) => [type])),
+    ...section(7, exports),
+    ...section(10, functions.map(([, code]) => code)),
+  ];
+  return new WebAssembly.Instance(
+      new WebAssembly.Module(new Uint8Array(bytes))).exports;
+}
+
+const {nop, add, mul, hash} = buildModule();
+
+function callNop() {
+  for (let i = 0; i < kCalls; ++i) nop();
+}
+
+function callAdd() {
+  let sum = 0;
+  for (let i = 0; i < kCalls; ++i) sum = add(sum, i);
+  return sum;
+}
+
+function callMul() {
+  let product = 1;
+  for (let i = 0; i < kCalls; ++i) product = mul(product, 1.0001);
+  return product;
+}
+
+// A hash function called once per item.
+const items = new Int32Array(kCalls).map((_, i) => i * 7919);
+function callHash() {
+  let result = 0;
+  for (let i = 0; i < items.length; ++i) result ^= hash(items[i]);
+  return result;
+}
+
+for (const [suite, fn] of [
+         ['CallNop', callNop], ['CallI32Add', callAdd],
+         ['CallF64Mul', callMul], ['CallI32Hash', callHash]]) {
+  new BenchmarkSuite(suite, [1000], [
+    new Benchmark(suite, false, false, 0, fn),
+  ]);
+}
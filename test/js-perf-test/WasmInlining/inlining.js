@@ -0,0 +1,86 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures wasm loops that call small functions of the same module. With
+// --wasm-inlining TurboFan inlines the callees into the loops.
+
+const kIterations = 10000;
+
+function name(string) {
+  return [string.length, ...Array.from(string, c => c.charCodeAt(0))];
+}
+
+function section(id, entries) {
+  const content = [entries.length, ...entries.flat()];
+  return [id, content.length, ...content];
+}
+
+function body(locals, code) {
+  const content = [...locals, ...code, 0x0b];  // end
+  return [content.length, ...content];
+}
+
+// Builds a loop that counts local 0 down to zero and applies {step} to the
+// accumulator in local 1 on every iteration, then returns the accumulator.
+function countDownLoop(step) {
+  return [
+    0x02, 0x40,                    // block
+    0x03, 0x40,                    // loop
+    0x20, 0x00, 0x45, 0x0d, 0x01,  // br_if 1 (i32.eqz (local.get 0))
+    ...step,
+    0x20, 0x00, 0x41, 0x01, 0x6b,  // i32.sub (local.get 0) (i32.const 1)
+    0x21, 0x00,                    // local.set 0
+    0x0c, 0x00,                    // br 0
+    0x0b, 0x0b,                    // end, end
+    0x20, 0x01,                    // local.get 1
+  ];
+}
+
+function buildModule() {
+  const kI32 = 0x7f;
+  const kNoLocals = [0x00];
+  const kOneI32Local = [0x01, 0x01, kI32];
+  const types = [
+    [0x60, 0x02, kI32, kI32, 0x01, kI32],  // (i32, i32) -> i32
+    [0x60, 0x01, kI32, 0x01, kI32],        // (i32) -> i32
+  ];
+  const functions = [
+    // 0 add: local.get 0, local.get 1, i32.add
+    [0x00, body(kNoLocals, [0x20, 0x00, 0x20, 0x01, 0x6a])],
+    // 1 hash: (x ^ (x >>> 16)) * 0x45d9f3b
+    [0x01, body(kNoLocals, [
+      0x20, 0x00, 0x20, 0x00, 0x41, 0x10, 0x76, 0x73,
+      0x41, 0xbb, 0xbe, 0xf6, 0x22, 0x6c,
+    ])],
+    // 2 sum: acc = add(acc, i)
+    [0x01, body(kOneI32Local, countDownLoop([
+      0x20, 0x01, 0x20, 0x00, 0x10, 0x00, 0x21, 0x01,
+    ]))],
+    // 3 hashes: acc ^= hash(i)
+    [0x01, body(kOneI32Local, countDownLoop([
+      0x20, 0x01, 0x20, 0x00, 0x10, 0x01, 0x73, 0x21, 0x01,
+    ]))],
+  ];
+  const exports = [['sum', 2], ['hashes', 3]].map(
+      ([string, index]) => [...name(string), 0x00, index]);
+  const bytes = [
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    ...section(1, types),
+    ...section(3, functions.map(([type]) => [type])),
+    ...section(7, exports),
+    ...section(10, functions.map(([, code]) => code)),
+  ];
+  return new WebAssembly.Instance(
+      new WebAssembly.Module(new Uint8Array(bytes))).exports;
+}
+
+const {sum, hashes} = buildModule();
+
+for (const [suite, fn] of [
+         ['CallI32Add', () => sum(kIterations)],
+         ['CallI32Hash', () => hashes(kIterations)]]) {
+  new BenchmarkSuite(suite, [1000], [
+    new Benchmark(suite, false, false, 0, fn),
+  ]);
+}
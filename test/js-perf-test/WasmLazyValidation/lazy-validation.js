@@ -0,0 +1,64 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the time from the wire bytes of a large module to the result of
+// its first call. Run with --wasm-lazy-compilation, so that the time is spent
+// decoding and validating the function bodies, not compiling them.
+
+const kNumFunctions = 20000;
+const kAddsPerFunction = 50;
+
+function unsignedLeb(value) {
+  const bytes = [];
+  do {
+    let byte = value & 0x7f;
+    value >>>= 7;
+    if (value != 0) byte |= 0x80;
+    bytes.push(byte);
+  } while (value != 0);
+  return bytes;
+}
+
+function section(id, content) {
+  return [id, ...unsignedLeb(content.length), ...content];
+}
+
+// (func (param i32) (result i32)
+//   (i32.add (i32.add (local.get 0) (i32.const 1)) (i32.const 2)) ...)
+function functionBody(index) {
+  const code = [0x00, 0x20, 0x00];  // no locals, local.get 0
+  for (let i = 0; i < kAddsPerFunction; ++i) {
+    code.push(0x41, (index + i) & 0x3f, 0x6a);  // i32.const, i32.add
+  }
+  code.push(0x0b);  // end
+  return [...unsignedLeb(code.length), ...code];
+}
+
+function buildModuleBytes() {
+  const functions = [...unsignedLeb(kNumFunctions)];
+  const bodies = [...unsignedLeb(kNumFunctions)];
+  for (let i = 0; i < kNumFunctions; ++i) {
+    functions.push(0x00);
+    bodies.push(...functionBody(i));
+  }
+  return new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    ...section(1, [0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f]),  // (i32) -> i32
+    ...section(3, functions),
+    // (export "main" (func 0))
+    ...section(7, [0x01, 0x04, 0x6d, 0x61, 0x69, 0x6e, 0x00, 0x00]),
+    ...section(10, bodies),
+  ]);
+}
+
+const bytes = buildModuleBytes();
+
+function FirstCall() {
+  const instance = new WebAssembly.Instance(new WebAssembly.Module(bytes));
+  if (instance.exports.main(0) == 0) throw new Error('Unexpected result');
+}
+
+new BenchmarkSuite('TimeToFirstCall', [1000], [
+  new Benchmark('TimeToFirstCall', false, false, 0, FirstCall),
+]);
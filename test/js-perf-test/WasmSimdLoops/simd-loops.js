@@ -0,0 +1,139 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures loops that combine two arrays element-wise with 128-bit wasm SIMD
+// operations, unrolled to handle 32 bytes per iteration. With
+// --wasm-simd-revectorize each iteration can be executed with 256-bit
+// operations.
+
+const kArraySize = 16384;
+const kLhs = 0;
+const kRhs = kArraySize;
+const kDst = 2 * kArraySize;
+const kIterations = 100;
+
+// Operation name and LEB-encoded SIMD opcode.
+const kOperations = [
+  ['F32x4Add', [0xe4, 0x01]],
+  ['F64x2Mul', [0xf2, 0x01]],
+  ['I32x4Add', [0xae, 0x01]],
+  ['I32x4Mul', [0xb5, 0x01]],
+  ['I16x8Sub', [0x91, 0x01]],
+  ['S128Xor', [0x51]],
+];
+
+function unsignedLeb(value) {
+  const bytes = [];
+  do {
+    let byte = value & 0x7f;
+    value >>>= 7;
+    if (value != 0) byte |= 0x80;
+    bytes.push(byte);
+  } while (value != 0);
+  return bytes;
+}
+
+function signedLeb(value) {
+  const bytes = [];
+  while (true) {
+    const byte = value & 0x7f;
+    value >>= 7;
+    if ((value == 0 && (byte & 0x40) == 0) ||
+        (value == -1 && (byte & 0x40) != 0)) {
+      bytes.push(byte);
+      return bytes;
+    }
+    bytes.push(byte | 0x80);
+  }
+}
+
+function section(id, entries) {
+  const content = [...unsignedLeb(entries.length), ...entries.flat()];
+  return [id, ...unsignedLeb(content.length), ...content];
+}
+
+function i32Const(value) {
+  return [0x41, ...signedLeb(value)];
+}
+
+// v128.load / v128.store at $i + offset.
+function s128Load(offset) {
+  return [0x20, 0x01, 0xfd, 0x00, 0x00, ...unsignedLeb(offset)];
+}
+
+function s128Store(offset) {
+  return [0xfd, 0x0b, 0x00, ...unsignedLeb(offset)];
+}
+
+// (func (param $n i32) (local $i i32)
+//   (block (loop
+//     (br_if 1 (i32.eqz (local.get $n)))
+//     (local.set $i (i32.const 0))
+//     (loop
+//       dst[$i] = lhs[$i] <op> rhs[$i]
+//       dst[$i + 16] = lhs[$i + 16] <op> rhs[$i + 16]
+//       (br_if 0 (i32.lt_u (local.tee $i (i32.add $i 32)) kArraySize)))
+//     (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+//     (br 0))))
+function loopBody(operation) {
+  const inner = [];
+  for (const offset of [0, 16]) {
+    inner.push(0x20, 0x01,
+               ...s128Load(kLhs + offset), ...s128Load(kRhs + offset),
+               0xfd, ...operation, ...s128Store(kDst + offset));
+  }
+  const code = [
+    0x01, 0x01, 0x7f,                    // local $i i32
+    0x02, 0x40, 0x03, 0x40,              // block, loop
+    0x20, 0x00, 0x45, 0x0d, 0x01,        // br_if 1 (i32.eqz $n)
+    ...i32Const(0), 0x21, 0x01,          // $i = 0
+    0x03, 0x40,                          // loop
+    ...inner,
+    0x20, 0x01, ...i32Const(32), 0x6a,   // $i + 32
+    0x22, 0x01,                          // local.tee $i
+    ...i32Const(kArraySize), 0x49,       // i32.lt_u
+    0x0d, 0x00, 0x0b,                    // br_if 0, end loop
+    0x20, 0x00, 0x41, 0x01, 0x6b,        // $n - 1
+    0x21, 0x00, 0x0c, 0x00,              // local.set $n, br 0
+    0x0b, 0x0b, 0x0b,                    // end loop, block, function
+  ];
+  return [...unsignedLeb(code.length), ...code];
+}
+
+function name(string) {
+  return [string.length, ...Array.from(string, c => c.charCodeAt(0))];
+}
+
+function buildModule() {
+  const functions = [];
+  const exports = [];
+  const bodies = [];
+  for (const [op, encoding] of kOperations) {
+    bodies.push(loopBody(encoding));
+    exports.push([...name(op), 0x00, ...unsignedLeb(functions.length)]);
+    functions.push([0x00]);
+  }
+  exports.push([...name('memory'), 0x02, 0x00]);
+  const bytes = [
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    ...section(1, [[0x60, 0x01, 0x7f, 0x00]]),  // (i32) -> ()
+    ...section(3, functions),
+    ...section(5, [[0x00, 0x01]]),  // 1 page
+    ...section(7, exports),
+    ...section(10, bodies),
+  ];
+  return new WebAssembly.Instance(
+      new WebAssembly.Module(new Uint8Array(bytes))).exports;
+}
+
+const instance = buildModule();
+const memory = new Uint8Array(instance.memory.buffer);
+for (let i = 0; i < kDst; ++i) memory[i] = (i * 13 + 7) & 0xff;
+
+for (const [op] of kOperations) {
+  const fn = instance[op];
+  new BenchmarkSuite(op, [1000], [
+    new Benchmark(op, false, false, 0, () => fn(kIterations)),
+  ]);
+}
@@ -0,0 +1,89 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-loop-variable
+// Flags: --turbo-bounds-check-elimination
+
+// Increasing loop bounded by the array length.
+(function() {
+  function sum(a) {
+    let s = 0;
+    for (let i = 0; i < a.length; i++) s += a[i];
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(6, sum([1, 2, 3]));
+  assertEquals(10, sum([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(15, sum([1, 2, 3, 4, 5]));
+  assertEquals(0, sum([]));
+  assertOptimized(sum);
+})();
+
+// Decreasing loop starting at length - 1.
+(function() {
+  function sum(a) {
+    let s = 0;
+    for (let i = a.length - 1; i >= 0; i--) s += a[i];
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(6, sum(new Int32Array([1, 2, 3])));
+  assertEquals(10, sum(new Int32Array([1, 2, 3, 4])));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(15, sum(new Int32Array([1, 2, 3, 4, 5])));
+  assertEquals(0, sum(new Int32Array(0)));
+  assertOptimized(sum);
+})();
+
+// Nested loops over the rows of a matrix.
+(function() {
+  function sum(m) {
+    let s = 0;
+    for (let i = 0; i < m.length; i++) {
+      const row = m[i];
+      for (let j = 0; j < row.length; j++) s += row[j];
+    }
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(10, sum([[1, 2], [3, 4]]));
+  assertEquals(21, sum([[1, 2, 3], [4, 5, 6]]));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(21, sum([[1], [2, 3], [4, 5, 6]]));
+  assertOptimized(sum);
+})();
+
+// The array shrinks inside the loop, so the length is reloaded and the
+// accesses must still be checked.
+(function() {
+  function f(a) {
+    let r = [];
+    for (let i = 0; i < a.length; i++) {
+      r.push(a[i]);
+      if (i == 1) a.length = 1;
+    }
+    return r;
+  }
+  %PrepareFunctionForOptimization(f);
+  assertEquals([1], f([1]));
+  assertEquals([1], f([1]));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals([1, 2], f([1, 2, 3, 4]));
+})();
+
+// The loop condition does not involve the accessed array.
+(function() {
+  function f(a, n) {
+    let s = 0;
+    for (let i = 0; i < n; i++) s += a[i];
+    return s;
+  }
+  %PrepareFunctionForOptimization(f);
+  assertEquals(3, f([1, 2], 2));
+  assertEquals(3, f([1, 2], 2));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(3, f([1, 2], 2));
+  assertEquals(NaN, f([1, 2], 3));
+})();
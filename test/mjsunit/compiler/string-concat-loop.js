@@ -0,0 +1,47 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+(function() {
+  function f(pieces) {
+    let s = '';
+    for (let i = 0; i < pieces.length; ++i) s += pieces[i];
+    return s;
+  }
+
+  %PrepareFunctionForOptimization(f);
+  assertEquals('abcdefghijklmnop', f(['abcd', 'efgh', 'ijkl', 'mnop']));
+  assertEquals('abcdefghijklmnop', f(['abcd', 'efgh', 'ijkl', 'mnop']));
+  %OptimizeFunctionOnNextCall(f);
+  // Results longer than ConsString::kMinLength.
+  assertEquals('abcdefghijklmnop', f(['abcd', 'efgh', 'ijkl', 'mnop']));
+  assertEquals('abcdefghijklmnop'.repeat(10),
+               f(new Array(10).fill('abcdefghijklmnop')));
+  // Empty pieces on either side.
+  assertEquals('abcdefghijklmnop', f(['', 'abcdefghijklmnop', '']));
+  assertEquals('abcdefghijklmnopq', f(['abcdefghijklmnop', '', 'q']));
+  // Short results.
+  assertEquals('abc', f(['a', 'b', 'c']));
+  assertEquals('', f(['', '']));
+  // Mixed one-byte and two-byte pieces.
+  const s = f(['abcdefghijklmnop', 'αβγ', 'xyz']);
+  assertEquals('abcdefghijklmnopαβγxyz', s);
+  assertEquals(0x3b2, s.charCodeAt(17));
+})();
+
+(function() {
+  function f(a, b) {
+    return `<${a} class="${b}">${a}${b}</${a}>`;
+  }
+
+  %PrepareFunctionForOptimization(f);
+  assertEquals('<div class="x">divx</div>', f('div', 'x'));
+  assertEquals('<div class="x">divx</div>', f('div', 'x'));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals('<div class="x">divx</div>', f('div', 'x'));
+  assertEquals('<p class="">p</p>', f('p', ''));
+  assertEquals('<é class="☃">é☃</é>',
+               f('é', '☃'));
+})();
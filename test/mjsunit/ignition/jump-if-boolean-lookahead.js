@@ -0,0 +1,63 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --no-opt --no-sparkplug
+
+// Test bytecodes directly followed by JumpIfTrue/JumpIfFalse are dispatched
+// inline; check that both branch directions are taken correctly.
+
+function branch(cond) {
+  if (cond) return 1;
+  return 2;
+}
+
+function eq(a, b) { if (a == b) return 1; return 2; }
+function seq(a, b) { if (a === b) return 1; return 2; }
+function lt(a, b) { if (a < b) return 1; return 2; }
+function gt(a, b) { if (a > b) return 1; return 2; }
+function le(a, b) { if (a <= b) return 1; return 2; }
+function ge(a, b) { if (a >= b) return 1; return 2; }
+function nlt(a, b) { if (!(a < b)) return 1; return 2; }
+function inst(a, b) { if (a instanceof b) return 1; return 2; }
+function has(a, b) { if (a in b) return 1; return 2; }
+function isNull(a) { if (a === null) return 1; return 2; }
+function isUndefined(a) { if (a === undefined) return 1; return 2; }
+function isNullish(a) { if (a == null) return 1; return 2; }
+function isNumber(a) { if (typeof a === 'number') return 1; return 2; }
+function ternary(a, b) { return a < b ? 'lt' : 'ge'; }
+
+for (let i = 0; i < 3; i++) {
+  assertEquals(1, eq(1, '1'));
+  assertEquals(2, eq(1, 2));
+  assertEquals(1, seq(1, 1));
+  assertEquals(2, seq(1, '1'));
+  assertEquals(1, lt(1, 2));
+  assertEquals(2, lt(2, 1));
+  assertEquals(2, lt(NaN, 1));
+  assertEquals(1, gt(2, 1));
+  assertEquals(2, gt(1, 2));
+  assertEquals(1, le(1, 1));
+  assertEquals(2, le(2, 1));
+  assertEquals(1, ge(1, 1));
+  assertEquals(2, ge(1, 2));
+  assertEquals(1, nlt(NaN, 1));
+  assertEquals(2, nlt(1, 2));
+  assertEquals(1, inst([], Array));
+  assertEquals(2, inst({}, Array));
+  assertEquals(1, has('x', {x: 1}));
+  assertEquals(2, has('y', {x: 1}));
+  assertEquals(1, isNull(null));
+  assertEquals(2, isNull(undefined));
+  assertEquals(1, isUndefined(undefined));
+  assertEquals(2, isUndefined(null));
+  assertEquals(1, isNullish(undefined));
+  assertEquals(1, isNullish(null));
+  assertEquals(2, isNullish(0));
+  assertEquals(1, isNumber(1.5));
+  assertEquals(2, isNumber('1'));
+  assertEquals('lt', ternary(1, 2));
+  assertEquals('ge', ternary(2, 1));
+  assertEquals(1, branch(true));
+  assertEquals(2, branch(false));
+}
@@ -0,0 +1,104 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --liftoff --no-wasm-tier-up
+
+// Small memory.copy and memory.fill operations with a constant size are
+// emitted inline by Liftoff and TurboFan; check them against a reference.
+
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+const kSizes = [1, 2, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 48, 63, 64, 65, 255];
+
+const builder = new WasmModuleBuilder();
+builder.addMemory(1, 1, true);
+for (const size of kSizes) {
+  builder.addFunction('copy' + size, kSig_v_ii)
+      .addBody([
+        kExprLocalGet, 0,  // Dest.
+        kExprLocalGet, 1,  // Source.
+        ...wasmI32Const(size),
+        kNumericPrefix, kExprMemoryCopy, 0, 0,
+      ])
+      .exportFunc();
+  builder.addFunction('fill' + size, kSig_v_ii)
+      .addBody([
+        kExprLocalGet, 0,  // Dest.
+        kExprLocalGet, 1,  // Value.
+        ...wasmI32Const(size),
+        kNumericPrefix, kExprMemoryFill, 0,
+      ])
+      .exportFunc();
+}
+const instance = builder.instantiate();
+const exports = instance.exports;
+const mem = new Uint8Array(exports.memory.buffer);
+
+function reset() {
+  for (let i = 0; i < mem.length; ++i) mem[i] = (i * 7 + 3) & 0xff;
+}
+
+function assertMemoryEquals(expected, name) {
+  for (let i = 0; i < mem.length; ++i) {
+    if (mem[i] != expected[i]) {
+      assertEquals(expected[i], mem[i], `${name}: byte ${i}`);
+    }
+  }
+}
+
+function checkCopy(size, dst, src) {
+  reset();
+  const expected = mem.slice();
+  expected.copyWithin(dst, src, src + size);
+  exports['copy' + size](dst, src);
+  assertMemoryEquals(expected, `copy${size}(${dst}, ${src})`);
+}
+
+function checkFill(size, dst, value) {
+  reset();
+  const expected = mem.slice();
+  expected.fill(value & 0xff, dst, dst + size);
+  exports['fill' + size](dst, value);
+  assertMemoryEquals(expected, `fill${size}(${dst}, ${value})`);
+}
+
+function checkOutOfBounds(size) {
+  reset();
+  const expected = mem.slice();
+  // Nothing is written if any byte of a range is out of bounds.
+  for (const index of [kPageSize - size + 1, kPageSize, -1]) {
+    assertTraps(kTrapMemOutOfBounds, () => exports['copy' + size](index, 0));
+    assertTraps(kTrapMemOutOfBounds, () => exports['copy' + size](0, index));
+    assertTraps(kTrapMemOutOfBounds, () => exports['fill' + size](index, 1));
+  }
+  assertMemoryEquals(expected, `out of bounds ${size}`);
+}
+
+function checkAll() {
+  for (const size of kSizes) {
+    checkCopy(size, 100, 1000);
+    checkCopy(size, 1001, 99);
+    // Overlapping ranges in both directions.
+    checkCopy(size, 50, 51);
+    checkCopy(size, 51, 50);
+    checkCopy(size, 50, 50 + (size >> 1));
+    checkCopy(size, 50 + (size >> 1), 50);
+    // Ranges ending at the end of memory.
+    checkCopy(size, kPageSize - size, 0);
+    checkCopy(size, 0, kPageSize - size);
+    checkFill(size, 3, 0xab);
+    checkFill(size, kPageSize - size, 0x1234);
+    checkFill(size, 0, -1);
+    checkOutOfBounds(size);
+  }
+}
+
+// Liftoff code.
+checkAll();
+
+for (let i = 0; i < builder.functions.length; ++i) {
+  %WasmTierUpFunction(instance, i);
+}
+// TurboFan code.
+checkAll();
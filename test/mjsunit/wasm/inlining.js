@@ -0,0 +1,130 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --wasm-inlining --no-liftoff
+
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+(function SimpleInliningTest() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  let add = builder.addFunction("add", kSig_i_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1, kExprI32Add]);
+  builder.addFunction("main", kSig_i_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1,
+              kExprCallFunction, add.index,
+              kExprI32Const, 2, kExprI32Mul])
+    .exportFunc();
+  let instance = builder.instantiate();
+  assertEquals(14, instance.exports.main(3, 4));
+  assertEquals(-2, instance.exports.main(0x7fffffff, 0));
+})();
+
+(function MultiReturnInliningTest() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  // Returns its arguments ordered, from two different returns.
+  let order = builder.addFunction("order", makeSig([kWasmI32, kWasmI32],
+                                                   [kWasmI32, kWasmI32]))
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1, kExprI32GtS,
+              kExprIf, kWasmVoid,
+                kExprLocalGet, 1, kExprLocalGet, 0, kExprReturn,
+              kExprEnd,
+              kExprLocalGet, 0, kExprLocalGet, 1]);
+  builder.addFunction("main", kSig_i_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1,
+              kExprCallFunction, order.index,
+              kExprI32Sub])
+    .exportFunc();
+  let instance = builder.instantiate();
+  assertEquals(-1, instance.exports.main(5, 6));
+  assertEquals(-1, instance.exports.main(6, 5));
+  assertEquals(0, instance.exports.main(7, 7));
+})();
+
+(function MemoryAndTrapInliningTest() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, true);
+  let store = builder.addFunction("store", kSig_v_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1,
+              kExprI32StoreMem, 2, 0]);
+  builder.addFunction("main", kSig_i_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1,
+              kExprCallFunction, store.index,
+              kExprLocalGet, 0, kExprI32LoadMem, 2, 0])
+    .exportFunc();
+  let instance = builder.instantiate();
+  assertEquals(42, instance.exports.main(8, 42));
+  assertEquals(42, new Int32Array(instance.exports.memory.buffer)[2]);
+  assertTraps(kTrapMemOutOfBounds, () => instance.exports.main(1 << 16, 1));
+})();
+
+(function NoReturnInliningTest() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  let fail = builder.addFunction("fail", kSig_i_v)
+    .addBody([kExprUnreachable]);
+  builder.addFunction("main", kSig_i_i)
+    .addBody([kExprLocalGet, 0,
+              kExprIf, kWasmI32,
+                kExprCallFunction, fail.index,
+              kExprElse,
+                kExprI32Const, 7,
+              kExprEnd])
+    .exportFunc();
+  let instance = builder.instantiate();
+  assertEquals(7, instance.exports.main(0));
+  assertTraps(kTrapUnreachable, () => instance.exports.main(1));
+})();
+
+(function LoopAndNestedInliningTest() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  let square = builder.addFunction("square", kSig_i_i)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 0, kExprI32Mul]);
+  // Sums the squares of 1 .. n.
+  let sum_squares = builder.addFunction("sum_squares", kSig_i_i)
+    .addLocals(kWasmI32, 1)
+    .addBody([kExprLoop, kWasmVoid,
+                kExprLocalGet, 0, kExprI32Eqz,
+                kExprIf, kWasmVoid,
+                  kExprLocalGet, 1, kExprReturn,
+                kExprEnd,
+                kExprLocalGet, 1,
+                kExprLocalGet, 0, kExprCallFunction, square.index,
+                kExprI32Add, kExprLocalSet, 1,
+                kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub,
+                kExprLocalSet, 0,
+                kExprBr, 0,
+              kExprEnd,
+              kExprUnreachable]);
+  builder.addFunction("main", kSig_i_i)
+    .addBody([kExprLocalGet, 0, kExprCallFunction, sum_squares.index])
+    .exportFunc();
+  let instance = builder.instantiate();
+  assertEquals(0, instance.exports.main(0));
+  assertEquals(385, instance.exports.main(10));
+})();
+
+(function RecursionInliningTest() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  let fact = builder.addFunction("fact", kSig_i_i);
+  fact.addBody([kExprLocalGet, 0, kExprI32Eqz,
+                kExprIf, kWasmI32,
+                  kExprI32Const, 1,
+                kExprElse,
+                  kExprLocalGet, 0,
+                  kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub,
+                  kExprCallFunction, fact.index,
+                  kExprI32Mul,
+                kExprEnd]);
+  builder.addFunction("main", kSig_i_i)
+    .addBody([kExprLocalGet, 0, kExprCallFunction, fact.index])
+    .exportFunc();
+  let instance = builder.instantiate();
+  assertEquals(1, instance.exports.main(0));
+  assertEquals(3628800, instance.exports.main(10));
+})();
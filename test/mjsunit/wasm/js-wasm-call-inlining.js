@@ -0,0 +1,156 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --opt --turbo-inline-js-wasm-calls
+// Flags: --experimental-wasm-reftypes
+
+// Calls to exported wasm functions are inlined into optimized JavaScript code;
+// check argument conversions, results, deoptimization and exceptions.
+
+load('test/mjsunit/wasm/wasm-module-builder.js');
+
+const builder = new WasmModuleBuilder();
+const kSig_r_ri = makeSig([kWasmExternRef, kWasmI32], [kWasmExternRef]);
+const deoptIndex = builder.addImport('m', 'deopt', kSig_v_v);
+builder.addFunction('add', kSig_i_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1, kExprI32Add])
+    .exportFunc();
+builder.addFunction('mul', kSig_d_dd)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1, kExprF64Mul])
+    .exportFunc();
+builder.addFunction('neg', kSig_f_f)
+    .addBody([kExprLocalGet, 0, kExprF32Neg])
+    .exportFunc();
+builder.addFunction('select', kSig_r_ri)
+    .addBody([
+      kExprLocalGet, 1,
+      kExprIf, kWasmExternRef,
+        kExprLocalGet, 0,
+      kExprElse,
+        kExprRefNull, kWasmExternRef,
+      kExprEnd,
+    ])
+    .exportFunc();
+builder.addFunction('addAndDeopt', kSig_i_ii)
+    .addBody([
+      kExprCallFunction, deoptIndex,
+      kExprLocalGet, 0, kExprLocalGet, 1, kExprI32Add,
+    ])
+    .exportFunc();
+builder.addFunction('trap', kSig_i_i)
+    .addBody([kExprUnreachable])
+    .exportFunc();
+
+let deoptTarget = undefined;
+const exports = builder.instantiate({
+  m: {deopt: () => deoptTarget && %DeoptimizeFunction(deoptTarget)},
+}).exports;
+
+function optimize(fn, ...warmup) {
+  %PrepareFunctionForOptimization(fn);
+  for (const args of warmup) fn(...args);
+  %OptimizeFunctionOnNextCall(fn);
+}
+
+(function testI32() {
+  print(arguments.callee.name);
+  function sum(n) {
+    let result = 0;
+    for (let i = 0; i < n; ++i) result = exports.add(result, i);
+    return result;
+  }
+  optimize(sum, [10], [20]);
+  assertEquals(4950, sum(100));
+  assertOptimized(sum);
+  // Overflow wraps around like in wasm.
+  function addOne(x) {
+    return exports.add(x, 1);
+  }
+  optimize(addOne, [1], [2]);
+  assertEquals(-0x80000000, addOne(0x7fffffff));
+  // Missing arguments are undefined, converted to 0; extra ones are ignored.
+  function addMissing(x) {
+    return exports.add(x);
+  }
+  optimize(addMissing, [1], [2]);
+  assertEquals(5, addMissing(5));
+  function addExtra(x) {
+    return exports.add(x, x, x);
+  }
+  optimize(addExtra, [1], [2]);
+  assertEquals(10, addExtra(5));
+})();
+
+(function testFloats() {
+  print(arguments.callee.name);
+  function mul(a, b) {
+    return exports.mul(a, b);
+  }
+  optimize(mul, [1.5, 2], [3, 4]);
+  assertEquals(7.5, mul(2.5, 3));
+  assertEquals(-0, mul(-0, 1));
+  assertOptimized(mul);
+  function neg(x) {
+    return exports.neg(x);
+  }
+  optimize(neg, [1.5], [2]);
+  assertEquals(-0.5, neg(0.5));
+  // The argument is rounded to float32.
+  assertEquals(Math.fround(-0.1), neg(0.1));
+  assertOptimized(neg);
+})();
+
+(function testNonNumberArguments() {
+  print(arguments.callee.name);
+  function add(a, b) {
+    return exports.add(a, b);
+  }
+  optimize(add, [1, 2], [3, 4]);
+  assertEquals(7, add(3, 4));
+  // Arguments that are not numbers or oddballs deoptimize and are converted
+  // like in the JS-to-wasm wrapper.
+  assertEquals(7, add('3', {valueOf: () => 4}));
+  assertEquals(1, add(true, null));
+  assertEquals(3, add(3.9, undefined));
+})();
+
+(function testExternRef() {
+  print(arguments.callee.name);
+  function select(value, condition) {
+    return exports.select(value, condition);
+  }
+  const object = {};
+  optimize(select, [object, 1], ['abc', 0]);
+  assertSame(object, select(object, 1));
+  assertSame(null, select(object, 0));
+  assertEquals('abc', select('abc', 1));
+  assertEquals(undefined, select(undefined, 1));
+  assertOptimized(select);
+})();
+
+(function testLazyDeopt() {
+  print(arguments.callee.name);
+  function addAndDeopt(a, b) {
+    return exports.addAndDeopt(a, b) + 1;
+  }
+  optimize(addAndDeopt, [1, 2], [3, 4]);
+  deoptTarget = addAndDeopt;
+  // The result of the wasm call survives the deoptimization.
+  assertEquals(8, addAndDeopt(3, 4));
+  assertUnoptimized(addAndDeopt);
+  deoptTarget = undefined;
+})();
+
+(function testTrap() {
+  print(arguments.callee.name);
+  function trap(x) {
+    try {
+      return exports.trap(x);
+    } catch (e) {
+      return e;
+    }
+  }
+  optimize(trap, [1], [2]);
+  assertInstanceof(trap(3), WebAssembly.RuntimeError);
+})();
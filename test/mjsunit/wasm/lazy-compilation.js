@@ -97,3 +97,32 @@ load('test/mjsunit/wasm/wasm-module-builder.js');
   instance2.exports.exp_store(7);
   assertEquals(7, mem1[0]);
 })();
+
+(function validateManyLazyFunctions() {
+  print(arguments.callee.name);
+  // Lazily compiled functions are still validated up front, in parallel. The
+  // error must be reported for the first invalid function.
+  const builder = new WasmModuleBuilder();
+  for (let i = 0; i < 1000; ++i) {
+    const invalid = i == 500 || i == 900;
+    builder.addFunction('f' + i, kSig_i_i)
+        .addBody(invalid ? [kExprLocalGet, 0, kExprI64Eqz] :
+                           [kExprLocalGet, 0, ...wasmI32Const(i), kExprI32Add])
+        .exportFunc();
+  }
+  const bytes = builder.toBuffer();
+  assertThrows(
+      () => new WebAssembly.Module(bytes), WebAssembly.CompileError,
+      /Compiling function #500:"f500" failed/);
+  assertThrowsAsync(WebAssembly.compile(bytes), WebAssembly.CompileError);
+
+  // Without the invalid functions, the module compiles and runs.
+  const valid_builder = new WasmModuleBuilder();
+  for (let i = 0; i < 1000; ++i) {
+    valid_builder.addFunction('f' + i, kSig_i_i)
+        .addBody([kExprLocalGet, 0, ...wasmI32Const(i), kExprI32Add])
+        .exportFunc();
+  }
+  const instance = valid_builder.instantiate();
+  assertEquals(1000, instance.exports.f999(1));
+})();
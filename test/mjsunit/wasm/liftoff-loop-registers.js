@@ -0,0 +1,167 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --liftoff --no-wasm-tier-up
+
+// Liftoff keeps locals in registers across the back-edges of loops; check
+// that their values survive calls, nested loops and if/else in the body.
+
+load('test/mjsunit/wasm/wasm-module-builder.js');
+
+(function testLoopInvariantLocals() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  // sum(n, a, b) = sum of (a * i + b) for i in [0, n).
+  builder.addFunction('sum', kSig_i_iii)
+      .addLocals(kWasmI32, 2)  // i, acc
+      .addBody([
+        kExprBlock, kWasmVoid,
+          kExprLoop, kWasmVoid,
+            kExprLocalGet, 3, kExprLocalGet, 0, kExprI32GeS,
+            kExprBrIf, 1,
+            kExprLocalGet, 4,
+            kExprLocalGet, 1, kExprLocalGet, 3, kExprI32Mul,
+            kExprLocalGet, 2, kExprI32Add,
+            kExprI32Add, kExprLocalSet, 4,
+            kExprLocalGet, 3, kExprI32Const, 1, kExprI32Add,
+            kExprLocalSet, 3,
+            kExprBr, 0,
+          kExprEnd,
+        kExprEnd,
+        kExprLocalGet, 4,
+      ])
+      .exportFunc();
+  const sum = builder.instantiate().exports.sum;
+  for (const [n, a, b] of [[0, 1, 2], [1, 3, 4], [10, 3, 4], [1000, -7, 11]]) {
+    let expected = 0;
+    for (let i = 0; i < n; ++i) expected = (expected + a * i + b) | 0;
+    assertEquals(expected, sum(n, a, b));
+  }
+})();
+
+(function testCallInLoopBody() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  const imp = builder.addImport('m', 'f', kSig_i_i);
+  // The call spills all registers, the back-edge has to reload them.
+  builder.addFunction('main', makeSig([kWasmI32, kWasmI32, kWasmF64],
+                                      [kWasmF64]))
+      .addLocals(kWasmF64, 1)
+      .addLocals(kWasmI64, 1)
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 3,
+          kExprLocalGet, 2, kExprF64Add,
+          kExprLocalGet, 1, kExprCallFunction, imp,
+          kExprF64SConvertI32, kExprF64Add,
+          kExprLocalSet, 3,
+          kExprLocalGet, 4, kExprLocalGet, 1, kExprI64SConvertI32,
+          kExprI64Add, kExprLocalSet, 4,
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub,
+          kExprLocalTee, 0,
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 3,
+        kExprLocalGet, 4, kExprF64SConvertI64, kExprF64Add,
+      ])
+      .exportFunc();
+  let calls = 0;
+  const main = builder.instantiate({m: {f: x => (++calls, x * 2)}})
+                   .exports.main;
+  assertEquals(10 * (1.5 + 6) + 10 * 3, main(10, 3, 1.5));
+  assertEquals(10, calls);
+})();
+
+(function testIfElseAndNestedLoops() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  // for (i = n; i != 0; --i) {
+  //   for (j = m; j != 0; --j) {
+  //     if (j & 1) { odd += i * k } else { even += j + k }
+  //   }
+  // }
+  // return odd * 3 + even;
+  builder.addFunction('main', kSig_i_iii)
+      .addLocals(kWasmI32, 3)  // j, odd, even
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 1, kExprLocalSet, 3,
+          kExprLoop, kWasmVoid,
+            kExprLocalGet, 3, kExprI32Const, 1, kExprI32And,
+            kExprIf, kWasmVoid,
+              kExprLocalGet, 4,
+              kExprLocalGet, 0, kExprLocalGet, 2, kExprI32Mul,
+              kExprI32Add, kExprLocalSet, 4,
+            kExprElse,
+              kExprLocalGet, 5,
+              kExprLocalGet, 3, kExprLocalGet, 2, kExprI32Add,
+              kExprI32Add, kExprLocalSet, 5,
+            kExprEnd,
+            kExprLocalGet, 3, kExprI32Const, 1, kExprI32Sub,
+            kExprLocalTee, 3,
+            kExprBrIf, 0,
+          kExprEnd,
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub,
+          kExprLocalTee, 0,
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 4, kExprI32Const, 3, kExprI32Mul,
+        kExprLocalGet, 5, kExprI32Add,
+      ])
+      .exportFunc();
+  const main = builder.instantiate().exports.main;
+  for (const [n, m, k] of [[1, 1, 1], [5, 7, 3], [30, 20, -9]]) {
+    let odd = 0, even = 0;
+    for (let i = n; i != 0; --i) {
+      for (let j = m; j != 0; --j) {
+        if (j & 1) odd += i * k; else even += j + k;
+      }
+    }
+    assertEquals(odd * 3 + even, main(n, m, k));
+  }
+})();
+
+(function testManyLocals() {
+  print(arguments.callee.name);
+  // More live locals than registers; some of them have to be spilled at the
+  // loop header.
+  const kNumLocals = 40;
+  const builder = new WasmModuleBuilder();
+  const body = [];
+  // Initialize local i (after the parameter) to i.
+  for (let i = 1; i <= kNumLocals; ++i) {
+    body.push(...wasmI32Const(i), kExprLocalSet, i);
+  }
+  body.push(kExprLoop, kWasmVoid);
+  // Rotate the locals by one and add the parameter to the first one.
+  body.push(kExprLocalGet, kNumLocals);
+  for (let i = kNumLocals; i > 1; --i) {
+    body.push(kExprLocalGet, i - 1, kExprLocalSet, i);
+  }
+  body.push(kExprLocalGet, 0, kExprI32Add, kExprLocalSet, 1);
+  body.push(kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub,
+            kExprLocalTee, 0, kExprBrIf, 0, kExprEnd);
+  // Return sum(local[i] * i).
+  body.push(kExprI32Const, 0);
+  for (let i = 1; i <= kNumLocals; ++i) {
+    body.push(kExprLocalGet, i, ...wasmI32Const(i), kExprI32Mul, kExprI32Add);
+  }
+  builder.addFunction('main', kSig_i_i)
+      .addLocals(kWasmI32, kNumLocals)
+      .addBody(body)
+      .exportFunc();
+  const main = builder.instantiate().exports.main;
+  for (const n of [1, 2, 39, 40, 41, 100]) {
+    const locals = [0];
+    for (let i = 1; i <= kNumLocals; ++i) locals[i] = i;
+    for (let p = n; p != 0; --p) {
+      const last = locals[kNumLocals];
+      for (let i = kNumLocals; i > 1; --i) locals[i] = locals[i - 1];
+      locals[1] = last + p;
+    }
+    let expected = 0;
+    for (let i = 1; i <= kNumLocals; ++i) expected += locals[i] * i;
+    assertEquals(expected, main(n));
+  }
+})();
@@ -0,0 +1,187 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --experimental-wasm-simd --wasm-simd-revectorize --no-liftoff
+
+// Two Simd128 operations on adjacent memory can be combined into one 256-bit
+// operation; check overlapping operands and out-of-bounds accesses against
+// the sequential 128-bit semantics.
+
+load('test/mjsunit/wasm/wasm-module-builder.js');
+
+function simdOp(op) {
+  return op < 0x80 ? [kSimdPrefix, op] : [kSimdPrefix, op, 0x01];
+}
+
+function s128Load(local, offset) {
+  return [kExprLocalGet, local, kSimdPrefix, kExprS128LoadMem, 0, offset];
+}
+
+function s128Store(offset) {
+  return [kSimdPrefix, kExprS128StoreMem, 0, offset];
+}
+
+const kBinops = [
+  {name: 'i8x16_sub', op: kExprI8x16Sub, type: Int8Array, fn: (a, b) => a - b},
+  {name: 'i16x8_mul', op: kExprI16x8Mul, type: Int16Array, fn: Math.imul},
+  {name: 'i32x4_add', op: kExprI32x4Add, type: Int32Array, fn: (a, b) => a + b},
+  {name: 'i32x4_mul', op: kExprI32x4Mul, type: Int32Array, fn: Math.imul},
+  {name: 'i64x2_add', op: kExprI64x2Add, type: BigInt64Array,
+   fn: (a, b) => a + b},
+  {name: 'f32x4_div', op: kExprF32x4Div, type: Float32Array,
+   fn: (a, b) => a / b},
+  {name: 'f64x2_mul', op: kExprF64x2Mul, type: Float64Array,
+   fn: (a, b) => a * b},
+  {name: 'v128_xor', op: kExprS128Xor, type: Int32Array, fn: (a, b) => a ^ b},
+];
+
+const builder = new WasmModuleBuilder();
+builder.addMemory(1, 1, true);
+for (const {name, op} of kBinops) {
+  // (dst, lhs, rhs): dst[0..32) = lhs[0..32) op rhs[0..32).
+  const body = [];
+  for (const offset of [0, 16]) {
+    body.push(kExprLocalGet, 0, ...s128Load(1, offset), ...s128Load(2, offset),
+              ...simdOp(op), ...s128Store(offset));
+  }
+  builder.addFunction(name, kSig_v_iii).addBody(body).exportFunc();
+}
+// (dst, src, x): dst[0..32) = splat(x) - src[0..32), with the loads of both
+// halves before the stores.
+builder.addFunction('i32x4_sub_splat', kSig_v_iii)
+    .addBody([
+      kExprLocalGet, 0,
+      kExprLocalGet, 2, ...simdOp(kExprI32x4Splat), ...s128Load(1, 0),
+      ...simdOp(kExprI32x4Sub),
+      kExprLocalGet, 2, ...simdOp(kExprI32x4Splat), ...s128Load(1, 16),
+      ...simdOp(kExprI32x4Sub),
+      kExprLocalSet, 3,
+      ...s128Store(0),
+      kExprLocalGet, 0, kExprLocalGet, 3, ...s128Store(16),
+    ])
+    .addLocals(kWasmS128, 1)
+    .exportFunc();
+const instance = builder.instantiate();
+const exports = instance.exports;
+const mem = new Uint8Array(exports.memory.buffer);
+
+function reset() {
+  let seed = 17;
+  for (let i = 0; i < mem.length; ++i) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    mem[i] = seed >> 16;
+  }
+}
+
+function read(bytes, type, offset) {
+  return new type(bytes.slice(offset, offset + 16).buffer);
+}
+
+// Runs the two halves of the operation one after the other, like the
+// original code; stops at the first out-of-bounds access.
+function reference(bytes, type, fn, dst, lhs, rhs) {
+  for (const offset of [0, 16]) {
+    const end = Math.max(dst, lhs, rhs) + offset + 16;
+    if (Math.min(dst, lhs, rhs) < 0 || end > bytes.length) return true;
+    const a = read(bytes, type, lhs + offset);
+    const b = read(bytes, type, rhs + offset);
+    const result = new type(a.length);
+    for (let i = 0; i < a.length; ++i) result[i] = fn(a[i], b[i]);
+    bytes.set(new Uint8Array(result.buffer), dst + offset);
+  }
+  return false;
+}
+
+function assertMemoryEquals(expected, name) {
+  for (let i = 0; i < mem.length; ++i) {
+    if (mem[i] != expected[i]) {
+      assertEquals(expected[i], mem[i], `${name}: byte ${i}`);
+    }
+  }
+}
+
+function check({name, type, fn}, dst, lhs, rhs) {
+  reset();
+  const expected = mem.slice();
+  const traps = reference(expected, type, fn, dst, lhs, rhs);
+  const description = `${name}(${dst}, ${lhs}, ${rhs})`;
+  if (traps) {
+    assertTraps(kTrapMemOutOfBounds, () => exports[name](dst, lhs, rhs));
+  } else {
+    exports[name](dst, lhs, rhs);
+  }
+  assertMemoryEquals(expected, description);
+}
+
+(function testBinops() {
+  print(arguments.callee.name);
+  for (const binop of kBinops) {
+    check(binop, 1024, 2048, 4096);
+    check(binop, 1027, 2050, 4101);
+    // The result overwrites one of the operands.
+    check(binop, 2048, 2048, 4096);
+    check(binop, 4096, 2048, 4096);
+    // The first store overwrites (part of) the second half of an operand.
+    check(binop, 2064, 2048, 4096);
+    check(binop, 2056, 2048, 4096);
+    check(binop, 4127, 2048, 4096);
+    check(binop, 4097, 2048, 4096);
+    // ... or the first half only.
+    check(binop, 2032, 2048, 4096);
+    check(binop, 2080, 2048, 4096);
+  }
+})();
+
+(function testOutOfBounds() {
+  print(arguments.callee.name);
+  for (const binop of kBinops) {
+    // Only the second store is out of bounds.
+    check(binop, kPageSize - 24, 2048, 4096);
+    check(binop, kPageSize - 17, 2048, 4096);
+    // Only the second half of an operand is out of bounds.
+    check(binop, 1024, kPageSize - 20, 4096);
+    check(binop, 1024, 2048, kPageSize - 31);
+    // Everything is out of bounds.
+    check(binop, kPageSize - 8, 2048, 4096);
+    check(binop, 1024, -1, 4096);
+  }
+})();
+
+function checkSplat(dst, src, x) {
+  reset();
+  const expected = mem.slice();
+  // Both halves of {src} are loaded before the first store.
+  let traps = src + 32 > mem.length;
+  if (!traps) {
+    const values =
+        new Int32Array(expected.slice(src, src + 32).buffer).map(v => x - v);
+    const bytes = new Uint8Array(values.buffer);
+    for (const offset of [0, 16]) {
+      if (dst + offset + 16 > mem.length) {
+        traps = true;
+        break;
+      }
+      expected.set(bytes.subarray(offset, offset + 16), dst + offset);
+    }
+  }
+  if (traps) {
+    assertTraps(kTrapMemOutOfBounds,
+                () => exports.i32x4_sub_splat(dst, src, x));
+  } else {
+    exports.i32x4_sub_splat(dst, src, x);
+  }
+  assertMemoryEquals(expected, `i32x4_sub_splat(${dst}, ${src}, ${x})`);
+}
+
+(function testSharedOperand() {
+  print(arguments.callee.name);
+  for (const x of [0, 1, -7, 0x12345678]) {
+    checkSplat(1024, 2048, x);
+    checkSplat(1027, 2048, x);
+    checkSplat(2064, 2048, x);
+    checkSplat(2056, 2048, x);
+    checkSplat(kPageSize - 24, 2048, x);
+    checkSplat(1024, kPageSize - 20, x);
+  }
+})();
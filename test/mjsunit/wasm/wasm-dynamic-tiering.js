@@ -3,11 +3,12 @@
 // found in the LICENSE file.
 
 // Flags: --allow-natives-syntax --wasm-dynamic-tiering --liftoff
-// Flags: --no-wasm-tier-up --no-stress-opt
+// Flags: --no-wasm-tier-up --no-stress-opt --wasm-tiering-budget=16
 
 load('test/mjsunit/wasm/wasm-module-builder.js');
 
-const num_iterations = 4;
+// Liftoff counts calls starting at 4; the budget is reached after 12 calls.
+const num_iterations = 12;
 const num_functions = 2;
 
 const builder = new WasmModuleBuilder();
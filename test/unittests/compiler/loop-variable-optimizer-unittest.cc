@@ -0,0 +1,118 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-variable-optimizer.h"
+
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopVariableOptimizerTest : public GraphTest {
+ public:
+  LoopVariableOptimizerTest() : GraphTest(2), simplified_(zone()) {}
+  ~LoopVariableOptimizerTest() override = default;
+
+ protected:
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  // Builds the graph of
+  //
+  //   for (let i = 0; i < {bound}; i++) a[i];
+  //
+  // where the access to a[i] is checked against {length} and i has type
+  // {index_type}, and returns the CheckBounds node.
+  Node* BuildLoopWithBoundsCheck(Node* length, Node* bound, Type index_type) {
+    Node* start = graph()->start();
+    Node* loop = graph()->NewNode(common()->Loop(2), start, start);
+    Node* effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start, start, loop);
+    Node* zero = NumberConstant(0);
+    Node* phi = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kTagged, 2), zero, zero, loop);
+    Node* cmp = graph()->NewNode(simplified()->NumberLessThan(), phi, bound);
+    Node* branch = graph()->NewNode(common()->Branch(), cmp, loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* check = graph()->NewNode(
+        simplified()->CheckBounds(FeedbackSource()), phi, length, effect_phi,
+        if_true);
+    Node* add =
+        graph()->NewNode(simplified()->NumberAdd(), phi, NumberConstant(1));
+    loop->ReplaceInput(1, if_true);
+    effect_phi->ReplaceInput(1, check);
+    phi->ReplaceInput(1, add);
+    Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+    Node* ret = graph()->NewNode(common()->Return(), Int32Constant(0), phi,
+                                 effect_phi, if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+    NodeProperties::SetType(phi, index_type);
+    NodeProperties::SetType(add, index_type);
+    NodeProperties::SetType(check,
+                            Type::Range(0, FixedArray::kMaxLength - 1, zone()));
+    return check;
+  }
+
+  Node* BuildLoopWithBoundsCheck(Node* length, Node* bound) {
+    return BuildLoopWithBoundsCheck(length, bound,
+                                    Type::Range(0, kMaxSafeInteger, zone()));
+  }
+
+  void EliminateRedundantBoundsChecks() {
+    LoopVariableOptimizer optimizer(graph(), common(), zone());
+    optimizer.Run();
+    optimizer.EliminateRedundantBoundsChecks();
+  }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+TEST_F(LoopVariableOptimizerTest, BoundsCheckDominatedByLoopCondition) {
+  Node* length = Parameter(Type::Range(0, FixedArray::kMaxLength, zone()), 0);
+  Node* check = BuildLoopWithBoundsCheck(length, length);
+  Node* index = NodeProperties::GetValueInput(check, 0);
+  Node* effect = NodeProperties::GetEffectInput(check);
+  Node* control = NodeProperties::GetControlInput(check);
+
+  EliminateRedundantBoundsChecks();
+
+  // The check is gone; only a guard for its type remains.
+  EXPECT_THAT(check, IsTypeGuard(index, control));
+  EXPECT_EQ(1, check->op()->ValueInputCount());
+  EXPECT_EQ(effect, NodeProperties::GetEffectInput(check));
+}
+
+TEST_F(LoopVariableOptimizerTest, BoundsCheckOnOtherLength) {
+  Node* length = Parameter(Type::Range(0, FixedArray::kMaxLength, zone()), 0);
+  Node* bound = Parameter(Type::Range(0, FixedArray::kMaxLength, zone()), 1);
+  Node* check = BuildLoopWithBoundsCheck(length, bound);
+
+  EliminateRedundantBoundsChecks();
+
+  EXPECT_EQ(IrOpcode::kCheckBounds, check->opcode());
+}
+
+TEST_F(LoopVariableOptimizerTest, BoundsCheckOnFractionalIndex) {
+  // for (let i = frac ? 0.5 : 0; i < length; i++) a[i];
+  Node* length = Parameter(Type::Range(0, FixedArray::kMaxLength, zone()), 0);
+  Type index_type =
+      Type::Union(Type::Constant(0.5, zone()),
+                  Type::Range(0, kMaxSafeInteger, zone()), zone());
+  Node* check = BuildLoopWithBoundsCheck(length, length, index_type);
+
+  EliminateRedundantBoundsChecks();
+
+  // The check must stay to deopt on the fractional index, which the guard's
+  // uses would truncate.
+  EXPECT_EQ(IrOpcode::kCheckBounds, check->opcode());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -493,5 +493,53 @@ TEST(UnicodeTest, IncrementalUTF8DecodingVsNonIncrementalUtf8Decoding) {
   }
 }
 
+TEST(UnicodeTest, NonAsciiStart) {
+  // Cover the scalar path, the vectorized block loops and the tail, with the
+  // first non-ASCII byte at every offset and with every misalignment.
+  static constexpr int kMaxLength = 4 * kNonAsciiStartVectorizedMinLength;
+  std::vector<uint8_t> buffer(kMaxLength + 16, 'a');
+  for (int misalignment = 0; misalignment < 16; misalignment++) {
+    uint8_t* chars = buffer.data() + misalignment;
+    for (int length = 0; length < kMaxLength; length++) {
+      CHECK_EQ(length, NonAsciiStart(chars, length));
+      for (int position = 0; position < length; position++) {
+        chars[position] = 0x80;
+        int result = NonAsciiStart(chars, length);
+        CHECK_LE(result, position);
+        for (int i = 0; i < result; i++) CHECK_LT(chars[i], 0x80);
+        if (length >= kNonAsciiStartVectorizedMinLength) {
+          CHECK_EQ(position, result);
+        }
+        chars[position] = 'a';
+      }
+    }
+  }
+}
+
+TEST(UnicodeTest, Utf8DecoderAsciiRuns) {
+  // Long ASCII runs between multi-byte characters go through the ASCII fast
+  // path of the decoder.
+  std::vector<byte> bytes;
+  std::vector<unibrow::uchar> expected;
+  for (int run = 0; run < 3 * kNonAsciiStartVectorizedMinLength; run += 7) {
+    for (int i = 0; i < run; i++) {
+      bytes.push_back('a' + i % 26);
+      expected.push_back('a' + i % 26);
+    }
+    // U+00E9, U+20AC, U+1F600, and a truncated sequence.
+    bytes.insert(bytes.end(), {0xC3, 0xA9, 0xE2, 0x82, 0xAC, 0xF0, 0x9F, 0x98,
+                               0x80, 0xE2, 0x82});
+    expected.insert(expected.end(), {0xE9, 0x20AC, 0x1F600, 0xFFFD});
+  }
+
+  std::vector<unibrow::uchar> output_incremental;
+  DecodeIncrementally(bytes, &output_incremental);
+  CHECK(output_incremental == expected);
+
+  std::vector<unibrow::uchar> output_utf16;
+  DecodeUtf16(bytes, &output_utf16);
+  CHECK(output_utf16 == expected);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,95 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/platform/elapsed-timer.h"
+#include "test/wasm-api-tests/wasm-api-test.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+namespace {
+
+// Number of tiny calls to measure in each direction. This is kept small so
+// that the tests stay fast; use --gtest_repeat for more stable numbers.
+constexpr int32_t kNumCalls = 1000;
+
+own<Trap> Increment(const Val args[], Val results[]) {
+  results[0] = Val::i32(args[0].i32() + 1);
+  return nullptr;
+}
+
+// Records the calls per second in the test results (e.g. the XML output of
+// --gtest_output), instead of printing them.
+void RecordCallsPerSecond(base::TimeDelta time) {
+  double seconds = time.InSecondsF();
+  if (seconds <= 0) return;
+  ::testing::Test::RecordProperty("calls_per_second",
+                                  static_cast<int>(kNumCalls / seconds));
+}
+
+}  // namespace
+
+TEST_F(WasmCapiTest, CallOverheadWasmToHost) {
+  // int32 run(int32 n) {
+  //   int32 i = 0;
+  //   do { i = increment(i); } while (i < n);
+  //   return i;
+  // }
+  uint32_t increment_index =
+      builder()->AddImport(CStrVector("increment"), wasm_i_i_sig());
+  byte code[] = {
+      WASM_LOOP(WASM_LOCAL_SET(1, WASM_CALL_FUNCTION(increment_index,
+                                                     WASM_LOCAL_GET(1))),
+                WASM_BR_IF(0, WASM_I32_LTS(WASM_LOCAL_GET(1),
+                                           WASM_LOCAL_GET(0)))),
+      WASM_LOCAL_GET(1)};
+  WasmFunctionBuilder* run = builder()->AddFunction(wasm_i_i_sig());
+  run->AddLocal(kWasmI32);
+  run->EmitCode(code, sizeof(code));
+  run->Emit(kExprEnd);
+  builder()->AddExport(CStrVector("run"), run);
+
+  own<Func> increment = Func::make(store(), cpp_i_i_sig(), Increment);
+  Extern* imports[] = {increment.get()};
+  Instantiate(imports);
+
+  Val args[] = {Val::i32(kNumCalls)};
+  Val results[1];
+  base::ElapsedTimer timer;
+  timer.Start();
+  own<Trap> trap = GetExportedFunction(0)->call(args, results);
+  base::TimeDelta time = timer.Elapsed();
+  EXPECT_EQ(nullptr, trap);
+  EXPECT_EQ(kNumCalls, results[0].i32());
+  RecordCallsPerSecond(time);
+}
+
+TEST_F(WasmCapiTest, CallOverheadHostToWasm) {
+  // int32 increment(int32 i) { return i + 1; }
+  byte code[] = {WASM_I32_ADD(WASM_LOCAL_GET(0), WASM_ONE)};
+  AddExportedFunction(CStrVector("increment"), code, sizeof(code),
+                      wasm_i_i_sig());
+  Instantiate(nullptr);
+  Func* increment = GetExportedFunction(0);
+
+  Val args[1];
+  Val results[1];
+  int32_t value = 0;
+  base::ElapsedTimer timer;
+  timer.Start();
+  for (int32_t i = 0; i < kNumCalls; ++i) {
+    args[0] = Val::i32(value);
+    own<Trap> trap = increment->call(args, results);
+    ASSERT_EQ(nullptr, trap);
+    value = results[0].i32();
+  }
+  base::TimeDelta time = timer.Elapsed();
+  EXPECT_EQ(kNumCalls, value);
+  RecordCallsPerSecond(time);
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
@@ -221,6 +221,37 @@ TEST_F(WasmCapiTest, DirectCallCapiFunction) {
   EXPECT_TRUE(func->same(results[4].ref()));
 }
 
+namespace {
+
+own<Trap> AddF64(const Val args[], Val results[]) {
+  results[0] = Val::f64(args[0].f64() + args[1].f64() + args[2].f64());
+  return nullptr;
+}
+
+}  // namespace
+
+TEST_F(WasmCapiTest, DirectCallTypedCapiFunction) {
+  // Parameters and result all have the same type, so the call goes through a
+  // signature-specialized trampoline.
+  own<FuncType> cpp_sig = FuncType::make(
+      ownvec<ValType>::make(ValType::make(::wasm::F64),
+                            ValType::make(::wasm::F64),
+                            ValType::make(::wasm::F64)),
+      ownvec<ValType>::make(ValType::make(::wasm::F64)));
+  own<Func> func = Func::make(store(), cpp_sig.get(), AddF64);
+  Extern* imports[] = {func.get()};
+  ValueType wasm_types[] = {kWasmF64, kWasmF64, kWasmF64, kWasmF64};
+  FunctionSig wasm_sig(1, 3, wasm_types);
+  int func_index = builder()->AddImport(CStrVector("func"), &wasm_sig);
+  builder()->ExportImportedFunction(CStrVector("func"), func_index);
+  Instantiate(imports);
+  Val args[] = {Val::f64(1.5), Val::f64(2.25), Val::f64(-0.5)};
+  Val results[1];
+  own<Trap> trap = func->call(args, results);
+  EXPECT_EQ(nullptr, trap);
+  EXPECT_EQ(3.25, results[0].f64());
+}
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8